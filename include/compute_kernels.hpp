@@ -0,0 +1,73 @@
+#ifndef COMPUTE_KERNELS_HPP
+#define COMPUTE_KERNELS_HPP
+
+#include <cstddef>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+/**
+ * @brief BLAS level-1 kernels shared by --kernel dot/saxpy, precision and
+ *        the CG mini-app (--kernel cg).
+ *
+ * Both take the OpenMP team size explicitly; callers without a --threads
+ * of their own pass default_team_size().
+ */
+
+/// Default OpenMP team size (OMP_NUM_THREADS; 1 without OpenMP).
+inline int default_team_size() {
+#if defined(_OPENMP)
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief Standard Dot Product kernel.
+ *
+ * Computes the dot product of two vectors: sum(x[i] * y[i]).
+ * This is a fundamental BLAS Level 1 operation, heavily reliant on memory
+ * bandwidth but also capable of utilizing SIMD instructions (AVX/AVX2) for
+ * the multiplication and reduction.
+ *
+ * @param x Pointer to the first vector.
+ * @param y Pointer to the second vector.
+ * @param n Number of elements in the vectors.
+ * @param threads OpenMP team size.
+ * @return The scalar dot product result.
+ */
+inline double compute_dot_kernel(const double* x, const double* y, std::size_t n, int threads) {
+    double sum = 0.0;
+    #pragma omp parallel for reduction(+:sum) num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Standard SAXPY (Single-precision A*X Plus Y) kernel.
+ *
+ * Computes `out[i] = a * x[i] + y[i]`.
+ * Another fundamental BLAS Level 1 operation. It reads two arrays and writes
+ * to a third, making it very similar to the STREAM Triad benchmark, but
+ * typically used in a compute context to measure vectorization efficiency.
+ *
+ * @param a The scalar multiplier.
+ * @param x Pointer to the first input vector.
+ * @param y Pointer to the second input vector.
+ * @param out Pointer to the output vector.
+ * @param n Number of elements to process.
+ * @param threads OpenMP team size.
+ */
+inline void compute_saxpy_kernel(double a, const double* x, const double* y, double* out, std::size_t n,
+                                 int threads) {
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        out[i] = a * x[i] + y[i];
+    }
+}
+
+#endif // COMPUTE_KERNELS_HPP
@@ -23,6 +23,15 @@ struct Config {
     int seed           = 14;              // RNG seed (useful when workload uses randomness) 14 because it is the day i was born
     bool prefault      = false;           // if true, touch pages after allocation to avoid first-touch page faults
     bool aligned       = false;           // if true, use 64B-aligned allocations where applicable
+    std::string file   = "bench_io.dat";  // scratch file for iops/zerocopy (created and removed if missing)
+    int qd             = 32;              // I/O queue depth: in-flight requests (uring) or worker threads
+    std::string io_engine = "auto";       // I/O submission engine: auto, uring, threads
+    std::string rw     = "read";          // I/O direction for the iops kernel: read or write
+    bool direct        = false;           // if true, the iops kernel opens --file with O_DIRECT
+    int inner          = 64;              // compute inner work: FMA steps per element (flops/fma), x16384 rounds per thread (peak)
+    std::string matrix = "synthetic";     // spmv input: synthetic, banded, random, powerlaw, or a Matrix Market path
+    int scale          = 0;               // bfs: log2(vertices) of the Kronecker graph (0 = largest that fits --size)
+    int edgefactor     = 16;              // bfs: generated edges per vertex (Graph500 default)
 
 
     
@@ -37,6 +46,25 @@ struct Config {
         std::cout << "Seed    : " << seed    << "\n";
         std::cout << "Prefault: " << (prefault ? "true" : "false") << "\n";
         std::cout << "Aligned : " << (aligned ? "true" : "false") << "\n";
+        if (kernel == "iops" || kernel == "zerocopy") {
+            std::cout << "File    : " << file      << "\n";
+        }
+        if (kernel == "iops") {
+            std::cout << "QD      : " << qd        << "\n";
+            std::cout << "Engine  : " << io_engine << "\n";
+            std::cout << "RW      : " << rw        << "\n";
+            std::cout << "Direct  : " << (direct ? "true" : "false") << "\n";
+        }
+        if (kernel == "flops" || kernel == "fma" || kernel == "peak" || kernel == "roofline") {
+            std::cout << "Inner   : " << inner     << "\n";
+        }
+        if (kernel == "spmv") {
+            std::cout << "Matrix  : " << matrix    << "\n";
+        }
+        if (kernel == "bfs") {
+            std::cout << "Scale   : " << scale      << "\n";
+            std::cout << "EdgeFac : " << edgefactor << "\n";
+        }
         std::cout << "-------------------------------\n";
     }
 };
@@ -50,7 +78,7 @@ inline void print_help(const char* prog) {
     std::cout
         << "Usage: " << prog << " [options]\n\n"
         << "Options:\n"
-        << " --kernel  <name>   (default: stream | allowed: copy, scale, add, triad, flops, fma, dot, saxpy, latency)\n"
+        << " --kernel  <name>   (default: stream | allowed: copy, scale, add, triad, flops, fma, dot, saxpy, latency, iops, zerocopy, ipc, syscall, branch, instr, peak, roofline, gemm, gemv, stencil, spmv, cg, transpose, scan, histogram, sort, hash, interleave, gups, bfs, search, precision)\n"
         << "  --size    <str>    (default: 64MB)\n"
         << "  --threads <int>    (default: 1)\n"
         << "  --iters   <int>    (default: 100)\n"
@@ -59,6 +87,15 @@ inline void print_help(const char* prog) {
         << "  --seed    <int>    (default: 14)\n"
         << "  --prefault         (default: false) pre-touch allocated pages to avoid page faults\n"
         << "  --aligned          (default: false) use 64B-aligned allocations (compute/latency)\n"
+        << "  --file    <path>   (default: bench_io.dat) scratch file for iops/zerocopy (tmpfs or local disk)\n"
+        << "  --qd      <int>    (default: 32) iops queue depth (in-flight I/Os or worker threads)\n"
+        << "  --io-engine <str>  (default: auto | allowed: auto, uring, threads)\n"
+        << "  --rw      <str>    (default: read | allowed: read, write)\n"
+        << "  --direct           (default: false) open the iops file with O_DIRECT (bypass page cache)\n"
+        << "  --inner   <int>    (default: 64) compute work per element (flops/fma) or x16384 FMA rounds per thread (peak)\n"
+        << "  --matrix  <str>    (default: synthetic | allowed: synthetic, banded, random, powerlaw, or a .mtx path) spmv input\n"
+        << "  --scale   <int>    (default: 0) bfs graph has 2^scale vertices (0 = largest that fits --size)\n"
+        << "  --edgefactor <int> (default: 16) bfs generated edges per vertex\n"
         << "  --help             show this message\n";
 }
 
@@ -111,8 +148,23 @@ inline Config parse_args(int argc, char** argv) {
                 need_value(i);
                 conf.out = args[++i];
             }
+            else if (args[i] == "--file") {
+                need_value(i);
+                conf.file = args[++i];
+            }
+            else if (args[i] == "--io-engine") {
+                need_value(i);
+                conf.io_engine = args[++i];
+            }
+            else if (args[i] == "--rw") {
+                need_value(i);
+                conf.rw = args[++i];
+            }
 
             // ---- Boolean flags (no value) ----
+            else if (args[i] == "--direct") {
+                conf.direct = true;
+            }
             else if (args[i] == "--prefault") {
                 conf.prefault = true;
             }
@@ -139,6 +191,26 @@ inline Config parse_args(int argc, char** argv) {
                 need_value(i);
                 conf.seed = std::stoi(args[++i]);
             }
+            else if (args[i] == "--qd") {
+                need_value(i);
+                conf.qd = std::stoi(args[++i]);
+            }
+            else if (args[i] == "--inner") {
+                need_value(i);
+                conf.inner = std::stoi(args[++i]);
+            }
+            else if (args[i] == "--matrix") {
+                need_value(i);
+                conf.matrix = args[++i];
+            }
+            else if (args[i] == "--scale") {
+                need_value(i);
+                conf.scale = std::stoi(args[++i]);
+            }
+            else if (args[i] == "--edgefactor") {
+                need_value(i);
+                conf.edgefactor = std::stoi(args[++i]);
+            }
 
             // ---- Unknown flag ----
             // Very important: we FAIL FAST on unknown flags.
@@ -172,6 +244,30 @@ inline Config parse_args(int argc, char** argv) {
         std::cerr << "Error: --warmup must be >= 0\n";
         std::exit(1);
     }
+    if (conf.qd < 1) {
+        std::cerr << "Error: --qd must be >= 1\n";
+        std::exit(1);
+    }
+    if (conf.inner < 1) {
+        std::cerr << "Error: --inner must be >= 1\n";
+        std::exit(1);
+    }
+    if (conf.scale < 0 || conf.scale > 30) {
+        std::cerr << "Error: --scale must be between 0 and 30\n";
+        std::exit(1);
+    }
+    if (conf.edgefactor < 1) {
+        std::cerr << "Error: --edgefactor must be >= 1\n";
+        std::exit(1);
+    }
+    if (conf.io_engine != "auto" && conf.io_engine != "uring" && conf.io_engine != "threads") {
+        std::cerr << "Error: --io-engine must be one of: auto, uring, threads\n";
+        std::exit(1);
+    }
+    if (conf.rw != "read" && conf.rw != "write") {
+        std::cerr << "Error: --rw must be one of: read, write\n";
+        std::exit(1);
+    }
     // Normalize kernel aliases (support both short and stream_* names)
     if (conf.kernel == "stream_copy")  conf.kernel = "copy";
     if (conf.kernel == "stream_scale") conf.kernel = "scale";
@@ -188,9 +284,32 @@ inline Config parse_args(int argc, char** argv) {
         conf.kernel != "dot"   &&
         conf.kernel != "saxpy" &&
         conf.kernel != "latency" &&
+        conf.kernel != "iops"  &&
+        conf.kernel != "zerocopy" &&
+        conf.kernel != "ipc"   &&
+        conf.kernel != "syscall" &&
+        conf.kernel != "branch" &&
+        conf.kernel != "instr" &&
+        conf.kernel != "peak"  &&
+        conf.kernel != "roofline" &&
+        conf.kernel != "gemm"  &&
+        conf.kernel != "gemv"  &&
+        conf.kernel != "stencil" &&
+        conf.kernel != "spmv"  &&
+        conf.kernel != "cg"    &&
+        conf.kernel != "transpose" &&
+        conf.kernel != "scan"  &&
+        conf.kernel != "histogram" &&
+        conf.kernel != "sort"  &&
+        conf.kernel != "hash"  &&
+        conf.kernel != "interleave" &&
+        conf.kernel != "gups"  &&
+        conf.kernel != "bfs"   &&
+        conf.kernel != "search" &&
+        conf.kernel != "precision" &&
         conf.kernel != "stream") {
         std::cerr << "Error: unsupported --kernel '" << conf.kernel << "'\n";
-        std::cerr << "Allowed kernels: copy, scale, add, triad, flops, fma, dot, saxpy, latency\n";
+        std::cerr << "Allowed kernels: copy, scale, add, triad, flops, fma, dot, saxpy, latency, iops, zerocopy, ipc, syscall, branch, instr, peak, roofline, gemm, gemv, stencil, spmv, cg, transpose, scan, histogram, sort, hash, interleave, gups, bfs, search, precision\n";
         std::exit(1);
     }
 
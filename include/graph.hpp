@@ -0,0 +1,45 @@
+#ifndef GRAPH_HPP
+#define GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * @brief Undirected graph in CSR form: both directions of every edge are
+ * stored, neighbour lists are sorted and free of duplicates and self loops.
+ *
+ * Vertex ids are 32-bit; row_ptr is 64-bit so 2 x edges may exceed 2^31.
+ */
+struct CsrGraph {
+    std::size_t vertices = 0;
+    std::vector<std::int64_t> row_ptr;  // vertices + 1 offsets into adj
+    std::vector<std::int32_t> adj;
+
+    std::size_t degree(std::size_t v) const { return static_cast<std::size_t>(row_ptr[v + 1] - row_ptr[v]); }
+    /// Undirected edges (each stored twice in adj).
+    std::size_t edges() const { return adj.size() / 2; }
+    std::size_t bytes() const { return row_ptr.size() * sizeof(std::int64_t) + adj.size() * sizeof(std::int32_t); }
+};
+
+/**
+ * @brief Graph500 Kronecker (R-MAT) graph for --kernel bfs.
+ *
+ * 2^scale vertices and edgefactor x 2^scale generated edges with the
+ * Graph500 initiator A = 0.57, B = C = 0.19, D = 0.05; vertex labels are
+ * then randomly permuted so degree does not correlate with id. Edges are
+ * drawn in fixed blocks of 4096, each from its own mt19937_64 seeded from
+ * `seed` and the block index, so the graph depends only on `seed`, not on
+ * the thread count. Self loops and duplicate edges are
+ * dropped when the CSR is built.
+ */
+CsrGraph generate_kronecker(int scale, int edgefactor, std::uint64_t seed);
+
+/// Generated (pre-deduplication) CSR bytes per vertex, used to size scale from --size.
+double kronecker_bytes_per_vertex(int edgefactor);
+
+} // namespace benchmark
+
+#endif // GRAPH_HPP
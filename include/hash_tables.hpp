@@ -0,0 +1,247 @@
+#ifndef HASH_TABLES_HPP
+#define HASH_TABLES_HPP
+
+#include "aligned_buffer.hpp"
+#include "utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace benchmark {
+
+/**
+ * @brief Open-addressing uint64 -> uint64 tables for --kernel hash and
+ * --kernel interleave.
+ *
+ * All three layouts use the same hash (murmur3 fmix64), power-of-two
+ * capacities and key 0 as the empty marker, so differences come from the
+ * probe sequence and memory layout alone. Keys are unique; insert() does
+ * not check for duplicates. prefetch() touches the first line a lookup of
+ * `key` will read, so callers can overlap independent lookups.
+ */
+
+/// murmur3 fmix64 finalizer: a bijection with full avalanche.
+inline std::uint64_t hash_u64(std::uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+/// splitmix64 output for counter x: a bijection, so distinct counters give distinct keys.
+inline std::uint64_t splitmix64(std::uint64_t x) {
+    std::uint64_t z = x + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+struct HashSlot {
+    std::uint64_t key;   // 0 = empty
+    std::uint64_t value;
+};
+
+/**
+ * @brief Linear probing over 16-byte slots: probe home, home + 1, .. until
+ * the key or an empty slot. Misses scan to the end of the cluster.
+ */
+class LinearProbeTable {
+public:
+    explicit LinearProbeTable(std::size_t capacity)
+        : slots_(capacity, 64), mask_(capacity - 1) {
+        std::memset(slots_.data(), 0, capacity * sizeof(HashSlot));
+    }
+
+    void insert(std::uint64_t key, std::uint64_t value) {
+        std::size_t i = hash_u64(key) & mask_;
+        while (slots_[i].key != 0) i = (i + 1) & mask_;
+        slots_[i] = {key, value};
+    }
+
+    bool find(std::uint64_t key, std::uint64_t& value) const {
+        for (std::size_t i = hash_u64(key) & mask_;; i = (i + 1) & mask_) {
+            const HashSlot& s = slots_[i];
+            if (s.key == key) {
+                value = s.value;
+                return true;
+            }
+            if (s.key == 0) return false;
+        }
+    }
+
+    void prefetch(std::uint64_t key) const { prefetch_read(&slots_[hash_u64(key) & mask_]); }
+
+    std::size_t capacity() const { return mask_ + 1; }
+    std::size_t bytes() const { return capacity() * sizeof(HashSlot); }
+
+private:
+    AlignedBuffer<HashSlot> slots_;
+    std::size_t mask_;
+};
+
+/**
+ * @brief Robin Hood linear probing: on insert, a key that has travelled
+ * further from home than the resident displaces it.
+ *
+ * Keeps probe lengths tight, and a lookup stops as soon as it has
+ * travelled further than the resident it is looking at, so misses stop
+ * early instead of scanning the whole cluster. Displacements live in a
+ * separate byte array (0 = empty, else displacement + 1), so the early
+ * exit never rehashes a resident key.
+ */
+class RobinHoodTable {
+public:
+    static constexpr std::size_t kMaxDisplacement = 254;
+
+    explicit RobinHoodTable(std::size_t capacity)
+        : meta_(capacity, 64), slots_(capacity, 64), mask_(capacity - 1) {
+        std::memset(meta_.data(), 0, capacity);
+    }
+
+    void insert(std::uint64_t key, std::uint64_t value) {
+        HashSlot cur{key, value};
+        std::size_t i = hash_u64(key) & mask_;
+        for (std::size_t dist = 0;; i = (i + 1) & mask_, ++dist) {
+            if (dist > kMaxDisplacement) throw std::runtime_error("RobinHoodTable: displacement overflow");
+            if (meta_[i] == 0) {
+                meta_[i] = static_cast<std::uint8_t>(dist + 1);
+                slots_[i] = cur;
+                return;
+            }
+            const std::size_t resident = meta_[i] - 1u;
+            if (resident < dist) {
+                std::swap(slots_[i], cur);
+                meta_[i] = static_cast<std::uint8_t>(dist + 1);
+                dist = resident;
+            }
+        }
+    }
+
+    bool find(std::uint64_t key, std::uint64_t& value) const {
+        std::size_t i = hash_u64(key) & mask_;
+        for (std::size_t dist = 0;; i = (i + 1) & mask_, ++dist) {
+            const std::size_t m = meta_[i];
+            if (m == 0 || m - 1 < dist) return false;
+            const HashSlot& s = slots_[i];
+            if (s.key == key) {
+                value = s.value;
+                return true;
+            }
+        }
+    }
+
+    void prefetch(std::uint64_t key) const {
+        const std::size_t i = hash_u64(key) & mask_;
+        prefetch_read(&meta_[i]);
+        prefetch_read(&slots_[i]);
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+    std::size_t bytes() const { return capacity() * (sizeof(HashSlot) + 1); }
+
+private:
+    AlignedBuffer<std::uint8_t> meta_;
+    AlignedBuffer<HashSlot> slots_;
+    std::size_t mask_;
+};
+
+/**
+ * @brief Swiss-table style SIMD groups: one control byte per slot (0x80
+ * empty, otherwise the low 7 hash bits), 16 slots per group.
+ *
+ * The hash bits above the tag pick the home group. A lookup compares all
+ * 16 control bytes with one SSE2 compare, checks only the matching slots'
+ * keys, and stops at the first group that still has an empty slot.
+ * Control bytes (16 B per group) and slots live in separate arrays, so a
+ * probe usually reads one control line and one slot line.
+ */
+class SwissTable {
+public:
+    static constexpr std::size_t kGroup = 16;
+    static constexpr std::uint8_t kEmpty = 0x80;
+
+    explicit SwissTable(std::size_t capacity)
+        : ctrl_(capacity, 64), slots_(capacity, 64), group_mask_(capacity / kGroup - 1) {
+        std::memset(ctrl_.data(), kEmpty, capacity);
+    }
+
+    void insert(std::uint64_t key, std::uint64_t value) {
+        const std::uint64_t h = hash_u64(key);
+        for (std::size_t g = group_of(h);; g = (g + 1) & group_mask_) {
+            const std::uint32_t empty = match(g, kEmpty);
+            if (empty) {
+                const std::size_t i = g * kGroup + ctz(empty);
+                ctrl_[i] = tag_of(h);
+                slots_[i] = {key, value};
+                return;
+            }
+        }
+    }
+
+    bool find(std::uint64_t key, std::uint64_t& value) const {
+        const std::uint64_t h = hash_u64(key);
+        const std::uint8_t tag = tag_of(h);
+        for (std::size_t g = group_of(h);; g = (g + 1) & group_mask_) {
+            for (std::uint32_t m = match(g, tag); m; m &= m - 1) {
+                const HashSlot& s = slots_[g * kGroup + ctz(m)];
+                if (s.key == key) {
+                    value = s.value;
+                    return true;
+                }
+            }
+            if (match(g, kEmpty)) return false;
+        }
+    }
+
+    void prefetch(std::uint64_t key) const {
+        const std::size_t g = group_of(hash_u64(key));
+        prefetch_read(&ctrl_[g * kGroup]);
+        prefetch_read(&slots_[g * kGroup]);
+    }
+
+    std::size_t capacity() const { return (group_mask_ + 1) * kGroup; }
+    std::size_t bytes() const { return capacity() * (sizeof(HashSlot) + 1); }
+
+private:
+    std::size_t group_of(std::uint64_t h) const { return (h >> 7) & group_mask_; }
+    static std::uint8_t tag_of(std::uint64_t h) { return static_cast<std::uint8_t>(h & 0x7f); }
+    static unsigned ctz(std::uint32_t m) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(m));
+#else
+        unsigned k = 0;
+        for (; !(m & 1u); m >>= 1) ++k;
+        return k;
+#endif
+    }
+
+    /// Bit k set when control byte k of group g equals `b`.
+    std::uint32_t match(std::size_t g, std::uint8_t b) const {
+        const std::uint8_t* c = &ctrl_[g * kGroup];
+#if defined(__SSE2__)
+        const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(c));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(b)))));
+#else
+        std::uint32_t m = 0;
+        for (std::size_t k = 0; k < kGroup; ++k) m |= static_cast<std::uint32_t>(c[k] == b) << k;
+        return m;
+#endif
+    }
+
+    AlignedBuffer<std::uint8_t> ctrl_;
+    AlignedBuffer<HashSlot> slots_;
+    std::size_t group_mask_;
+};
+
+} // namespace benchmark
+
+#endif // HASH_TABLES_HPP
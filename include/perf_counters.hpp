@@ -0,0 +1,136 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace benchmark {
+
+/**
+ * @brief Optional hardware performance counters (Linux perf_event_open).
+ *
+ * Design goals:
+ * - best effort: every event is opened on its own, so a missing event (VMs,
+ *   perf_event_paranoid, unsupported PMU) only disables that one counter
+ * - user-space only (exclude_kernel), which works at perf_event_paranoid <= 2
+ * - no dependency on libpfm/perf tooling; other platforms get a stub that
+ *   reports every counter as unavailable
+ *
+ * Values are scaled by time_enabled/time_running in case the kernel had to
+ * multiplex counters.
+ */
+class PerfCounters {
+public:
+    enum Event : int {
+        Cycles = 0,
+        Instructions,
+        Branches,
+        BranchMisses,
+        L1dReadMisses,
+        LlcMisses,
+        kNumEvents
+    };
+
+    PerfCounters() {
+        for (int e = 0; e < kNumEvents; ++e) fds_[e] = -1;
+#if defined(__linux__)
+        open_event(Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open_event(Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open_event(Branches, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+        open_event(BranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        open_event(L1dReadMisses, PERF_TYPE_HW_CACHE,
+                   PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        open_event(LlcMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int e = 0; e < kNumEvents; ++e) {
+            if (fds_[e] >= 0) ::close(fds_[e]);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(Event e) const { return fds_[e] >= 0; }
+
+    bool any_available() const {
+        for (int e = 0; e < kNumEvents; ++e) {
+            if (fds_[e] >= 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reset and enable all open counters.
+     */
+    void start() {
+#if defined(__linux__)
+        for (int e = 0; e < kNumEvents; ++e) {
+            if (fds_[e] < 0) continue;
+            ::ioctl(fds_[e], PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fds_[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Disable all counters and latch their (scaled) values.
+     */
+    void stop() {
+#if defined(__linux__)
+        for (int e = 0; e < kNumEvents; ++e) {
+            if (fds_[e] < 0) continue;
+            ::ioctl(fds_[e], PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t buf[3] = {0, 0, 0}; // value, time_enabled, time_running
+            if (::read(fds_[e], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf))) {
+                values_[e] = 0.0;
+                continue;
+            }
+            const double scale = (buf[2] > 0) ? static_cast<double>(buf[1]) / static_cast<double>(buf[2]) : 0.0;
+            values_[e] = static_cast<double>(buf[0]) * scale;
+        }
+#endif
+    }
+
+    /**
+     * @brief Counter value from the last start()/stop() window (0 if unavailable).
+     */
+    double value(Event e) const { return values_[e]; }
+
+private:
+#if defined(__linux__)
+    void open_event(Event e, std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        const long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        fds_[e] = (fd >= 0) ? static_cast<int>(fd) : -1;
+    }
+#endif
+
+    int fds_[kNumEvents];
+    double values_[kNumEvents] = {};
+};
+
+} // namespace benchmark
+
+#endif // PERF_COUNTERS_HPP
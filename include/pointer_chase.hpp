@@ -0,0 +1,78 @@
+#ifndef POINTER_CHASE_HPP
+#define POINTER_CHASE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * @brief A node in the linked list used for pointer chasing.
+ *
+ * The `alignas(64)` attribute ensures that each node occupies exactly one
+ * cache line (64 bytes on most modern architectures). This prevents
+ * "false sharing" and ensures that when we fetch a node, we are fetching
+ * exactly one cache line, making the latency measurement accurate.
+ *
+ * The `pad` array fills the rest of the 64 bytes after the 4-byte `next` index.
+ */
+struct alignas(64) ChaseNode {
+    std::uint32_t next;
+    std::uint32_t pad[15]; // 64B total (1 + 15)*4
+};
+
+/**
+ * @brief Build a randomized single-cycle linked list.
+ *
+ * This is the core setup for a pointer-chasing benchmark. It creates a linked
+ * list where every node is visited exactly once before returning to the start.
+ * The order of nodes is randomized to defeat hardware prefetchers. If the
+ * accesses were sequential, the CPU would prefetch the next cache line, hiding
+ * the true memory latency.
+ *
+ * @param nodes Pointer to the array of nodes.
+ * @param n Total number of nodes.
+ * @param seed Random seed for reproducibility.
+ */
+inline void build_random_cycle(ChaseNode* nodes, std::size_t n, std::uint32_t seed) {
+    // Build a single random cycle permutation: next[i] = perm[i+1], last points to first.
+    std::vector<std::uint32_t> idx(n);
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(n); ++i) idx[i] = i;
+
+    // Shuffle indices to create a random access pattern (defeats hardware prefetchers).
+    std::mt19937 rng(seed);
+    std::shuffle(idx.begin(), idx.end(), rng);
+
+    // Link each node to the next random node in the shuffled list.
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        nodes[idx[i]].next = idx[i + 1];
+    }
+    // Close the cycle by linking the last node back to the first.
+    nodes[idx[n - 1]].next = idx[0];
+
+    // Touch pads so the compiler can't assume they're unused and optimize them away.
+    nodes[idx[0]].pad[0] = 1;
+}
+
+/**
+ * @brief Serialized pointer chase: `steps` dependent loads from `start`.
+ *
+ * Each load's address comes from the previous load, so exactly one miss is
+ * in flight at a time and time / steps is the load-to-use latency.
+ *
+ * @return The node reached after `steps` hops.
+ */
+inline std::uint32_t chase_serial(const ChaseNode* nodes, std::uint32_t start, std::size_t steps) {
+    std::uint32_t cur = start;
+    for (std::size_t i = 0; i < steps; ++i) {
+        cur = nodes[cur].next;
+    }
+    return cur;
+}
+
+} // namespace benchmark
+
+#endif // POINTER_CHASE_HPP
@@ -3,18 +3,21 @@
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "config.hpp"
 #include "sys_info.hpp"   // <--- NEW
+#include "utils.hpp"
 
 using json = nlohmann::json;
 
@@ -67,11 +70,41 @@ struct BenchmarkResult {
         double bandwidth_gb_s = 0.0;  // effective GB/s (based on bytes touched)
                 double ns_per_access = 0.0;   // pointer-chasing latency (ns per dependent load), when applicable
         double checksum = 0.0;        // sampled checksum (DCE/correctness signal)
+        double ops_per_sec = 0.0;     // operation throughput (IOPS, lookups/s, ...), when applicable
+        std::map<std::string, double> extra; // kernel-specific metrics, written as extra row fields
         std::string kernel;           // kernel name for this point
     };
 
+    /**
+     * @brief Fill the timing fields of a Point from raw per-iteration samples.
+     *
+     * Shared by the runners so median/p95/min/max/stddev are computed the
+     * same way everywhere (median-based reporting, see README methodology).
+     */
+    static void fill_timing(Point& pt, std::vector<long long> samples) {
+        if (samples.empty()) return;
+        std::sort(samples.begin(), samples.end());
+
+        std::vector<double> samples_double;
+        samples_double.reserve(samples.size());
+        for (auto ns : samples) {
+            samples_double.push_back(static_cast<double>(ns));
+        }
+
+        pt.median_ns = percentile_ns(samples, 50.0);
+        pt.p95_ns = percentile_ns(samples, 95.0);
+        pt.min_ns = static_cast<double>(samples.front());
+        pt.max_ns = static_cast<double>(samples.back());
+        pt.stddev_ns = compute_stddev(samples_double);
+    }
+
     std::vector<Point> sweep_points;
 
+    // ---------- Runner-specific sections ----------
+    // Each key is written as stats.<key> (e.g. a derived summary/table that
+    // does not fit the one-row-per-point sweep shape).
+    json extra_stats = json::object();
+
     // ---------- JSON writer ----------
     void save(const Config& conf) const {
         json j;
@@ -104,6 +137,21 @@ struct BenchmarkResult {
         j["metadata"]["platform"]["logical_cores"] = sys.logical_cores;
         j["metadata"]["platform"]["ram_total_gib"] = sys.ram_total_gib;
 
+        j["metadata"]["platform"]["physical_cores"] = sys.physical_cores;
+        j["metadata"]["platform"]["sockets"] = sys.sockets;
+        j["metadata"]["platform"]["simd_isa"] = sys.simd_isa;
+        j["metadata"]["platform"]["simd_width_bits"] = sys.simd_width_bits;
+        j["metadata"]["platform"]["has_fma"] = sys.has_fma;
+        j["metadata"]["platform"]["fma_units_per_core"] = sys.fma_units_per_core;
+        j["metadata"]["platform"]["measured_core_ghz"] = sys.measured_core_ghz;
+        j["metadata"]["platform"]["peak_gflops_fp64_per_core"] = sys.peak_gflops_fp64_per_core;
+        j["metadata"]["platform"]["peak_gflops_fp64_per_socket"] = sys.peak_gflops_fp64_per_socket;
+        if (!sys.cpu_vendor.empty()) {
+            j["metadata"]["platform"]["cpu_vendor"] = sys.cpu_vendor;
+            j["metadata"]["platform"]["cpu_family"] = sys.cpu_family;
+            j["metadata"]["platform"]["cpu_model_id"] = sys.cpu_model_id;
+        }
+
         if (sys.cache_l1_bytes > 0) j["metadata"]["platform"]["cache_l1_bytes"] = sys.cache_l1_bytes;
         if (sys.cache_l2_bytes > 0) j["metadata"]["platform"]["cache_l2_bytes"] = sys.cache_l2_bytes;
         if (sys.cache_llc_bytes > 0) j["metadata"]["platform"]["cache_llc_bytes"] = sys.cache_llc_bytes;
@@ -115,6 +163,10 @@ struct BenchmarkResult {
         j["metadata"]["platform"]["os_kernel"]        = sys.os_kernel;
         j["metadata"]["platform"]["compiler_full"]    = sys.compiler_info;
 
+        for (const auto& kv : sys.cpu_vulnerabilities) {
+            j["metadata"]["platform"]["cpu_vulnerabilities"][kv.first] = kv.second;
+        }
+
 #ifdef _MSC_VER
         j["metadata"]["platform"]["cpp_standard"] = _MSVC_LANG;
 #else
@@ -131,6 +183,25 @@ struct BenchmarkResult {
         j["config"]["out"]     = conf.out;
         j["config"]["prefault"] = conf.prefault;
         j["config"]["aligned"]  = conf.aligned;
+        if (conf.kernel == "iops" || conf.kernel == "zerocopy") {
+            j["config"]["file"]      = conf.file;
+        }
+        if (conf.kernel == "iops") {
+            j["config"]["qd"]        = conf.qd;
+            j["config"]["io_engine"] = conf.io_engine;
+            j["config"]["rw"]        = conf.rw;
+            j["config"]["direct"]    = conf.direct;
+        }
+        if (conf.kernel == "flops" || conf.kernel == "fma" || conf.kernel == "peak" || conf.kernel == "roofline") {
+            j["config"]["inner"]     = conf.inner;
+        }
+        if (conf.kernel == "spmv") {
+            j["config"]["matrix"]    = conf.matrix;
+        }
+        if (conf.kernel == "bfs") {
+            j["config"]["scale"]      = conf.scale;
+            j["config"]["edgefactor"] = conf.edgefactor;
+        }
 
         // ---------- Aggregate stats (if you use them) ----------
         j["stats"]["performance"]["total_time_ns"]  = total_ns;
@@ -156,11 +227,21 @@ struct BenchmarkResult {
                                 if (pt.ns_per_access > 0.0) {
                                         row["ns_per_access"] = pt.ns_per_access;
                                 }
+                                if (pt.ops_per_sec > 0.0) {
+                                        row["ops_per_sec"] = pt.ops_per_sec;
+                                }
+                                for (const auto& kv : pt.extra) {
+                                        row[kv.first] = kv.second;
+                                }
 
                                 j["stats"]["sweep"].push_back(std::move(row));
             }
         }
 
+        for (auto it = extra_stats.begin(); it != extra_stats.end(); ++it) {
+            j["stats"][it.key()] = it.value();
+        }
+
         // ---------- Write file ----------
                 {
                         std::error_code ec;
@@ -0,0 +1,61 @@
+#ifndef SCRATCH_FILE_HPP
+#define SCRATCH_FILE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Create (or extend) a scratch file so every offset is backed by data.
+ *
+ * Reads from a sparse hole are served without touching the page cache or the
+ * device, so the file is filled with a byte pattern up to `file_bytes`.
+ * Existing files that are already large enough are reused as-is.
+ *
+ * @param path File to open/create.
+ * @param file_bytes Minimum size the file must have.
+ * @param created Set to true if the file did not exist before (the caller
+ *                should remove it again when done).
+ * @param flags Extra open(2) flags (e.g. O_DIRECT); O_RDWR|O_CREAT is implied.
+ * @return Open file descriptor, or -1 on failure (errno is preserved).
+ */
+inline int prepare_scratch_file(const std::string& path, std::uint64_t file_bytes, bool& created, int flags = 0) {
+    struct stat st {};
+    created = (::stat(path.c_str(), &st) != 0);
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | flags, 0644);
+    if (fd < 0) return -1;
+
+    std::uint64_t have = created ? 0 : static_cast<std::uint64_t>(st.st_size);
+    if (have >= file_bytes) return fd;
+
+    const std::size_t chunk = 1024 * 1024;
+    std::vector<unsigned char> pattern(chunk);
+    for (std::size_t i = 0; i < chunk; ++i) pattern[i] = static_cast<unsigned char>(i * 131u + 7u);
+
+    while (have < file_bytes) {
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(chunk, file_bytes - have));
+        const ssize_t w = ::pwrite(fd, pattern.data(), len, static_cast<off_t>(have));
+        if (w <= 0) {
+            if (w < 0 && errno == EINTR) continue;
+            const int saved = errno;
+            ::close(fd);
+            errno = saved;
+            return -1;
+        }
+        have += static_cast<std::uint64_t>(w);
+    }
+    return fd;
+}
+
+#endif // __linux__
+
+#endif // SCRATCH_FILE_HPP
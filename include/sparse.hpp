@@ -0,0 +1,73 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * @brief Compressed Sparse Row matrix (fp64 values, 32-bit column indices).
+ *
+ * Columns are sorted within each row. row_ptr is 64-bit so nnz may exceed
+ * 2^31; column indices stay 32-bit to keep the index stream at 4 B/nnz.
+ */
+struct CsrMatrix {
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::vector<std::int64_t> row_ptr;   // rows + 1 offsets into col/val
+    std::vector<std::int32_t> col;
+    std::vector<double>       val;
+
+    std::size_t nnz() const { return val.size(); }
+};
+
+/**
+ * @brief Synthetic sparsity patterns for --kernel spmv.
+ *
+ * - Banded  : 27 diagonals (offsets -13..13), diagonal 27 / off-diagonal -1,
+ *             symmetric and strictly diagonally dominant (SPD)
+ * - Random  : 16 uniformly random columns per row
+ * - PowerLaw: row lengths from a Pareto(1.5) law with mean ~16 (a few very
+ *             long rows), uniformly random columns
+ */
+enum class SparsePattern { Banded, Random, PowerLaw };
+
+const char* sparse_pattern_name(SparsePattern p);
+
+/// Mean stored entries per row of a synthetic pattern (used to size from --size).
+double sparse_pattern_mean_row(SparsePattern p);
+
+/// Square `rows` x `rows` matrix with the given pattern, reproducible for `seed`.
+CsrMatrix generate_sparse(SparsePattern p, std::size_t rows, std::uint64_t seed);
+
+/**
+ * @brief HPCG problem matrix: 27-point stencil on an nx x ny x nz grid
+ *        (x fastest), diagonal 26 and -1 for every neighbour that exists.
+ *
+ * Symmetric positive definite; boundary rows have fewer entries.
+ */
+CsrMatrix generate_stencil27(std::size_t nx, std::size_t ny, std::size_t nz);
+
+/**
+ * @brief Load a Matrix Market coordinate file (real / integer / pattern,
+ *        general or symmetric; symmetric files are expanded, duplicate
+ *        entries summed).
+ *
+ * @throws std::runtime_error on unsupported headers or malformed entries.
+ */
+CsrMatrix load_matrix_market(const std::string& path);
+
+/**
+ * @brief y = A x with rows split evenly (by count) across `threads`.
+ *
+ * If `thread_ns` is non-null it receives each thread's busy time (it must
+ * hold `threads` entries), which exposes load imbalance from uneven rows.
+ */
+void spmv_csr(const CsrMatrix& a, const double* x, double* y, int threads, double* thread_ns = nullptr);
+
+} // namespace benchmark
+
+#endif // SPARSE_HPP
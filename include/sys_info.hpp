@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace benchmark {
 
@@ -18,6 +20,23 @@ struct SystemInfo {
     std::string cpu_model;             // human-readable CPU model
     uint32_t    logical_cores = 0;     // hw threads (safe fallback)
 
+    // ---------- Compute peak (estimated) ----------
+    // SIMD width and FMA from CPUID (x86), FMA pipes per core from per-family
+    // heuristics, clock from a timed dependent add chain (1 add per cycle).
+    // The clock is the single-thread sustained one; all-core turbo is lower.
+    std::string cpu_vendor;            // CPUID vendor string (x86), empty elsewhere
+    uint32_t    cpu_family = 0;        // x86 display family (e.g. 0x19 = Zen 3/4)
+    uint32_t    cpu_model_id = 0;      // x86 display model
+    uint32_t    physical_cores = 0;    // distinct (package, core) pairs, else logical_cores
+    uint32_t    sockets = 0;           // distinct packages, else 1
+    std::string simd_isa;              // widest usable: avx512, avx2, avx, sse2, neon, scalar
+    uint32_t    simd_width_bits = 0;   // register width of simd_isa
+    bool        has_fma = false;       // fused multiply-add available
+    uint32_t    fma_units_per_core = 0; // simd_width FMAs (or mul+add pairs) issued per cycle
+    double      measured_core_ghz = 0.0;
+    double      peak_gflops_fp64_per_core = 0.0;
+    double      peak_gflops_fp64_per_socket = 0.0;
+
     // ---------- RAM ----------
     uint64_t    ram_total_gib = 0;     // numeric (rounded GiB) -> scripts/plots
     std::string ram_total_pretty;      // "16 GiB" -> README/UI
@@ -31,6 +50,11 @@ struct SystemInfo {
     std::string os_distro;             // Linux: PRETTY_NAME from /etc/os-release
     std::string os_kernel;             // POSIX: uname (sysname + release)
 
+    // ---------- Kernel mitigations ----------
+    // Linux: /sys/devices/system/cpu/vulnerabilities/* (name -> status line).
+    // Syscall/context-switch costs depend heavily on these (KPTI, retpoline, IBRS).
+    std::vector<std::pair<std::string, std::string>> cpu_vulnerabilities;
+
     // ---------- Compiler ----------
     std::string compiler_info;         // compile-time compiler string
 };
@@ -38,6 +62,11 @@ struct SystemInfo {
 // Get all system specs (runtime + compile-time)
 SystemInfo collect_system_info();
 
+// Sustained single-thread core clock in GHz from a dependent add chain
+// (~50 ms, first call only; the value is cached for the process).
+// 0 when the compiler cannot pin the chain (no GNU inline asm).
+double measure_core_ghz();
+
 // Helper: compiler info at compile-time (zero runtime cost)
 inline std::string get_compiler_info() {
 #if defined(__clang__)
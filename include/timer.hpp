@@ -43,6 +43,14 @@ public:
     static double ns_per_op(long long total_ns, std::size_t iterations) {
         return iterations ? (static_cast<double>(total_ns) / iterations) : 0.0;
     }
+
+    /**
+     * @brief Raw monotonic timestamp in nanoseconds (same clock as start/elapsed).
+     * Useful when many overlapping intervals are in flight (e.g. per-I/O latency).
+     */
+    static long long now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count();
+    }
 };
 
 #endif
\ No newline at end of file
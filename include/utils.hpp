@@ -7,6 +7,10 @@
 #include <algorithm>
 #include <atomic> // for std::atomic_signal_fence
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 /**
  * @brief Prevent the compiler from optimizing away a value.
  *
@@ -56,6 +60,70 @@ inline void clobber_memory() {
 #endif
 }
 
+/**
+ * @brief Software prefetch of the cache line holding `p` for reading.
+ *
+ * A hint only: it never faults, and is a no-op on compilers without
+ * __builtin_prefetch. Used by the random-access runners to overlap
+ * independent misses.
+ */
+inline void prefetch_read(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#else
+    (void)p;
+#endif
+}
+
+/// As prefetch_read, but requests the line for writing (prefetchw where available).
+inline void prefetch_write(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 1, 3);
+#else
+    (void)p;
+#endif
+}
+
+/**
+ * @brief Set the default OpenMP team size for one scope, restoring it on exit.
+ *
+ * For calls into code that uses the default team size (e.g. the STREAM
+ * sweep a runner times as its bandwidth reference), so `--threads` never
+ * changes the process-wide setting. Without OpenMP it does nothing.
+ */
+class ScopedOmpThreads {
+public:
+    explicit ScopedOmpThreads(int threads) {
+#if defined(_OPENMP)
+        prev_ = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+    }
+    ~ScopedOmpThreads() {
+#if defined(_OPENMP)
+        omp_set_num_threads(prev_);
+#endif
+    }
+    ScopedOmpThreads(const ScopedOmpThreads&) = delete;
+    ScopedOmpThreads& operator=(const ScopedOmpThreads&) = delete;
+
+private:
+    int prev_ = 1;
+};
+
+/// Calling thread's id and team size inside a parallel region (0 / 1 without OpenMP).
+inline void team_position(std::size_t& tid, std::size_t& nt) {
+#if defined(_OPENMP)
+    tid = static_cast<std::size_t>(omp_get_thread_num());
+    nt = static_cast<std::size_t>(omp_get_num_threads());
+#else
+    tid = 0;
+    nt = 1;
+#endif
+}
+
 /**
  * @brief Compute standard deviation for a vector of samples.
  *
@@ -0,0 +1,58 @@
+#ifndef ZIPF_HPP
+#define ZIPF_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace benchmark {
+
+/**
+ * @brief Zipf(theta) ranks in [0, n), rank 0 the most frequent.
+ *
+ * P(rank k) is proportional to 1 / (k + 1)^theta. Uses the constant-time
+ * approximation of Gray et al. ("Quickly Generating Billion-Record
+ * Synthetic Databases", also YCSB's generator) after an O(n) zeta sum at
+ * construction. Valid for 0 < theta < 1; YCSB's default skew is 0.99.
+ *
+ * Ranks are returned unscrambled: callers that do not want the hot keys
+ * adjacent should map ranks through a bijection of their own.
+ */
+class ZipfDistribution {
+public:
+    ZipfDistribution(std::uint64_t n, double theta) : n_(n), theta_(theta) {
+        double zetan = 0.0;
+        for (std::uint64_t i = 1; i <= n; ++i) zetan += 1.0 / std::pow(static_cast<double>(i), theta);
+        zetan_ = zetan;
+        zeta2_ = 1.0 + std::pow(0.5, theta);
+        alpha_ = 1.0 / (1.0 - theta);
+        eta_ = (1.0 - std::pow(2.0 / static_cast<double>(n), 1.0 - theta)) / (1.0 - zeta2_ / zetan);
+    }
+
+    template <class URBG>
+    std::uint64_t operator()(URBG& rng) {
+        const double u = uniform_(rng);
+        const double uz = u * zetan_;
+        if (uz < 1.0) return 0;
+        if (uz < zeta2_) return n_ > 1 ? 1 : 0;
+        const double r = static_cast<double>(n_) * std::pow(eta_ * u - eta_ + 1.0, alpha_);
+        const std::uint64_t k = static_cast<std::uint64_t>(r);
+        return k < n_ ? k : n_ - 1;
+    }
+
+    std::uint64_t n() const { return n_; }
+    double theta() const { return theta_; }
+
+private:
+    std::uint64_t n_;
+    double theta_;
+    double zetan_ = 0.0;
+    double zeta2_ = 0.0; // 1 + 0.5^theta: upper bound of u * zeta(n) for rank 1
+    double alpha_ = 0.0;
+    double eta_ = 0.0;
+    std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+};
+
+} // namespace benchmark
+
+#endif // ZIPF_HPP
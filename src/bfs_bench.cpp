@@ -0,0 +1,428 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using benchmark::CsrGraph;
+using Vertex = std::int32_t;
+
+constexpr Vertex kUnvisited = -1;
+constexpr double kAlpha = 15.0; // top-down -> bottom-up when frontier edges > unexplored edges / alpha
+constexpr double kBeta = 18.0;  // bottom-up -> top-down when a shrinking frontier < vertices / beta
+constexpr std::size_t kRoots = 16;
+
+enum class Direction { TopDown, BottomUp, Optimizing };
+
+const char* direction_name(Direction d) {
+    switch (d) {
+        case Direction::TopDown:    return "top_down";
+        case Direction::BottomUp:   return "bottom_up";
+        case Direction::Optimizing: return "direction_opt";
+    }
+    return "unknown";
+}
+
+/// Per-level record of one search.
+struct Level {
+    bool bottom_up = false;
+    std::size_t frontier = 0; // vertices in the frontier the level expands
+    double ns = 0.0;
+};
+
+/**
+ * @brief Search state reused across roots: parent array plus both
+ * frontier representations (a vertex queue for top-down, a bitmap for
+ * bottom-up).
+ */
+struct BfsState {
+    explicit BfsState(std::size_t n) : parent(n), front_bits((n + 63) / 64), next_bits((n + 63) / 64) {}
+
+    std::vector<std::atomic<Vertex>> parent;
+    std::vector<Vertex> queue, next;
+    std::vector<std::uint64_t> front_bits, next_bits;
+    std::vector<Level> levels;
+};
+
+/**
+ * @brief Top-down step: every frontier vertex claims its unvisited
+ * neighbours with a CAS on parent. Returns the degree sum of the new
+ * frontier (edges the next step would examine).
+ */
+std::int64_t top_down_step(const CsrGraph& g, BfsState& s, int threads) {
+    s.next.clear();
+    std::int64_t next_edges = 0;
+    #pragma omp parallel num_threads(threads) reduction(+ : next_edges)
+    {
+        std::vector<Vertex> local;
+        #pragma omp for schedule(dynamic, 64) nowait
+        for (long long i = 0; i < static_cast<long long>(s.queue.size()); ++i) {
+            const Vertex u = s.queue[i];
+            for (std::int64_t e = g.row_ptr[u]; e < g.row_ptr[u + 1]; ++e) {
+                const Vertex v = g.adj[e];
+                Vertex expected = kUnvisited;
+                if (s.parent[v].load(std::memory_order_relaxed) == kUnvisited &&
+                    s.parent[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+                    local.push_back(v);
+                    next_edges += g.row_ptr[v + 1] - g.row_ptr[v];
+                }
+            }
+        }
+        #pragma omp critical
+        s.next.insert(s.next.end(), local.begin(), local.end());
+    }
+    std::swap(s.queue, s.next);
+    return next_edges;
+}
+
+/**
+ * @brief Bottom-up step: every unvisited vertex scans its neighbours for
+ * one in the frontier bitmap and stops at the first. Each thread owns
+ * whole 64-vertex bitmap words, so no atomics are needed. Returns the
+ * new frontier size; `next_edges` gets its degree sum.
+ */
+std::size_t bottom_up_step(const CsrGraph& g, BfsState& s, int threads, std::int64_t& next_edges) {
+    const long long words = static_cast<long long>(s.front_bits.size());
+    const Vertex n = static_cast<Vertex>(g.vertices);
+    std::size_t awake = 0;
+    std::int64_t edges = 0;
+    #pragma omp parallel for num_threads(threads) schedule(dynamic, 16) reduction(+ : awake, edges)
+    for (long long w = 0; w < words; ++w) {
+        std::uint64_t bits = 0;
+        const Vertex base = static_cast<Vertex>(w * 64);
+        for (Vertex v = base; v < std::min<Vertex>(base + 64, n); ++v) {
+            if (s.parent[v].load(std::memory_order_relaxed) != kUnvisited) continue;
+            for (std::int64_t e = g.row_ptr[v]; e < g.row_ptr[v + 1]; ++e) {
+                const Vertex u = g.adj[e];
+                if ((s.front_bits[u >> 6] >> (u & 63)) & 1u) {
+                    s.parent[v].store(u, std::memory_order_relaxed);
+                    bits |= std::uint64_t(1) << (v - base);
+                    ++awake;
+                    edges += g.row_ptr[v + 1] - g.row_ptr[v];
+                    break;
+                }
+            }
+        }
+        s.next_bits[w] = bits;
+    }
+    std::swap(s.front_bits, s.next_bits);
+    next_edges = edges;
+    return awake;
+}
+
+void queue_to_bitmap(BfsState& s, int threads) {
+    std::fill(s.front_bits.begin(), s.front_bits.end(), 0);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(s.queue.size()); ++i) {
+        const Vertex v = s.queue[i];
+        #pragma omp atomic
+        s.front_bits[v >> 6] |= std::uint64_t(1) << (v & 63);
+    }
+}
+
+/// Index of the lowest set bit (`m` must be non-zero).
+inline unsigned ctz64(std::uint64_t m) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(m));
+#else
+    unsigned k = 0;
+    for (; !(m & 1u); m >>= 1) ++k;
+    return k;
+#endif
+}
+
+void bitmap_to_queue(BfsState& s, int threads) {
+    s.queue.clear();
+    #pragma omp parallel num_threads(threads)
+    {
+        std::vector<Vertex> local;
+        #pragma omp for schedule(static) nowait
+        for (long long w = 0; w < static_cast<long long>(s.front_bits.size()); ++w) {
+            for (std::uint64_t bits = s.front_bits[w]; bits; bits &= bits - 1) {
+                local.push_back(static_cast<Vertex>(w * 64 + ctz64(bits)));
+            }
+        }
+        #pragma omp critical
+        s.queue.insert(s.queue.end(), local.begin(), local.end());
+    }
+}
+
+/**
+ * @brief One BFS from `root`, filling s.parent and s.levels.
+ *
+ * Direction-optimizing follows Beamer et al.: start top-down, switch to
+ * bottom-up once the frontier's edges exceed the unexplored edges /
+ * alpha, and back to top-down once the frontier shrinks below
+ * vertices / beta.
+ */
+void bfs(const CsrGraph& g, Vertex root, Direction dir, int threads, BfsState& s) {
+    const long long n = static_cast<long long>(g.vertices);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long v = 0; v < n; ++v) s.parent[v].store(kUnvisited, std::memory_order_relaxed);
+    s.parent[root].store(root, std::memory_order_relaxed);
+    s.levels.clear();
+
+    s.queue.assign(1, root);
+    bool bottom_up = dir == Direction::BottomUp;
+    if (bottom_up) queue_to_bitmap(s, threads);
+    std::size_t frontier = 1;
+    std::int64_t frontier_edges = g.row_ptr[root + 1] - g.row_ptr[root];
+    std::int64_t unexplored = static_cast<std::int64_t>(g.adj.size()) - frontier_edges;
+
+    while (frontier > 0) {
+        if (dir == Direction::Optimizing) {
+            if (!bottom_up && static_cast<double>(frontier_edges) > static_cast<double>(unexplored) / kAlpha) {
+                queue_to_bitmap(s, threads);
+                bottom_up = true;
+            }
+        }
+
+        Level lv;
+        lv.bottom_up = bottom_up;
+        lv.frontier = frontier;
+        Timer t;
+        t.start();
+        std::size_t next_frontier;
+        std::int64_t next_edges;
+        if (bottom_up) {
+            next_frontier = bottom_up_step(g, s, threads, next_edges);
+        } else {
+            next_edges = top_down_step(g, s, threads);
+            next_frontier = s.queue.size();
+        }
+        lv.ns = static_cast<double>(t.elapsed_ns());
+        s.levels.push_back(lv);
+
+        if (dir == Direction::Optimizing && bottom_up && next_frontier < frontier &&
+            static_cast<double>(next_frontier) < static_cast<double>(g.vertices) / kBeta) {
+            bitmap_to_queue(s, threads);
+            bottom_up = false;
+        }
+        frontier = next_frontier;
+        frontier_edges = next_edges;
+        // As in GAP, only top-down steps consume the unexplored-edge budget,
+        // so a search that has left bottom-up does not flip straight back.
+        if (!lv.bottom_up) unexplored -= next_edges;
+    }
+}
+
+/// Serial reference BFS depths (-1 unreachable).
+std::vector<Vertex> reference_depths(const CsrGraph& g, Vertex root) {
+    std::vector<Vertex> depth(g.vertices, kUnvisited);
+    std::vector<Vertex> queue;
+    queue.reserve(g.vertices);
+    depth[root] = 0;
+    queue.push_back(root);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const Vertex u = queue[head];
+        for (std::int64_t e = g.row_ptr[u]; e < g.row_ptr[u + 1]; ++e) {
+            const Vertex v = g.adj[e];
+            if (depth[v] == kUnvisited) {
+                depth[v] = depth[u] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    return depth;
+}
+
+/**
+ * @brief Graph500-style tree check against reference depths: the same
+ * vertices are reached, the root is its own parent, and every other
+ * parent is a real neighbour exactly one level closer to the root.
+ */
+bool validate_tree(const CsrGraph& g, Vertex root, const BfsState& s, const std::vector<Vertex>& depth) {
+    bool ok = s.parent[root].load(std::memory_order_relaxed) == root;
+    const long long n = static_cast<long long>(g.vertices);
+    #pragma omp parallel for schedule(static) reduction(&& : ok)
+    for (long long v = 0; v < n; ++v) {
+        const Vertex p = s.parent[v].load(std::memory_order_relaxed);
+        if ((p == kUnvisited) != (depth[v] == kUnvisited)) {
+            ok = false;
+        } else if (p != kUnvisited && v != root) {
+            const auto first = g.adj.begin() + g.row_ptr[p], last = g.adj.begin() + g.row_ptr[p + 1];
+            ok = ok && depth[p] == depth[v] - 1 && std::binary_search(first, last, static_cast<Vertex>(v));
+        }
+    }
+    return ok;
+}
+
+/// Search keys: distinct random vertices with at least one edge.
+std::vector<Vertex> pick_roots(const CsrGraph& g, std::uint64_t seed) {
+    std::mt19937_64 rng(seed + 1);
+    std::uniform_int_distribution<std::size_t> any(0, g.vertices - 1);
+    std::vector<Vertex> roots;
+    for (std::size_t tries = 0; roots.size() < kRoots && tries < 64 * kRoots; ++tries) {
+        const Vertex v = static_cast<Vertex>(any(rng));
+        if (g.degree(v) > 0 && std::find(roots.begin(), roots.end(), v) == roots.end()) roots.push_back(v);
+    }
+    return roots;
+}
+
+} // namespace
+
+/**
+ * @brief Graph500-style BFS runner for --kernel bfs.
+ *
+ * Builds a Kronecker graph (include/graph.hpp) with 2^--scale vertices
+ * and --edgefactor edges per vertex from --seed; --scale 0 picks the
+ * largest scale whose CSR fits --size. Searches from up to 16 random
+ * non-isolated roots (timed iteration i uses root i mod 16) with
+ * top-down, bottom-up and direction-optimizing BFS on 1, 2, 4 ..
+ * --threads threads.
+ *
+ * TEPS counts the undirected input edges in the searched component, as
+ * in Graph500; ops_per_sec is the harmonic mean over the timed searches.
+ * Every variant is first checked against a serial BFS on every root
+ * (reached set) and with the full tree check on the first root, whose
+ * per-level direction, frontier size and time are kept in stats.bfs.
+ *
+ * @param conf The parsed configuration (size, scale, edgefactor, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_bfs_bench(const Config& conf, BenchmarkResult& res) {
+    int scale = conf.scale;
+    if (scale == 0) {
+        std::uint64_t size_bytes = 0;
+        try {
+            size_bytes = parse_size_bytes(conf.size);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+            return;
+        }
+        const double per_vertex = benchmark::kronecker_bytes_per_vertex(conf.edgefactor);
+        scale = 10;
+        while (scale < 30 && static_cast<double>(std::uint64_t(1) << (scale + 1)) * per_vertex <= size_bytes) ++scale;
+    }
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    Timer build_timer;
+    build_timer.start();
+    const CsrGraph g = benchmark::generate_kronecker(scale, conf.edgefactor, static_cast<std::uint64_t>(conf.seed));
+    const double build_s = static_cast<double>(build_timer.elapsed_ns()) * 1e-9;
+    std::cout << "[BFS] scale=" << scale << " edgefactor=" << conf.edgefactor << " vertices=" << g.vertices
+              << " edges=" << g.edges() << " bytes=" << g.bytes() << " build_s=" << build_s << "\n";
+
+    const std::vector<Vertex> roots = pick_roots(g, static_cast<std::uint64_t>(conf.seed));
+    if (roots.empty()) {
+        std::cerr << "Error: bfs graph has no edges\n";
+        return;
+    }
+
+    // Reference reach and component edges per root; full depths for the first.
+    std::vector<std::size_t> reached(roots.size());
+    std::vector<double> comp_edges(roots.size());
+    std::vector<Vertex> depth0;
+    for (std::size_t r = 0; r < roots.size(); ++r) {
+        std::vector<Vertex> depth = reference_depths(g, roots[r]);
+        std::size_t cnt = 0;
+        double deg = 0.0;
+        for (std::size_t v = 0; v < g.vertices; ++v) {
+            if (depth[v] == kUnvisited) continue;
+            ++cnt;
+            deg += static_cast<double>(g.degree(v));
+        }
+        reached[r] = cnt;
+        comp_edges[r] = deg / 2.0;
+        if (r == 0) depth0 = std::move(depth);
+    }
+
+    json& table = res.extra_stats["bfs"];
+    table["scale"] = scale;
+    table["edgefactor"] = conf.edgefactor;
+    table["vertices"] = g.vertices;
+    table["edges"] = g.edges();
+    table["graph_bytes"] = g.bytes();
+    table["build_s"] = build_s;
+    table["roots"] = roots;
+    table["threads"] = thread_counts;
+    table["alpha"] = kAlpha;
+    table["beta"] = kBeta;
+
+    BfsState s(g.vertices);
+    for (const Direction dir : {Direction::TopDown, Direction::BottomUp, Direction::Optimizing}) {
+        const std::string name = std::string("bfs_") + direction_name(dir);
+        double base_rate = 0.0;
+        for (const int threads : thread_counts) {
+            bool ok = true;
+            json levels = json::array();
+            for (std::size_t r = 0; r < roots.size(); ++r) {
+                bfs(g, roots[r], dir, threads, s);
+                std::size_t cnt = 0;
+                for (std::size_t v = 0; v < g.vertices; ++v) cnt += s.parent[v].load(std::memory_order_relaxed) != kUnvisited;
+                ok = ok && cnt == reached[r];
+                if (r == 0) {
+                    ok = ok && validate_tree(g, roots[0], s, depth0);
+                    for (std::size_t l = 0; l < s.levels.size(); ++l) {
+                        levels.push_back({{"level", l},
+                                          {"direction", s.levels[l].bottom_up ? "bottom_up" : "top_down"},
+                                          {"frontier", s.levels[l].frontier},
+                                          {"ns", s.levels[l].ns}});
+                    }
+                }
+            }
+            if (!ok) std::cerr << "CRITICAL: Validation failed for " << name << " threads=" << threads << "\n";
+
+            for (int w = 0; w < conf.warmup; ++w) bfs(g, roots[w % roots.size()], dir, threads, s);
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            double inv_teps_sum = 0.0;
+            for (int it = 0; it < conf.iters; ++it) {
+                const std::size_t r = static_cast<std::size_t>(it) % roots.size();
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                bfs(g, roots[r], dir, threads, s);
+
+                clobber_memory();
+                const long long ns = t.elapsed_ns();
+                samples.push_back(ns);
+                inv_teps_sum += static_cast<double>(ns) * 1e-9 / comp_edges[r];
+            }
+            const Vertex sink = s.parent[roots[0]].load(std::memory_order_relaxed);
+            do_not_optimize_away(sink);
+
+            BenchmarkResult::Point pt;
+            pt.kernel = name;
+            pt.bytes = g.bytes();
+            BenchmarkResult::fill_timing(pt, samples);
+            pt.checksum = static_cast<double>(s.levels.size());
+
+            pt.ops_per_sec = (inv_teps_sum > 0.0) ? static_cast<double>(conf.iters) / inv_teps_sum : 0.0;
+            if (threads == thread_counts.front()) base_rate = pt.ops_per_sec;
+            pt.extra["gteps"] = pt.ops_per_sec / 1e9;
+            pt.extra["threads"] = threads;
+            pt.extra["scale"] = scale;
+            pt.extra["edgefactor"] = conf.edgefactor;
+            if (base_rate > 0.0) pt.extra["speedup"] = pt.ops_per_sec / base_rate;
+
+            json& cell = table["variants"][direction_name(dir)][std::to_string(threads)];
+            cell["teps_harmonic_mean"] = pt.ops_per_sec;
+            if (base_rate > 0.0) cell["speedup"] = pt.ops_per_sec / base_rate;
+            cell["levels"] = std::move(levels);
+            cell["valid"] = ok;
+
+            std::cout << "[BFS] " << direction_name(dir) << " threads=" << threads << " GTEPS=" << pt.ops_per_sec / 1e9
+                      << " median_ms=" << pt.median_ns / 1e6 << "\n";
+            res.sweep_points.push_back(std::move(pt));
+        }
+    }
+}
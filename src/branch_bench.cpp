@@ -0,0 +1,355 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "perf_counters.hpp"
+#include "stream_kernels.hpp" // RESTRICT
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Opaque register dependency.
+ *
+ * An `asm volatile` statement in a basic block stops GCC/Clang from
+ * if-converting that block into a cmov and from vectorizing the loop, which
+ * is exactly what we need to keep the "branchy" and "scalar branchless"
+ * variants honest. MSVC has no x64 inline asm; there the variants fall back
+ * to whatever the optimizer emits.
+ */
+template <typename T>
+inline void opaque(T& v) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+r"(v));
+#else
+    (void)v;
+#endif
+}
+
+using FilterFn = std::uint32_t (*)(const std::uint32_t* data, std::size_t n, std::uint32_t thr);
+
+/**
+ * @brief Data-dependent branch: add v to the sum only when v < thr.
+ */
+std::uint32_t filter_branchy(const std::uint32_t* RESTRICT data, std::size_t n, std::uint32_t thr) {
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t v = data[i];
+        if (v < thr) {
+            sum += v;
+            opaque(sum);
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Branchless via arithmetic mask: sum += v & -(v < thr).
+ */
+std::uint32_t filter_mask(const std::uint32_t* RESTRICT data, std::size_t n, std::uint32_t thr) {
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t v = data[i];
+        sum += v & (0u - static_cast<std::uint32_t>(v < thr));
+        opaque(sum);
+    }
+    return sum;
+}
+
+/**
+ * @brief Conditional move: add = (v < thr) ? v : 0.
+ *
+ * GCC happily turns a plain ternary back into a branch when it thinks the
+ * branch is cheaper, so on x86-64/AArch64 the select is pinned to
+ * cmov/csel with inline asm. Elsewhere the ternary is left to the compiler.
+ */
+inline std::uint32_t select_below(std::uint32_t v, std::uint32_t thr) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    std::uint32_t add = 0;
+    asm("cmpl %[thr], %[v]\n\t"
+        "cmovb %[v], %[add]"
+        : [add] "+r"(add)
+        : [v] "r"(v), [thr] "r"(thr)
+        : "cc");
+    return add;
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    std::uint32_t add;
+    asm("cmp %w[v], %w[thr]\n\t"
+        "csel %w[add], %w[v], wzr, lo"
+        : [add] "=r"(add)
+        : [v] "r"(v), [thr] "r"(thr)
+        : "cc");
+    return add;
+#else
+    return (v < thr) ? v : 0u;
+#endif
+}
+
+/**
+ * @brief Branchless via select: sum += (v < thr) ? v : 0 (cmov/csel).
+ */
+std::uint32_t filter_cmov(const std::uint32_t* RESTRICT data, std::size_t n, std::uint32_t thr) {
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += select_below(data[i], thr);
+        opaque(sum);
+    }
+    return sum;
+}
+
+/**
+ * @brief SIMD compare + blend/masked add, widest ISA enabled at compile time.
+ *
+ * Values are < 2^31, so signed 32-bit compares are exact. Lane sums wrap
+ * mod 2^32 exactly like the scalar variants, so all checksums match.
+ */
+std::uint32_t filter_simd(const std::uint32_t* RESTRICT data, std::size_t n, std::uint32_t thr) {
+    std::size_t i = 0;
+    std::uint32_t sum = 0;
+#if defined(__AVX512F__)
+    const __m512i t = _mm512_set1_epi32(static_cast<int>(thr));
+    __m512i acc = _mm512_setzero_si512();
+    for (; i + 16 <= n; i += 16) {
+        const __m512i x = _mm512_loadu_si512(reinterpret_cast<const void*>(data + i));
+        const __mmask16 m = _mm512_cmplt_epi32_mask(x, t);
+        acc = _mm512_mask_add_epi32(acc, m, acc, x);
+    }
+    sum = static_cast<std::uint32_t>(_mm512_reduce_add_epi32(acc));
+#elif defined(__AVX2__)
+    const __m256i t = _mm256_set1_epi32(static_cast<int>(thr));
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i m = _mm256_cmpgt_epi32(t, x);
+        acc = _mm256_add_epi32(acc, _mm256_and_si256(x, m));
+    }
+    alignas(32) std::uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    for (std::uint32_t l : lanes) sum += l;
+#else
+    // Portable: a plain select loop the auto-vectorizer turns into compare+blend.
+    for (; i < n; ++i) {
+        const std::uint32_t v = data[i];
+        sum += (v < thr) ? v : 0u;
+    }
+#endif
+    for (; i < n; ++i) {
+        const std::uint32_t v = data[i];
+        sum += (v < thr) ? v : 0u;
+    }
+    return sum;
+}
+
+int simd_width_bits() {
+#if defined(__AVX512F__)
+    return 512;
+#elif defined(__AVX2__)
+    return 256;
+#else
+    return 0; // auto-vectorized, width chosen by the compiler
+#endif
+}
+
+struct FilterVariant {
+    const char* name;
+    FilterFn fn;
+};
+
+/**
+ * @brief Predictability of the taken/not-taken sequence.
+ *
+ * - always   : every element passes the filter
+ * - periodic : a random (p = 0.5) pattern of length `period`, repeated;
+ *              predictable once the predictor's history covers the period
+ * - random   : independent Bernoulli(p) per element
+ */
+struct BranchPattern {
+    std::string label;
+    double taken_prob;
+    std::size_t period; // 0 = not periodic
+};
+
+std::vector<BranchPattern> build_patterns() {
+    std::vector<BranchPattern> out;
+    out.push_back({"always", 1.0, 0});
+    for (std::size_t p = 2; p <= 4096; p *= 2) {
+        out.push_back({"periodic_" + std::to_string(p), 0.5, p});
+    }
+    for (double p : {0.01, 0.05, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 0.95, 0.99}) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "random_p%.2f", p);
+        out.push_back({buf, p, 0});
+    }
+    return out;
+}
+
+/**
+ * @brief Fill `data` so that (data[i] < thr) follows the requested pattern.
+ */
+void fill_pattern(std::uint32_t* data, std::size_t n, std::uint32_t thr, const BranchPattern& pat,
+                  std::mt19937& rng) {
+    std::uniform_int_distribution<std::uint32_t> below(0, thr - 1);
+    std::uniform_int_distribution<std::uint32_t> above(thr, 2 * thr - 1);
+    std::bernoulli_distribution coin(pat.taken_prob);
+
+    std::vector<char> period_bits(pat.period);
+    for (auto& b : period_bits) b = coin(rng) ? 1 : 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        bool taken = false;
+        if (pat.period > 0) {
+            taken = period_bits[i % pat.period] != 0;
+        } else {
+            taken = coin(rng);
+        }
+        data[i] = taken ? below(rng) : above(rng);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Branch-prediction runner for --kernel branch.
+ *
+ * Runs a filter-sum (`if (v < thr) sum += v`) over an L2-resident array of
+ * 64Ki uint32 values whose taken/not-taken sequence is always-taken,
+ * periodic with period P, or random with probability p. Each pattern is run
+ * through a real data-dependent branch and three branchless forms (mask
+ * arithmetic, cmov select, SIMD compare+blend).
+ *
+ * Points report ns per element and, when perf counters are available,
+ * cycles per element and branch mispredicts per element. A crossover summary
+ * (stats.branch_crossover) gives, per branchless variant, the taken
+ * probability range over which it beats the branchy loop on this CPU.
+ *
+ * @param conf The parsed configuration (warmup, iters, seed).
+ * @param res The result object to populate with sweep points.
+ */
+void run_branch_bench(const Config& conf, BenchmarkResult& res) {
+    const std::size_t n = 64 * 1024;
+    const std::uint32_t thr = 1u << 29; // values live in [0, 2^30)
+
+    benchmark::AlignedBuffer<std::uint32_t> data(n, 64);
+    std::mt19937 rng(static_cast<std::uint32_t>(conf.seed));
+
+    const FilterVariant variants[] = {
+        {"branchy", &filter_branchy},
+        {"mask", &filter_mask},
+        {"cmov", &filter_cmov},
+        {"simd_blend", &filter_simd},
+    };
+
+    benchmark::PerfCounters perf;
+    if (!perf.available(benchmark::PerfCounters::Cycles)) {
+        std::cerr << "[Branch] perf counters unavailable (check perf_event_paranoid); reporting ns only\n";
+    }
+
+    // median ns per random-p pattern, per variant (for the crossover summary)
+    std::vector<std::pair<double, std::vector<double>>> random_medians;
+
+    for (const BranchPattern& pat : build_patterns()) {
+        fill_pattern(data.data(), n, thr, pat, rng);
+
+        // Reference result (outside timed region) for validation.
+        std::uint32_t expected = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (data[i] < thr) expected += data[i];
+        }
+
+        std::vector<double> medians;
+        for (const FilterVariant& var : variants) {
+            std::uint32_t sink = 0;
+            for (int w = 0; w < conf.warmup; ++w) {
+                sink = var.fn(data.data(), n, thr);
+                do_not_optimize_away(sink);
+            }
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+
+            perf.start();
+            for (int it = 0; it < conf.iters; ++it) {
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                sink = var.fn(data.data(), n, thr);
+
+                clobber_memory();
+                samples.push_back(t.elapsed_ns());
+                do_not_optimize_away(sink);
+            }
+            perf.stop();
+
+            if (sink != expected) {
+                std::cerr << "CRITICAL: branch validation failed for " << var.name << " " << pat.label
+                          << ": got=" << sink << " expected=" << expected << "\n";
+            }
+
+            BenchmarkResult::Point pt;
+            pt.kernel = std::string("branch_") + var.name + "_" + pat.label;
+            pt.bytes = n * sizeof(std::uint32_t);
+            BenchmarkResult::fill_timing(pt, samples);
+            pt.checksum = static_cast<double>(sink);
+            pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? static_cast<double>(pt.bytes) / pt.median_ns : 0.0;
+
+            const double elems = static_cast<double>(n);
+            const double elems_total = elems * static_cast<double>(samples.size());
+            pt.ops_per_sec = (pt.median_ns > 0.0) ? elems * 1e9 / pt.median_ns : 0.0;
+            pt.extra["ns_per_elem"] = pt.median_ns / elems;
+            pt.extra["taken_prob"] = pat.taken_prob;
+            pt.extra["period"] = static_cast<double>(pat.period);
+            if (var.fn == &filter_simd) pt.extra["simd_width_bits"] = simd_width_bits();
+            if (perf.available(benchmark::PerfCounters::Cycles)) {
+                pt.extra["cycles_per_elem"] = perf.value(benchmark::PerfCounters::Cycles) / elems_total;
+            }
+            if (perf.available(benchmark::PerfCounters::BranchMisses)) {
+                pt.extra["mispredicts_per_elem"] = perf.value(benchmark::PerfCounters::BranchMisses) / elems_total;
+            }
+            if (perf.available(benchmark::PerfCounters::Branches) &&
+                perf.value(benchmark::PerfCounters::Branches) > 0.0) {
+                pt.extra["mispredict_rate"] = perf.value(benchmark::PerfCounters::BranchMisses) /
+                                              perf.value(benchmark::PerfCounters::Branches);
+            }
+
+            medians.push_back(pt.median_ns);
+            res.sweep_points.push_back(pt);
+
+            std::cout << "[Branch] " << pt.kernel << " ns_per_elem=" << pt.extra["ns_per_elem"];
+            if (pt.extra.count("mispredicts_per_elem")) {
+                std::cout << " mispredicts_per_elem=" << pt.extra["mispredicts_per_elem"];
+            }
+            std::cout << "\n";
+        }
+
+        if (pat.period == 0 && pat.label != "always") random_medians.emplace_back(pat.taken_prob, medians);
+    }
+
+    // ---- Crossover: taken-probability band where each branchless form wins ----
+    // Outside [p_low, p_high] the predictor is accurate enough that the branch is cheaper.
+    for (std::size_t v = 1; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+        json entry;
+        entry["p_low"] = nullptr;
+        entry["p_high"] = nullptr;
+        for (const auto& rm : random_medians) {
+            if (rm.second[v] < rm.second[0]) {
+                if (entry["p_low"].is_null()) entry["p_low"] = rm.first;
+                entry["p_high"] = rm.first;
+            }
+        }
+        res.extra_stats["branch_crossover"][variants[v].name] = entry;
+    }
+}
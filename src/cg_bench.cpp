@@ -0,0 +1,379 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "sparse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "compute_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using benchmark::CsrMatrix;
+
+namespace {
+
+constexpr int kTimedIters = 50;      // CG iterations per timed solve (as in one HPCG set)
+constexpr int kMaxIters = 500;       // cap for the convergence run
+constexpr double kTolerance = 1e-8;  // relative residual ||r|| / ||b|| of the convergence run
+constexpr int kMaxSolves = 10;       // timed solves; each already averages kTimedIters iterations
+constexpr int kColors = 8;           // (x, y, z) parity classes: independent for a 27-point stencil
+
+enum class Precond { None, Jacobi, SymGS };
+
+const char* precond_name(Precond p) {
+    switch (p) {
+        case Precond::None:   return "none";
+        case Precond::Jacobi: return "jacobi";
+        case Precond::SymGS:  return "symgs";
+    }
+    return "unknown";
+}
+
+enum Phase { kSpmv, kDot, kWaxpby, kPrecond, kPhases };
+const char* const kPhaseNames[kPhases] = {"spmv", "dot", "waxpby", "precond"};
+
+/// Time, flops and modelled bytes spent in each phase (summed over calls).
+struct PhaseTotals {
+    double ns[kPhases] = {};
+    double flops[kPhases] = {};
+    double bytes[kPhases] = {};
+
+    double total_ns() const { return ns[kSpmv] + ns[kDot] + ns[kWaxpby] + ns[kPrecond]; }
+    double total_flops() const { return flops[kSpmv] + flops[kDot] + flops[kWaxpby] + flops[kPrecond]; }
+    double total_bytes() const { return bytes[kSpmv] + bytes[kDot] + bytes[kWaxpby] + bytes[kPrecond]; }
+};
+
+/**
+ * @brief HPCG problem, rows renumbered colour by colour.
+ *
+ * The 27-point matrix is symmetrically permuted so the 8 parity colours are
+ * contiguous row ranges; within a colour no two rows are coupled, so each
+ * Gauss-Seidel colour step is a plain parallel loop over one range. CG
+ * without (or with Jacobi) preconditioning is unaffected by the permutation.
+ */
+struct CgProblem {
+    std::size_t nx = 0;
+    CsrMatrix a;
+    std::vector<double> b;         // A * ones, so the exact solution is all ones
+    std::vector<double> inv_diag;
+    std::size_t color_start[kColors + 1] = {};
+    double norm_b = 0.0;
+};
+
+CgProblem make_problem(std::size_t n) {
+    const CsrMatrix nat = benchmark::generate_stencil27(n, n, n);
+    const std::size_t rows = nat.rows;
+
+    CgProblem pb;
+    pb.nx = n;
+    auto color_of = [n](std::size_t r) {
+        const std::size_t x = r % n, y = (r / n) % n, z = r / (n * n);
+        return static_cast<int>((x & 1) | ((y & 1) << 1) | ((z & 1) << 2));
+    };
+    for (std::size_t r = 0; r < rows; ++r) ++pb.color_start[color_of(r) + 1];
+    for (int c = 0; c < kColors; ++c) pb.color_start[c + 1] += pb.color_start[c];
+
+    std::vector<std::size_t> next(pb.color_start, pb.color_start + kColors);
+    std::vector<std::int32_t> old_of(rows), new_of(rows);
+    for (std::size_t r = 0; r < rows; ++r) {
+        const std::size_t i = next[color_of(r)]++;
+        old_of[i] = static_cast<std::int32_t>(r);
+        new_of[r] = static_cast<std::int32_t>(i);
+    }
+
+    CsrMatrix& a = pb.a;
+    a.rows = a.cols = rows;
+    a.row_ptr.reserve(rows + 1);
+    a.row_ptr.push_back(0);
+    a.col.reserve(nat.nnz());
+    a.val.reserve(nat.nnz());
+    pb.b.resize(rows);
+    pb.inv_diag.resize(rows);
+    std::vector<std::pair<std::int32_t, double>> entries;
+    for (std::size_t i = 0; i < rows; ++i) {
+        const std::size_t r = static_cast<std::size_t>(old_of[i]);
+        entries.clear();
+        double row_sum = 0.0;
+        for (std::int64_t k = nat.row_ptr[r]; k < nat.row_ptr[r + 1]; ++k) {
+            entries.emplace_back(new_of[static_cast<std::size_t>(nat.col[k])], nat.val[k]);
+            row_sum += nat.val[k];
+            if (static_cast<std::size_t>(nat.col[k]) == r) pb.inv_diag[i] = 1.0 / nat.val[k];
+        }
+        std::sort(entries.begin(), entries.end());
+        for (const auto& e : entries) {
+            a.col.push_back(e.first);
+            a.val.push_back(e.second);
+        }
+        a.row_ptr.push_back(static_cast<std::int64_t>(a.val.size()));
+        pb.b[i] = row_sum;
+    }
+    double bb = 0.0;
+    for (const double v : pb.b) bb += v * v;
+    pb.norm_b = std::sqrt(bb);
+    return pb;
+}
+
+/// Solver work vectors (64-byte aligned, first-touched by the team that uses them).
+struct CgVectors {
+    benchmark::AlignedBuffer<double> x, r, z, p, ap;
+
+    explicit CgVectors(std::size_t n) : x(n, 64), r(n, 64), z(n, 64), p(n, 64), ap(n, 64) {}
+};
+
+/// z = D^-1 r.
+void precond_jacobi(const CgProblem& pb, const double* r, double* z, int threads) {
+    const double* const d = pb.inv_diag.data();
+    const long long n = static_cast<long long>(pb.a.rows);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < n; ++i) z[i] = r[i] * d[i];
+}
+
+/// One Gauss-Seidel step over colour `c`: z_i += (r_i - (A z)_i) / a_ii.
+void symgs_color(const CgProblem& pb, const double* r, double* z, int c, int threads) {
+    const std::int64_t* const rp = pb.a.row_ptr.data();
+    const std::int32_t* const ci = pb.a.col.data();
+    const double* const v = pb.a.val.data();
+    const double* const d = pb.inv_diag.data();
+    const long long lo = static_cast<long long>(pb.color_start[c]);
+    const long long hi = static_cast<long long>(pb.color_start[c + 1]);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = lo; i < hi; ++i) {
+        double sum = r[i];
+        for (std::int64_t k = rp[i]; k < rp[i + 1]; ++k) sum -= v[k] * z[ci[k]];
+        z[i] += sum * d[i];
+    }
+}
+
+/// Multicolour symmetric Gauss-Seidel from z = 0: colours 0..7, then 7..0.
+void precond_symgs(const CgProblem& pb, const double* r, double* z, int threads) {
+    const long long n = static_cast<long long>(pb.a.rows);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < n; ++i) z[i] = 0.0;
+    for (int c = 0; c < kColors; ++c) symgs_color(pb, r, z, c, threads);
+    for (int c = kColors - 1; c >= 0; --c) symgs_color(pb, r, z, c, threads);
+}
+
+struct CgOutcome {
+    int iters = 0;
+    double rel_residual = 0.0;
+};
+
+/**
+ * @brief Preconditioned CG from x = 0, each phase timed separately.
+ *
+ * Dots and vector updates are compute_dot_kernel / compute_saxpy_kernel
+ * (every CG update has the a * x + y form); SpMV is benchmark::spmv_csr.
+ * Stops after `max_iters` or once ||r|| / ||b|| <= tol (tol = 0: fixed
+ * work). If `history` is set it receives the relative residual per iteration.
+ */
+CgOutcome cg_solve(const CgProblem& pb, Precond pc, int threads, int max_iters, double tol, CgVectors& v,
+                   PhaseTotals& ph, std::vector<double>* history) {
+    const std::size_t n = pb.a.rows;
+    const double rows = static_cast<double>(n);
+    const double nnz = static_cast<double>(pb.a.nnz());
+    double* const x = v.x.data();
+    double* const r = v.r.data();
+    double* const p = v.p.data();
+    double* const ap = v.ap.data();
+    double* const z = (pc == Precond::None) ? r : v.z.data();
+
+    auto timed = [&ph](Phase phase, double flops, double bytes, auto&& fn) {
+        Timer t;
+        t.start();
+        fn();
+        ph.ns[phase] += static_cast<double>(t.elapsed_ns());
+        ph.flops[phase] += flops;
+        ph.bytes[phase] += bytes;
+    };
+    auto dot = [&](const double* a, const double* b) {
+        double s = 0.0;
+        timed(kDot, 2.0 * rows, 16.0 * rows, [&] { s = compute_dot_kernel(a, b, n, threads); });
+        return s;
+    };
+    auto waxpby = [&](double alpha, const double* a, const double* b, double* out) {
+        timed(kWaxpby, 2.0 * rows, 24.0 * rows, [&] { compute_saxpy_kernel(alpha, a, b, out, n, threads); });
+    };
+    auto precond = [&] {
+        if (pc == Precond::Jacobi) {
+            timed(kPrecond, rows, 24.0 * rows, [&] { precond_jacobi(pb, r, z, threads); });
+        } else if (pc == Precond::SymGS) {
+            // Two sweeps, each reading the matrix and r, updating z (HPCG counts 4 flops / nnz).
+            timed(kPrecond, 4.0 * nnz, 2.0 * (12.0 * nnz + 40.0 * rows) + 8.0 * rows,
+                  [&] { precond_symgs(pb, r, z, threads); });
+        }
+    };
+
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        x[i] = 0.0;
+        r[i] = pb.b[static_cast<std::size_t>(i)];
+    }
+
+    CgOutcome out;
+    out.rel_residual = 1.0;
+    precond();
+    std::memcpy(p, z, n * sizeof(double));
+    double rz = dot(r, z);
+    for (int k = 1; k <= max_iters; ++k) {
+        timed(kSpmv, 2.0 * nnz, 12.0 * nnz + 24.0 * rows, [&] { benchmark::spmv_csr(pb.a, p, ap, threads); });
+        const double pap = dot(p, ap);
+        if (!(pap > 0.0)) break; // exact solution reached
+        const double alpha = rz / pap;
+        waxpby(alpha, p, x, x);
+        waxpby(-alpha, ap, r, r);
+        const double rr = dot(r, r);
+        out.iters = k;
+        out.rel_residual = std::sqrt(rr) / pb.norm_b;
+        if (history) history->push_back(out.rel_residual);
+        if (out.rel_residual <= tol) break;
+
+        precond();
+        const double rz_new = (pc == Precond::None) ? rr : dot(r, z);
+        const double beta = rz_new / rz;
+        rz = rz_new;
+        waxpby(beta, p, z, p);
+    }
+    return out;
+}
+
+void run_cg_case(const Config& conf, BenchmarkResult& res, const CgProblem& pb, Precond pc, json& table) {
+    const int threads = conf.threads;
+    const std::size_t n = pb.a.rows;
+    CgVectors v(n);
+    const char* name = precond_name(pc);
+    json& row = table["preconditioners"][name];
+
+    // Convergence run: solve to kTolerance and keep the residual history.
+    PhaseTotals conv_ph;
+    std::vector<double> history;
+    const CgOutcome conv = cg_solve(pb, pc, threads, kMaxIters, kTolerance, v, conv_ph, &history);
+    double max_err = 0.0;
+    for (std::size_t i = 0; i < n; ++i) max_err = std::max(max_err, std::fabs(v.x[i] - 1.0));
+    row["iterations_to_tolerance"] = conv.iters;
+    row["converged"] = conv.rel_residual <= kTolerance;
+    row["final_rel_residual"] = conv.rel_residual;
+    row["max_solution_error"] = max_err;
+    row["residual_history"] = history;
+
+    // Timed runs: fixed kTimedIters iterations per solve.
+    const int warmup = std::min(conf.warmup, 1);
+    const int solves = std::max(1, std::min(conf.iters, kMaxSolves));
+    PhaseTotals ph;
+    for (int w = 0; w < warmup; ++w) {
+        PhaseTotals scratch;
+        const CgOutcome o = cg_solve(pb, pc, threads, kTimedIters, 0.0, v, scratch, nullptr);
+        do_not_optimize_away(o.rel_residual);
+    }
+    std::vector<long long> samples;
+    samples.reserve(solves);
+    int timed_iters = 0;
+    for (int s = 0; s < solves; ++s) {
+        Timer t;
+        clobber_memory();
+        t.start();
+
+        const CgOutcome o = cg_solve(pb, pc, threads, kTimedIters, 0.0, v, ph, nullptr);
+
+        clobber_memory();
+        samples.push_back(t.elapsed_ns());
+        timed_iters = o.iters;
+        do_not_optimize_away(o.rel_residual);
+    }
+
+    BenchmarkResult::Point pt;
+    pt.kernel = std::string("cg_") + name;
+    pt.bytes = n * sizeof(double); // one vector
+    BenchmarkResult::fill_timing(pt, samples);
+    const std::size_t stride = std::max<std::size_t>(1, n / 1024);
+    for (std::size_t i = 0; i < n; i += stride) pt.checksum += v.x[i];
+
+    const double per_solve_flops = ph.total_flops() / solves;
+    const double gflops = (pt.median_ns > 0.0) ? per_solve_flops / pt.median_ns : 0.0;
+    pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? ph.total_bytes() / solves / pt.median_ns : 0.0;
+    pt.extra["gflops"] = gflops;
+    pt.extra["iterations"] = timed_iters;
+    pt.extra["iterations_to_tolerance"] = conv.iters;
+    pt.extra["final_rel_residual"] = conv.rel_residual;
+    pt.extra["nx"] = static_cast<double>(pb.nx);
+    pt.extra["threads"] = threads;
+
+    row["gflops"] = gflops;
+    row["effective_gb_s"] = pt.bandwidth_gb_s;
+    row["timed_iterations"] = timed_iters;
+    const double total_ns = ph.total_ns();
+    for (int k = 0; k < kPhases; ++k) {
+        if (ph.ns[k] <= 0.0) continue;
+        const std::string phase = kPhaseNames[k];
+        const double share = total_ns > 0.0 ? ph.ns[k] / total_ns : 0.0;
+        const double phase_gflops = ph.flops[k] / ph.ns[k];
+        pt.extra[phase + "_share"] = share;
+        pt.extra[phase + "_gflops"] = phase_gflops;
+        json& pr = row["phases"][phase];
+        pr["ns_per_iteration"] = ph.ns[k] / solves / std::max(1, timed_iters);
+        pr["share"] = share;
+        pr["gflops"] = phase_gflops;
+        pr["gb_s"] = ph.bytes[k] / ph.ns[k];
+    }
+
+    std::cout << "[CG] " << name << " n=" << pb.nx << "^3 gflops=" << gflops << " GB/s=" << pt.bandwidth_gb_s
+              << " iters_to_tol=" << conv.iters << (conv.rel_residual <= kTolerance ? "" : " (not converged)")
+              << " spmv=" << 100.0 * pt.extra["spmv_share"] << "%\n";
+    res.sweep_points.push_back(std::move(pt));
+}
+
+} // namespace
+
+/**
+ * @brief HPCG-style conjugate gradient mini-app for --kernel cg.
+ *
+ * Solves A x = A * ones on the HPCG 27-point matrix over an n^3 grid sized
+ * so matrix + vectors take about --size bytes. The solver composes
+ * compute_dot_kernel, compute_saxpy_kernel and benchmark::spmv_csr with no
+ * preconditioner, Jacobi, or multicolour symmetric Gauss-Seidel (the
+ * 8-colour ordering makes each half-sweep parallel).
+ *
+ * Each preconditioner first runs to ||r|| / ||b|| <= 1e-8 (at most 500
+ * iterations) for the convergence record, then times fixed 50-iteration
+ * solves (at most 1 warmup and 10 samples). Points report overall GFLOP/s,
+ * modelled GB/s and each phase's share of the time; stats.cg holds the
+ * per-phase ns / GFLOP/s / GB/s, the residual history and the symgs
+ * GFLOP/s as the host score.
+ *
+ * @param conf The parsed configuration (size, threads, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_cg_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    // Per row: 27 x (8 B value + 4 B index) + 8 B row pointer + 7 vectors.
+    constexpr double kBytesPerRow = 27.0 * 12.0 + 8.0 + 7.0 * 8.0;
+    const std::size_t n = std::min<std::size_t>(
+        1024, std::max<std::size_t>(16, static_cast<std::size_t>(std::cbrt(static_cast<double>(size_bytes) / kBytesPerRow))));
+    const CgProblem pb = make_problem(n);
+
+    json& table = res.extra_stats["cg"];
+    table["nx"] = n;
+    table["rows"] = pb.a.rows;
+    table["nnz"] = pb.a.nnz();
+    table["threads"] = conf.threads;
+    table["tolerance"] = kTolerance;
+    for (const Precond pc : {Precond::None, Precond::Jacobi, Precond::SymGS}) {
+        run_cg_case(conf, res, pb, pc, table);
+    }
+    table["score_gflops"] = table["preconditioners"]["symgs"]["gflops"];
+}
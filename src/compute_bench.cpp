@@ -4,17 +4,44 @@
 #include "timer.hpp"
 #include "utils.hpp"
 #include "aligned_buffer.hpp"
+#include "stream_kernels.hpp"
+#include "compute_kernels.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+void run_stream_sweep(const Config& conf, BenchmarkResult& res, StreamOp op);
+
 namespace {
 
+/// Threads in the current parallel region (1 without OpenMP).
+inline int omp_team_size() {
+#if defined(_OPENMP)
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
 /**
  * @brief Calculate a sampled checksum of an array.
  *
@@ -133,51 +160,1607 @@ double compute_flops_kernel(std::vector<double>& a, int inner) {
     return Validator::checksum_sampled(a, stride);
 }
 
+// ---------- Dot product variants (accuracy / reproducibility) ----------
+
+/**
+ * @brief Pin an intermediate so -ffast-math cannot reassociate through it.
+ *
+ * Compensated sums are algebraically zero-correction: under -ffast-math the
+ * compiler may rewrite c = (t - s) - y into 0. Laundering the intermediates
+ * through an empty asm keeps the exact evaluation order without emitting
+ * any instruction. MSVC (built with /fp:fast) has no inline asm on x64, so
+ * there the value takes a volatile round trip instead: one store and load.
+ */
+inline void fp_barrier(double& v) {
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(__x86_64__) || defined(__i386__)
+    asm volatile("" : "+x"(v));
+#elif defined(__aarch64__)
+    asm volatile("" : "+w"(v));
+#else
+    asm volatile("" : "+m"(v));
+#endif
+#else
+    volatile double pinned = v;
+    v = pinned;
+#endif
+}
+
+/// Neumaier's improved Kahan step: s += x with running compensation c.
+inline void neumaier_add(double& s, double& c, double x) {
+    double t = s + x;
+    fp_barrier(t);
+    double d = (std::abs(s) >= std::abs(x)) ? (s - t) : (x - t);
+    fp_barrier(d);
+    c += d + ((std::abs(s) >= std::abs(x)) ? x : s);
+    s = t;
+}
+
+/// Classic Kahan step: s += x with running compensation c.
+inline void kahan_add(double& s, double& c, double x) {
+    double y = x - c;
+    double t = s + y;
+    fp_barrier(t);
+    double d = t - s;
+    fp_barrier(d);
+    c = d - y;
+    s = t;
+}
+
+// Lanes per thread in the compensated loops: four independent (sum, c)
+// chains hide the add latency that a single compensated chain serializes on.
+constexpr int kCompLanes = 4;
+
+/**
+ * @brief Compensated (Kahan or Neumaier) dot product.
+ *
+ * Each thread runs kCompLanes compensated chains over its static slice; the
+ * per-thread results are combined with Neumaier in thread order. Accurate
+ * to ~1 ulp independent of n, but the split (and so the rounding) still
+ * depends on the thread count.
+ */
+template <bool Neumaier>
+double compute_dot_compensated(const double* x, const double* y, std::size_t n, int threads) {
+    double total_s = 0.0, total_c = 0.0;
+    #pragma omp parallel num_threads(threads)
+    {
+        double s[kCompLanes] = {}, c[kCompLanes] = {};
+        #pragma omp for schedule(static) nowait
+        for (long long i = 0; i < static_cast<long long>(n / kCompLanes); ++i) {
+            const std::size_t base = static_cast<std::size_t>(i) * kCompLanes;
+            for (int l = 0; l < kCompLanes; ++l) {
+                const double p = x[base + l] * y[base + l];
+                if (Neumaier) neumaier_add(s[l], c[l], p);
+                else kahan_add(s[l], c[l], p);
+            }
+        }
+        double ts = 0.0, tc = 0.0;
+        for (int l = 0; l < kCompLanes; ++l) {
+            neumaier_add(ts, tc, s[l]);
+            tc += Neumaier ? c[l] : -c[l];
+        }
+        #pragma omp for ordered schedule(static, 1)
+        for (int t = 0; t < omp_team_size(); ++t) {
+            #pragma omp ordered
+            {
+                neumaier_add(total_s, total_c, ts);
+                total_c += tc;
+            }
+        }
+    }
+    for (std::size_t i = (n / kCompLanes) * kCompLanes; i < n; ++i) neumaier_add(total_s, total_c, x[i] * y[i]);
+    return total_s + total_c;
+}
+
+// Fixed reduction geometry for the deterministic variants: block boundaries
+// depend only on n, never on the thread count.
+constexpr std::size_t kDotBlock = 4096;
+
 /**
- * @brief Standard Dot Product kernel.
+ * @brief Partial dot products of fixed kDotBlock-element blocks.
  *
- * Computes the dot product of two vectors: sum(x[i] * y[i]).
- * This is a fundamental BLAS Level 1 operation, heavily reliant on memory
- * bandwidth but also capable of utilizing SIMD instructions (AVX/AVX2) for
- * the multiplication and reduction.
+ * Any thread may compute any block; the block sum itself is the same code
+ * on the same addresses, so each partial is bitwise identical for every
+ * thread count.
+ */
+std::vector<double> dot_block_partials(const double* x, const double* y, std::size_t n, int threads) {
+    const std::size_t nblocks = (n + kDotBlock - 1) / kDotBlock;
+    std::vector<double> partials(nblocks, 0.0);
+    double* const out = partials.data();
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long b = 0; b < static_cast<long long>(nblocks); ++b) {
+        const std::size_t lo = static_cast<std::size_t>(b) * kDotBlock;
+        const std::size_t hi = std::min(n, lo + kDotBlock);
+        double sum = 0.0;
+        for (std::size_t i = lo; i < hi; ++i) sum += x[i] * y[i];
+        out[b] = sum;
+    }
+    return partials;
+}
+
+/**
+ * @brief Fixed-blocking deterministic dot: block partials summed in index order.
  *
- * @param x Pointer to the first vector.
- * @param y Pointer to the second vector.
- * @param n Number of elements in the vectors.
- * @return The scalar dot product result.
+ * Bitwise identical for any thread count; the linear combine is cheap
+ * (n / 4096 adds) but carries O(n / 4096) rounding error growth.
  */
-double compute_dot_kernel(const double* x, const double* y, std::size_t n) {
+double compute_dot_blocked(const double* x, const double* y, std::size_t n, int threads) {
+    const std::vector<double> partials = dot_block_partials(x, y, n, threads);
     double sum = 0.0;
-    #pragma omp parallel for reduction(+:sum) schedule(static)
-    for (long long i = 0; i < static_cast<long long>(n); ++i) {
-        sum += x[i] * y[i];
+    for (double p : partials) sum += p;
+    return sum;
+}
+
+/**
+ * @brief Pairwise dot: block partials combined as a balanced binary tree.
+ *
+ * Only the combine is pairwise: each kDotBlock-element partial is still a
+ * linear sum, so error grows as O(kDotBlock + log(n / kDotBlock)) rather
+ * than O(n) (or O(log n) for a tree all the way down). Deterministic for
+ * the same reason as compute_dot_blocked().
+ */
+double compute_dot_pairwise(const double* x, const double* y, std::size_t n, int threads) {
+    std::vector<double> level = dot_block_partials(x, y, n, threads);
+    while (level.size() > 1) {
+        const std::size_t half = level.size() / 2;
+        for (std::size_t i = 0; i < half; ++i) level[i] = level[2 * i] + level[2 * i + 1];
+        if (level.size() & 1) {
+            level[half] = level.back();
+            level.resize(half + 1);
+        } else {
+            level.resize(half);
+        }
+    }
+    return level.empty() ? 0.0 : level.front();
+}
+
+// ---------- Register-resident peak FLOPS (--kernel peak) ----------
+//
+// Each ISA variant runs K independent accumulator chains x = x * alpha + beta
+// entirely in registers: no loads/stores in the loop, so the only limit is
+// the FMA pipes. K must cover latency x pipes (4 x 2 = 8 on current x86,
+// up to 5 x 2 = 10 on some cores), hence the 8/12/16 accumulator variants.
+
+#if defined(__FMA__)
+#define PEAK_HAS_FMA 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+/// One double per instruction (vfmadd231sd, or mulsd+addsd without FMA).
+struct PeakScalar {
+    using V = __m128d;
+    static constexpr const char* name = "scalar";
+    static constexpr int lanes = 1;
+    static V set1(double v) { return _mm_set_sd(v); }
+#if defined(PEAK_HAS_FMA)
+    static V fma(V x, V a, V b) { return _mm_fmadd_sd(x, a, b); }
+#else
+    static V fma(V x, V a, V b) { return _mm_add_sd(_mm_mul_sd(x, a), b); }
+#endif
+    static double first(V v) { return _mm_cvtsd_f64(v); }
+    static V load(const double* p) { return _mm_load_sd(p); }
+    static void store(double* p, V v) { _mm_store_sd(p, v); }
+    static V add(V a, V b) { return _mm_add_sd(a, b); }
+    static V bor(V a, V b) { return _mm_or_pd(a, b); }
+};
+
+struct PeakSse2 {
+    using V = __m128d;
+    static constexpr const char* name = "sse2";
+    static constexpr int lanes = 2;
+    static V set1(double v) { return _mm_set1_pd(v); }
+#if defined(PEAK_HAS_FMA)
+    static V fma(V x, V a, V b) { return _mm_fmadd_pd(x, a, b); }
+#else
+    static V fma(V x, V a, V b) { return _mm_add_pd(_mm_mul_pd(x, a), b); }
+#endif
+    static double first(V v) { return _mm_cvtsd_f64(v); }
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V bor(V a, V b) { return _mm_or_pd(a, b); }
+};
+#else
+/// Portable fallback. Plain doubles may be re-vectorized by the compiler,
+/// so on these targets "scalar" is whatever the auto-vectorizer makes of it.
+struct PeakScalar {
+    using V = double;
+    static constexpr const char* name = "scalar";
+    static constexpr int lanes = 1;
+    static V set1(double v) { return v; }
+    static V fma(V x, V a, V b) { return std::fma(x, a, b); }
+    static double first(V v) { return v; }
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+    static V add(V a, V b) { return a + b; }
+    static V bor(V a, V b) {
+        std::uint64_t ua, ub;
+        std::memcpy(&ua, &a, sizeof(ua));
+        std::memcpy(&ub, &b, sizeof(ub));
+        ua |= ub;
+        std::memcpy(&a, &ua, sizeof(a));
+        return a;
+    }
+};
+#endif
+
+#if defined(__AVX__)
+struct PeakAvx {
+    using V = __m256d;
+    static constexpr const char* name = "avx";
+    static constexpr int lanes = 4;
+    static V set1(double v) { return _mm256_set1_pd(v); }
+#if defined(PEAK_HAS_FMA)
+    static V fma(V x, V a, V b) { return _mm256_fmadd_pd(x, a, b); }
+#else
+    static V fma(V x, V a, V b) { return _mm256_add_pd(_mm256_mul_pd(x, a), b); }
+#endif
+    static double first(V v) { return _mm256_cvtsd_f64(v); }
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V bor(V a, V b) { return _mm256_or_pd(a, b); }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct PeakAvx512 {
+    using V = __m512d;
+    static constexpr const char* name = "avx512";
+    static constexpr int lanes = 8;
+    static V set1(double v) { return _mm512_set1_pd(v); }
+    static V fma(V x, V a, V b) { return _mm512_fmadd_pd(x, a, b); }
+    static double first(V v) { return _mm512_cvtsd_f64(v); }
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V bor(V a, V b) {
+        return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+};
+#endif
+
+/**
+ * @brief K register-resident FMA chains, `rounds` steps each.
+ *
+ * alpha/beta give the fixed point x = 1, so values stay normal for any
+ * round count. The k-loop has a constant trip count and is fully unrolled,
+ * which keeps acc[] in registers (K + 2 constants must fit the register file).
+ *
+ * @return Sum of lane 0 of every accumulator (DCE guard / checksum).
+ */
+template <class Isa, int K>
+double peak_fma_chains(std::size_t rounds) {
+    using V = typename Isa::V;
+    const V alpha = Isa::set1(0.9999999);
+    const V beta = Isa::set1(1e-7);
+    V acc[K];
+    for (int k = 0; k < K; ++k) acc[k] = Isa::set1(1.0 + 1e-3 * k);
+
+    for (std::size_t r = 0; r < rounds; ++r) {
+        for (int k = 0; k < K; ++k) acc[k] = Isa::fma(acc[k], alpha, beta);
     }
+
+    double sum = 0.0;
+    for (int k = 0; k < K; ++k) sum += Isa::first(acc[k]);
     return sum;
 }
 
+struct PeakVariant {
+    const char* isa;
+    int lanes;
+    int accumulators;
+    double (*fn)(std::size_t);
+};
+
+template <class Isa, int K>
+PeakVariant peak_variant() {
+    return PeakVariant{Isa::name, Isa::lanes, K, &peak_fma_chains<Isa, K>};
+}
+
+// ---------- Arithmetic-intensity sweep (--kernel roofline) ----------
+
+#if defined(__AVX512F__)
+using PeakWide = PeakAvx512;
+#elif defined(__AVX__)
+using PeakWide = PeakAvx;
+#elif defined(__SSE2__) || defined(_M_X64)
+using PeakWide = PeakSse2;
+#else
+using PeakWide = PeakScalar;
+#endif
+
+/// Independent vector chains per block: covers FMA latency x 2 pipes.
+constexpr int kIntensityChains = 8;
+
+/**
+ * @brief One arithmetic-intensity setting: FMAs per element, or one of the
+ * two sub-FMA modes used below 1/4 flop/byte.
+ */
+struct IntensityStep {
+    double ai;   // flops per byte of streamed input
+    int fmas;    // >= 1: FMAs per element; 0: one add per element; -1: one add per two elements
+};
+
+/**
+ * @brief Flop/byte ladder 1/16 .. 64. Each element is 8 bytes, so k FMAs
+ * per element (2k flops) is k/4 flop/byte; the two lowest rungs drop to a
+ * plain add on every (1/8) or every other (1/16) loaded vector.
+ */
+std::vector<IntensityStep> build_intensity_ladder() {
+    std::vector<IntensityStep> ladder;
+    ladder.push_back({1.0 / 16.0, -1});
+    ladder.push_back({1.0 / 8.0, 0});
+    for (int fmas = 1; fmas <= 256; fmas *= 2) ladder.push_back({fmas / 4.0, fmas});
+    return ladder;
+}
+
 /**
- * @brief Standard SAXPY (Single-precision A*X Plus Y) kernel.
- *
- * Computes `out[i] = a * x[i] + y[i]`.
- * Another fundamental BLAS Level 1 operation. It reads two arrays and writes
- * to a third, making it very similar to the STREAM Triad benchmark, but
- * typically used in a compute context to measure vectorization efficiency.
- *
- * @param a The scalar multiplier.
- * @param x Pointer to the first input vector.
- * @param y Pointer to the second input vector.
- * @param out Pointer to the output vector.
- * @param n Number of elements to process.
+ * @brief Stream `passes` times over x[0..n) doing `step.fmas` work per element.
+ *
+ * Each thread keeps the same static slice on every pass (nowait, no
+ * barrier), so a cache-sized working set stays in that thread's cache.
+ * Elements are processed in blocks of kIntensityChains vectors that form
+ * independent chains, so high-intensity rungs are throughput-bound rather
+ * than latency-bound.
+ *
+ * @return Checksum (DCE guard).
  */
-void compute_saxpy_kernel(double a, const double* x, const double* y, double* out, std::size_t n) {
-    #pragma omp parallel for schedule(static)
-    for (long long i = 0; i < static_cast<long long>(n); ++i) {
-        out[i] = a * x[i] + y[i];
+template <class Isa>
+double intensity_kernel(const double* x, std::size_t n, int fmas, int passes, int threads) {
+    using V = typename Isa::V;
+    constexpr int U = kIntensityChains;
+    const std::size_t block = static_cast<std::size_t>(U) * Isa::lanes;
+    const long long nblocks = static_cast<long long>(n / block);
+
+    double total = 0.0;
+    #pragma omp parallel num_threads(threads) reduction(+:total)
+    {
+        const V alpha = Isa::set1(0.9999999);
+        const V beta = Isa::set1(1e-7);
+        const V one = Isa::set1(1.0);
+        V acc[U];
+        for (int u = 0; u < U; ++u) acc[u] = Isa::set1(0.0);
+
+        for (int pass = 0; pass < passes; ++pass) {
+            #pragma omp for schedule(static) nowait
+            for (long long b = 0; b < nblocks; ++b) {
+                const double* p = x + static_cast<std::size_t>(b) * block;
+                V v[U];
+                for (int u = 0; u < U; ++u) v[u] = Isa::load(p + u * Isa::lanes);
+
+                if (fmas < 0) {
+                    // Half the vectors are added, the other half only OR'ed
+                    // in (a bitwise op, not a flop) so every byte is still read.
+                    for (int u = 0; u < U; u += 2) {
+                        acc[u] = Isa::add(acc[u], v[u]);
+                        acc[u + 1] = Isa::bor(acc[u + 1], v[u + 1]);
+                    }
+                } else if (fmas == 0) {
+                    for (int u = 0; u < U; ++u) acc[u] = Isa::add(acc[u], v[u]);
+                } else {
+                    for (int r = 1; r < fmas; ++r) {
+                        for (int u = 0; u < U; ++u) v[u] = Isa::fma(v[u], alpha, beta);
+                    }
+                    for (int u = 0; u < U; ++u) acc[u] = Isa::fma(v[u], one, acc[u]);
+                }
+            }
+        }
+
+        for (int u = 0; u < U; ++u) {
+            const double d = Isa::first(acc[u]);
+            if (fmas < 0 && (u & 1)) {
+                // OR accumulators hold arbitrary bit patterns (possibly NaN).
+                std::uint64_t bits = 0;
+                std::memcpy(&bits, &d, sizeof(bits));
+                total += static_cast<double>(bits & 1u);
+            } else {
+                total += d;
+            }
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Flops per element for a ladder step (matches intensity_kernel()).
+ */
+double intensity_flops_per_elem(const IntensityStep& step) {
+    if (step.fmas < 0) return 0.5;
+    if (step.fmas == 0) return 1.0;
+    return 2.0 * step.fmas;
+}
+
+using DotFn = double (*)(const double*, const double*, std::size_t, int);
+
+/**
+ * @brief Time the dot-product variants next to the fast path (--kernel dot).
+ *
+ * Each variant runs on the benchmark arrays (GFLOP/s, GB/s at 16 bytes per
+ * element). The fast path itself ("dot") is not re-timed: its row in
+ * stats.dot_variants is the baseline, with the GFLOP/s run_compute_bench()
+ * already measured (`fast_gflops`) next to its accuracy and reproducibility. Accuracy and reproducibility are judged outside the timed
+ * region on a separate ill-conditioned input from --seed (mixed signs,
+ * magnitudes 1e-8..1e8): rel_error against a long double Neumaier
+ * reference, and bitwise_reproducible = same bits at 1, 2, 3 and the
+ * default number of threads.
+ */
+void run_dot_variants(const Config& conf, BenchmarkResult& res, const double* x, const double* y,
+                      std::size_t n, double fast_gflops) {
+    struct Variant {
+        const char* name;
+        DotFn fn;
+    };
+    const std::vector<Variant> variants = {
+        {"dot", &compute_dot_kernel},
+        {"dot_kahan", &compute_dot_compensated<false>},
+        {"dot_neumaier", &compute_dot_compensated<true>},
+        {"dot_pairwise", &compute_dot_pairwise},
+        {"dot_blocked", &compute_dot_blocked},
+    };
+
+    // Ill-conditioned probe input.
+    const std::size_t probe_n = std::min<std::size_t>(n, 1u << 20);
+    std::vector<double> px(probe_n), py(probe_n);
+    std::mt19937_64 rng(static_cast<std::uint64_t>(conf.seed));
+    std::uniform_real_distribution<double> mant(1.0, 2.0);
+    std::uniform_int_distribution<int> expo(-27, 27); // ~1e-8 .. 1e8
+    std::bernoulli_distribution sign(0.5);
+    for (std::size_t i = 0; i < probe_n; ++i) {
+        px[i] = (sign(rng) ? -1.0 : 1.0) * std::ldexp(mant(rng), expo(rng));
+        py[i] = mant(rng);
+    }
+    long double ref_s = 0.0L, ref_c = 0.0L;
+    for (std::size_t i = 0; i < probe_n; ++i) {
+        const long double p = static_cast<long double>(px[i]) * static_cast<long double>(py[i]);
+        const long double t = ref_s + p;
+        ref_c += (std::abs(ref_s) >= std::abs(p)) ? (ref_s - t) + p : (p - t) + ref_s;
+        ref_s = t;
+    }
+    const double reference = static_cast<double>(ref_s + ref_c);
+
+    const int default_threads = default_team_size();
+    const std::vector<int> thread_counts = {1, 2, 3, std::max(4, default_threads)};
+
+    for (const auto& v : variants) {
+        // ---- accuracy / reproducibility probe ----
+        double first = 0.0;
+        bool reproducible = true;
+        for (std::size_t k = 0; k < thread_counts.size(); ++k) {
+            const double r = v.fn(px.data(), py.data(), probe_n, thread_counts[k]);
+            if (k == 0) first = r;
+            else if (std::memcmp(&r, &first, sizeof(double)) != 0) reproducible = false;
+        }
+        const double probe = v.fn(px.data(), py.data(), probe_n, default_threads);
+        const double rel_error = (reference != 0.0) ? std::abs(probe - reference) / std::abs(reference) : 0.0;
+
+        json& row = res.extra_stats["dot_variants"][v.name];
+        row["rel_error"] = rel_error;
+        row["bitwise_reproducible"] = reproducible;
+
+        if (v.fn == &compute_dot_kernel) {
+            // Baseline: timed (and pushed as a point) by run_compute_bench().
+            row["gflops"] = fast_gflops;
+            row["bandwidth_gb_s"] = 8.0 * fast_gflops; // 16 bytes per 2 flops
+            row["baseline"] = true;
+            std::cout << "[Compute] " << v.name << " (baseline) gflops=" << fast_gflops
+                      << " rel_error=" << rel_error << " reproducible=" << (reproducible ? "yes" : "no") << "\n";
+            continue;
+        }
+
+        // ---- timing on the benchmark arrays ----
+        for (int w = 0; w < conf.warmup; ++w) {
+            const double chk = v.fn(x, y, n, default_threads);
+            do_not_optimize_away(chk);
+        }
+        std::vector<long long> samples;
+        samples.reserve(conf.iters);
+        double checksum = 0.0;
+        for (int it = 0; it < conf.iters; ++it) {
+            Timer t;
+            clobber_memory();
+            t.start();
+
+            checksum = v.fn(x, y, n, default_threads);
+
+            clobber_memory();
+            samples.push_back(t.elapsed_ns());
+            do_not_optimize_away(checksum);
+        }
+
+        const double expected = 2.0 * static_cast<double>(n);
+        if (!Validator::nearly_equal(checksum, expected, 1e-9, 1e-6)) {
+            std::cerr << "CRITICAL: " << v.name << " validation failed: got=" << checksum
+                      << " expected=" << expected << "\n";
+        }
+
+        BenchmarkResult::Point pt;
+        pt.kernel = v.name;
+        pt.bytes = n * sizeof(double);
+        BenchmarkResult::fill_timing(pt, samples);
+        pt.checksum = checksum;
+        const double gflops = (pt.median_ns > 0.0) ? 2.0 * static_cast<double>(n) / pt.median_ns : 0.0;
+        pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? 16.0 * static_cast<double>(n) / pt.median_ns : 0.0;
+        pt.extra["gflops"] = gflops;
+        pt.extra["relative_to_fast"] = (fast_gflops > 0.0) ? gflops / fast_gflops : 0.0;
+        pt.extra["rel_error"] = rel_error;
+        pt.extra["bitwise_reproducible"] = reproducible ? 1.0 : 0.0;
+
+        row["gflops"] = gflops;
+        row["bandwidth_gb_s"] = pt.bandwidth_gb_s;
+
+        std::cout << "[Compute] " << v.name << " gflops=" << gflops << " GB/s=" << pt.bandwidth_gb_s
+                  << " rel_error=" << rel_error << " reproducible=" << (reproducible ? "yes" : "no") << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    }
+    res.extra_stats["dot_variants"]["probe_elements"] = probe_n;
+}
+
+// ---------- Dense GEMM (--kernel gemm) ----------
+//
+// Row-major, C (m x n) += A (m x k) * B (k x n). The matrices are square in
+// the sweep, but the kernels take m/n/k so edge handling is exercised.
+
+/**
+ * @brief Textbook i-j-k triple loop: one dot product per C element, B read
+ *        down a column (stride n), no blocking.
+ */
+void gemm_naive(const double* a, const double* b, double* c, std::size_t m, std::size_t n,
+                std::size_t k, int threads) {
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(m); ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            double sum = c[i * n + j];
+            for (std::size_t p = 0; p < k; ++p) sum += a[i * k + p] * b[p * n + j];
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+/// Tile sizes for the cache-blocked i-k-j variant (elements).
+struct GemmBlocking {
+    std::size_t ib = 0; ///< rows of C per task
+    std::size_t kb = 0; ///< depth of the B tile
+    std::size_t jb = 0; ///< width of the B tile / C row segment
+};
+
+/**
+ * @brief Loop-tiled i-k-j GEMM, no packing, auto-vectorized inner loop.
+ *
+ * The kb x jb tile of B is sized to half of L2 and is reused by every row of
+ * the ib-row strip; the C row segment (jb doubles) stays in L1 across the kb
+ * updates. Threads split the ib strips.
+ */
+void gemm_blocked(const double* a, const double* b, double* c, std::size_t m, std::size_t n,
+                  std::size_t k, const GemmBlocking& bl, int threads) {
+    const long long strips = static_cast<long long>((m + bl.ib - 1) / bl.ib);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long s = 0; s < strips; ++s) {
+        const std::size_t i0 = static_cast<std::size_t>(s) * bl.ib;
+        const std::size_t i1 = std::min(m, i0 + bl.ib);
+        for (std::size_t j0 = 0; j0 < n; j0 += bl.jb) {
+            const std::size_t j1 = std::min(n, j0 + bl.jb);
+            for (std::size_t p0 = 0; p0 < k; p0 += bl.kb) {
+                const std::size_t p1 = std::min(k, p0 + bl.kb);
+                for (std::size_t i = i0; i < i1; ++i) {
+                    double* const ci = c + i * n;
+                    for (std::size_t p = p0; p < p1; ++p) {
+                        const double aip = a[i * k + p];
+                        const double* const bp = b + p * n;
+                        for (std::size_t j = j0; j < j1; ++j) ci[j] += aip * bp[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Register tile of the packed micro-kernel for ISA `Isa`.
+ *
+ * NR = two vectors along a C row, MR rows broadcast from A: MR x 2
+ * accumulators plus two B vectors and one broadcast must fit the register
+ * file (12 x 2 + 3 = 27 of 32 zmm; 6 x 2 + 3 = 15 of 16 ymm/xmm).
+ */
+template <class Isa>
+struct GemmTile {
+    static constexpr int NR = 2 * Isa::lanes;
+    static constexpr int MR = (Isa::lanes >= 8) ? 12 : 6;
+};
+
+/// Cache blocking of the packed variant (elements), BLIS loop order jc-pc-ic-jr-ir.
+struct GemmPacking {
+    std::size_t mc = 0; ///< rows of the packed A block (half of L2)
+    std::size_t kc = 0; ///< depth of both packed panels (B micro-panel in half of L1)
+    std::size_t nc = 0; ///< columns of the packed B panel (half of LLC, capped)
+};
+
+/**
+ * @brief MR x NR micro-kernel: C tile += packed A micro-panel x packed B micro-panel.
+ *
+ * `ap` holds kc groups of MR A values, `bp` kc groups of NR B values, both
+ * contiguous, so the loop is two vector loads, MR broadcasts and 2 x MR FMAs
+ * per k step. Partial edge tiles (mr < MR or nr < NR) go through a stack
+ * tile; the packed panels are zero-padded so the FMA loop is unchanged.
+ */
+template <class Isa>
+void gemm_micro_kernel(std::size_t kc, const double* ap, const double* bp, double* c, std::size_t ldc,
+                       std::size_t mr, std::size_t nr) {
+    using V = typename Isa::V;
+    constexpr int MR = GemmTile<Isa>::MR;
+    constexpr int NR = GemmTile<Isa>::NR;
+    constexpr int L = Isa::lanes;
+
+    V acc[MR][2];
+    for (int r = 0; r < MR; ++r) {
+        acc[r][0] = Isa::set1(0.0);
+        acc[r][1] = Isa::set1(0.0);
+    }
+    for (std::size_t p = 0; p < kc; ++p) {
+        const V b0 = Isa::load(bp);
+        const V b1 = Isa::load(bp + L);
+        for (int r = 0; r < MR; ++r) {
+            const V ar = Isa::set1(ap[r]);
+            acc[r][0] = Isa::fma(ar, b0, acc[r][0]);
+            acc[r][1] = Isa::fma(ar, b1, acc[r][1]);
+        }
+        ap += MR;
+        bp += NR;
+    }
+
+    if (mr == static_cast<std::size_t>(MR) && nr == static_cast<std::size_t>(NR)) {
+        for (int r = 0; r < MR; ++r) {
+            double* const cr = c + r * ldc;
+            Isa::store(cr, Isa::add(Isa::load(cr), acc[r][0]));
+            Isa::store(cr + L, Isa::add(Isa::load(cr + L), acc[r][1]));
+        }
+        return;
+    }
+    alignas(64) double tile[MR * NR];
+    for (int r = 0; r < MR; ++r) {
+        Isa::store(tile + r * NR, acc[r][0]);
+        Isa::store(tile + r * NR + L, acc[r][1]);
+    }
+    for (std::size_t r = 0; r < mr; ++r) {
+        for (std::size_t j = 0; j < nr; ++j) c[r * ldc + j] += tile[r * NR + j];
+    }
+}
+
+/// Pack A[i0:i0+mc, p0:p0+kc] into MR-row micro-panels (k-major, zero-padded).
+template <int MR>
+void gemm_pack_a(const double* a, std::size_t lda, std::size_t mc, std::size_t kc, double* ap) {
+    for (std::size_t i = 0; i < mc; i += MR) {
+        const std::size_t rows = std::min<std::size_t>(MR, mc - i);
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t r = 0; r < rows; ++r) ap[r] = a[(i + r) * lda + p];
+            for (std::size_t r = rows; r < static_cast<std::size_t>(MR); ++r) ap[r] = 0.0;
+            ap += MR;
+        }
+    }
+}
+
+/// Pack one NR-column micro-panel of B[p0:p0+kc, j:j+cols] (k-major, zero-padded).
+template <int NR>
+void gemm_pack_b_panel(const double* b, std::size_t ldb, std::size_t kc, std::size_t cols, double* bp) {
+    for (std::size_t p = 0; p < kc; ++p) {
+        const double* const row = b + p * ldb;
+        for (std::size_t j = 0; j < cols; ++j) bp[j] = row[j];
+        for (std::size_t j = cols; j < static_cast<std::size_t>(NR); ++j) bp[j] = 0.0;
+        bp += NR;
+    }
+}
+
+/**
+ * @brief Packed, register-tiled GEMM in the BLIS/GotoBLAS loop order.
+ *
+ * jc (nc columns) -> pc (kc depth; B panel packed once, shared by the team)
+ * -> ic (mc rows; A block packed per thread, split across threads) -> jr / ir
+ * micro-tiles. `apack` must hold threads x mc x kc doubles and `bpack`
+ * kc x round_up(nc, NR).
+ */
+template <class Isa>
+void gemm_packed(const double* a, const double* b, double* c, std::size_t m, std::size_t n, std::size_t k,
+                 const GemmPacking& pk, double* apack, double* bpack, int threads) {
+    constexpr int MR = GemmTile<Isa>::MR;
+    constexpr int NR = GemmTile<Isa>::NR;
+
+    #pragma omp parallel num_threads(threads)
+    {
+#if defined(_OPENMP)
+        double* const ap = apack + static_cast<std::size_t>(omp_get_thread_num()) * pk.mc * pk.kc;
+#else
+        double* const ap = apack;
+#endif
+        for (std::size_t jc = 0; jc < n; jc += pk.nc) {
+            const std::size_t nc = std::min(pk.nc, n - jc);
+            const long long panels = static_cast<long long>((nc + NR - 1) / NR);
+            for (std::size_t pc = 0; pc < k; pc += pk.kc) {
+                const std::size_t kc = std::min(pk.kc, k - pc);
+
+                #pragma omp for schedule(static)
+                for (long long jp = 0; jp < panels; ++jp) {
+                    const std::size_t j = static_cast<std::size_t>(jp) * NR;
+                    gemm_pack_b_panel<NR>(b + pc * n + jc + j, n, kc, std::min<std::size_t>(NR, nc - j),
+                                          bpack + j * kc);
+                }
+
+                const long long blocks = static_cast<long long>((m + pk.mc - 1) / pk.mc);
+                #pragma omp for schedule(static)
+                for (long long ib = 0; ib < blocks; ++ib) {
+                    const std::size_t ic = static_cast<std::size_t>(ib) * pk.mc;
+                    const std::size_t mc = std::min(pk.mc, m - ic);
+                    gemm_pack_a<MR>(a + ic * k + pc, k, mc, kc, ap);
+
+                    for (std::size_t jr = 0; jr < nc; jr += NR) {
+                        const std::size_t nr = std::min<std::size_t>(NR, nc - jr);
+                        for (std::size_t ir = 0; ir < mc; ir += MR) {
+                            const std::size_t mr = std::min<std::size_t>(MR, mc - ir);
+                            gemm_micro_kernel<Isa>(kc, ap + ir * kc, bpack + jr * kc,
+                                                   c + (ic + ir) * n + jc + jr, n, mr, nr);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Round `v` down to a multiple of `q` and clamp to [lo, hi] (lo, hi multiples of q).
+std::size_t gemm_round_clamp(std::size_t v, std::size_t q, std::size_t lo, std::size_t hi) {
+    v = (v / q) * q;
+    return std::max(lo, std::min(hi, v));
+}
+
+/**
+ * @brief Cache blocking for both tiled variants from SystemInfo cache sizes
+ *        (32 KB / 1 MB / 8 MB when a level is unknown).
+ *
+ * - blocked: kb = jb with a kb x jb B tile in half of L2; ib so that the ib
+ *   C row segments fit half of L1 (min 8).
+ * - packed : kc so a kc x NR B micro-panel fills half of L1, mc so the
+ *   mc x kc A block fills half of L2, nc so the kc x nc B panel fills half
+ *   of the LLC (capped at 4096; the LLC is shared).
+ */
+void gemm_blocking_from_caches(const benchmark::SystemInfo& sys, GemmBlocking& bl, GemmPacking& pk) {
+    constexpr std::size_t MR = GemmTile<PeakWide>::MR;
+    constexpr std::size_t NR = GemmTile<PeakWide>::NR;
+    const std::size_t l1 = sys.cache_l1_bytes ? static_cast<std::size_t>(sys.cache_l1_bytes) : 32 * 1024;
+    const std::size_t l2 = sys.cache_l2_bytes ? static_cast<std::size_t>(sys.cache_l2_bytes) : 1024 * 1024;
+    const std::size_t llc = sys.cache_llc_bytes ? static_cast<std::size_t>(sys.cache_llc_bytes) : 8 * 1024 * 1024;
+    const std::size_t d = sizeof(double);
+
+    const std::size_t tile = static_cast<std::size_t>(std::sqrt(static_cast<double>(l2 / 2 / d)));
+    bl.kb = gemm_round_clamp(tile, 16, 32, 512);
+    bl.jb = bl.kb;
+    bl.ib = gemm_round_clamp(l1 / 2 / (bl.jb * d), 4, 8, 256);
+
+    pk.kc = gemm_round_clamp(l1 / 2 / (NR * d), 8, 64, 512);
+    pk.mc = gemm_round_clamp(l2 / 2 / (pk.kc * d), MR, MR, 120 * MR);
+    pk.nc = gemm_round_clamp(llc / 2 / (pk.kc * d), NR, NR, 4096);
+}
+
+// ---------- BLAS-2 (--kernel gemv) ----------
+//
+// The matrix is addressed as `rows` x `cols` in storage order (row stride
+// `cols`). Row-major y = A x and column-major y = A^T x are the "dot" form
+// (one contiguous dot product per output); row-major A^T x and column-major
+// A x are the "axpy" form (each stored row scaled into all outputs).
+
+/// Dot form: y[r] = sum_c a[r][c] * x[c]; threads split the rows.
+void gemv_dot_form(const double* a, std::size_t rows, std::size_t cols, const double* x, double* y,
+                   int threads) {
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long r = 0; r < static_cast<long long>(rows); ++r) {
+        const double* const ar = a + static_cast<std::size_t>(r) * cols;
+        double sum = 0.0;
+        for (std::size_t c = 0; c < cols; ++c) sum += ar[c] * x[c];
+        y[r] = sum;
+    }
+}
+
+/**
+ * @brief Axpy form: y[c] = sum_r a[r][c] * x[r].
+ *
+ * Each thread owns a contiguous slice of y (kept hot in cache) and streams
+ * its column range of every stored row, so no reduction across threads.
+ */
+void gemv_axpy_form(const double* a, std::size_t rows, std::size_t cols, const double* x, double* y,
+                    int threads) {
+    #pragma omp parallel num_threads(threads)
+    {
+        const std::size_t team = static_cast<std::size_t>(omp_team_size());
+#if defined(_OPENMP)
+        const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+#else
+        const std::size_t tid = 0;
+#endif
+        // 8-element (cache-line) aligned slices.
+        const std::size_t per = ((cols + team - 1) / team + 7) / 8 * 8;
+        const std::size_t c0 = std::min(cols, tid * per);
+        const std::size_t c1 = std::min(cols, c0 + per);
+        double* const ys = y + c0;
+        const std::size_t len = c1 - c0;
+        for (std::size_t c = 0; c < len; ++c) ys[c] = 0.0;
+        for (std::size_t r = 0; r < rows; ++r) {
+            const double xr = x[r];
+            const double* const ar = a + r * cols + c0;
+            for (std::size_t c = 0; c < len; ++c) ys[c] += ar[c] * xr;
+        }
+    }
+}
+
+/// Rank-1 update (GER), row-major: a[r][c] += alpha * x[r] * y[c].
+void ger_rank1(double* a, std::size_t rows, std::size_t cols, double alpha, const double* x, const double* y,
+               int threads) {
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long r = 0; r < static_cast<long long>(rows); ++r) {
+        double* const ar = a + static_cast<std::size_t>(r) * cols;
+        const double s = alpha * x[r];
+        for (std::size_t c = 0; c < cols; ++c) ar[c] += s * y[c];
+    }
+}
+
+/**
+ * @brief Blocked multi-RHS GEMV (dot form): Y[k] = A X[k] for R vectors.
+ *
+ * Each matrix row is loaded once and multiplied into R accumulators, so the
+ * matrix traffic is shared by R right-hand sides: R GEMVs for roughly the
+ * bandwidth of one while the R x-vectors stay cache-resident.
+ * `x` holds R vectors of `cols`, `y` R vectors of `rows`.
+ */
+template <int R>
+void gemv_multi_rhs(const double* a, std::size_t rows, std::size_t cols, const double* x, double* y,
+                    int threads) {
+    // Explicit PeakWide vectors over two rows at a time: each x load feeds
+    // two FMAs (GCC does not vectorize the plain loop with R reductions).
+    using Isa = PeakWide;
+    using V = typename Isa::V;
+    constexpr std::size_t L = Isa::lanes;
+    const std::size_t cv = cols / L * L;
+    const long long pairs = static_cast<long long>((rows + 1) / 2);
+
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long pr = 0; pr < pairs; ++pr) {
+        const std::size_t r0 = static_cast<std::size_t>(pr) * 2;
+        const std::size_t r1 = std::min(rows - 1, r0 + 1); // odd tail: row computed twice
+        const double* const a0 = a + r0 * cols;
+        const double* const a1 = a + r1 * cols;
+        V acc0[R], acc1[R];
+        for (int k = 0; k < R; ++k) acc0[k] = acc1[k] = Isa::set1(0.0);
+        for (std::size_t c = 0; c < cv; c += L) {
+            const V v0 = Isa::load(a0 + c);
+            const V v1 = Isa::load(a1 + c);
+            for (int k = 0; k < R; ++k) {
+                const V xk = Isa::load(x + static_cast<std::size_t>(k) * cols + c);
+                acc0[k] = Isa::fma(v0, xk, acc0[k]);
+                acc1[k] = Isa::fma(v1, xk, acc1[k]);
+            }
+        }
+        for (int k = 0; k < R; ++k) {
+            const double* const xk = x + static_cast<std::size_t>(k) * cols;
+            alignas(64) double l0[L], l1[L];
+            Isa::store(l0, acc0[k]);
+            Isa::store(l1, acc1[k]);
+            double s0 = 0.0, s1 = 0.0;
+            for (std::size_t l = 0; l < L; ++l) {
+                s0 += l0[l];
+                s1 += l1[l];
+            }
+            for (std::size_t c = cv; c < cols; ++c) {
+                s0 += a0[c] * xk[c];
+                s1 += a1[c] * xk[c];
+            }
+            y[static_cast<std::size_t>(k) * rows + r0] = s0;
+            y[static_cast<std::size_t>(k) * rows + r1] = s1;
+        }
     }
 }
 
 } // namespace
 
+/**
+ * @brief Register-resident peak FLOP/s runner for --kernel peak.
+ *
+ * Unlike flops/fma (one element loaded and stored per 64 FMA steps, four
+ * scalar chains, whatever the auto-vectorizer makes of it), every variant
+ * here is explicit SIMD with 8-16 accumulators that never leave registers.
+ * One variant per enabled ISA (scalar, SSE2, AVX/AVX2, AVX-512) and
+ * accumulator count; all run on --threads OpenMP threads.
+ *
+ * Per timed iteration each thread does --inner x 16384 rounds.
+ * fraction_of_peak divides by SystemInfo's per-core fp64 peak (CPUID width,
+ * FMA-pipe heuristic, measured clock) times --threads.
+ *
+ * @param conf The parsed configuration (threads, inner, warmup, iters).
+ * @param res The result object to populate (res.gflops = best variant).
+ */
+void run_peak_flops_bench(const Config& conf, BenchmarkResult& res) {
+    const std::size_t rounds = static_cast<std::size_t>(conf.inner) * 16384u;
+    const int threads = conf.threads;
+
+    std::vector<PeakVariant> variants;
+    variants.push_back(peak_variant<PeakScalar, 8>());
+    variants.push_back(peak_variant<PeakScalar, 12>());
+#if defined(__SSE2__) || defined(_M_X64)
+    variants.push_back(peak_variant<PeakSse2, 8>());
+    variants.push_back(peak_variant<PeakSse2, 12>());
+#endif
+#if defined(__AVX__)
+    variants.push_back(peak_variant<PeakAvx, 8>());
+    variants.push_back(peak_variant<PeakAvx, 12>());
+#endif
+#if defined(__AVX512F__)
+    // 32 zmm registers: room for 16 accumulators plus the constants.
+    variants.push_back(peak_variant<PeakAvx512, 8>());
+    variants.push_back(peak_variant<PeakAvx512, 12>());
+    variants.push_back(peak_variant<PeakAvx512, 16>());
+#endif
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const double ghz = sys.measured_core_ghz;
+    const double peak_gflops = sys.peak_gflops_fp64_per_core * threads;
+
+    double best_gflops = 0.0;
+    std::string best_kernel;
+
+    for (const auto& v : variants) {
+        auto one_iter = [&]() -> double {
+            double chk = 0.0;
+            #pragma omp parallel num_threads(threads) reduction(+:chk)
+            {
+                chk += v.fn(rounds);
+            }
+            return chk;
+        };
+
+        for (int w = 0; w < conf.warmup; ++w) {
+            const double chk = one_iter();
+            do_not_optimize_away(chk);
+        }
+
+        std::vector<long long> samples;
+        samples.reserve(conf.iters);
+        double checksum = 0.0;
+        for (int it = 0; it < conf.iters; ++it) {
+            Timer t;
+            clobber_memory();
+            t.start();
+
+            checksum = one_iter();
+
+            clobber_memory();
+            samples.push_back(t.elapsed_ns());
+            do_not_optimize_away(checksum);
+        }
+
+        BenchmarkResult::Point pt;
+        pt.kernel = std::string("peak_") + v.isa + "_acc" + std::to_string(v.accumulators);
+        pt.bytes = 0;
+        BenchmarkResult::fill_timing(pt, samples);
+        pt.checksum = checksum;
+
+        // One FMA (or mul+add) = 2 flops per lane.
+        const double flops = static_cast<double>(threads) * static_cast<double>(rounds) *
+                             v.accumulators * v.lanes * 2.0;
+        const double gflops = (pt.median_ns > 0.0) ? flops / pt.median_ns : 0.0;
+        pt.extra["gflops"] = gflops;
+        pt.extra["lanes"] = v.lanes;
+        pt.extra["accumulators"] = v.accumulators;
+        pt.extra["threads"] = threads;
+        if (peak_gflops > 0.0) {
+            pt.extra["flops_per_cycle_per_core"] = gflops / (ghz * threads);
+            pt.extra["fraction_of_peak"] = gflops / peak_gflops;
+        }
+
+        std::cout << "[Peak] " << pt.kernel << " gflops=" << gflops;
+        if (peak_gflops > 0.0) std::cout << " fraction_of_peak=" << gflops / peak_gflops;
+        std::cout << "\n";
+
+        if (gflops > best_gflops) {
+            best_gflops = gflops;
+            best_kernel = pt.kernel;
+        }
+        res.sweep_points.push_back(std::move(pt));
+    }
+
+    res.gflops = best_gflops;
+
+    json& peak = res.extra_stats["peak_flops"];
+    peak["best_kernel"] = best_kernel;
+    peak["best_gflops"] = best_gflops;
+    peak["threads"] = threads;
+    peak["rounds_per_thread"] = rounds;
+    peak["core_ghz"] = ghz;
+    peak["simd_isa"] = sys.simd_isa;
+    peak["fma_units_per_core"] = sys.fma_units_per_core;
+    if (peak_gflops > 0.0) {
+        peak["theoretical_gflops"] = peak_gflops;
+        peak["fraction_of_peak"] = best_gflops / peak_gflops;
+    }
+}
+
+/**
+ * @brief Arithmetic-intensity sweep + roofline model for --kernel roofline.
+ *
+ * 1. Ceilings, measured in the same process:
+ *    - compute: run_peak_flops_bench() (best register-resident variant)
+ *    - memory : run_stream_sweep(Triad), best bandwidth among sizes whose
+ *               three-array footprint fits each level; the 1/16 rung of the
+ *               sweep below also counts (read-only streams can beat Triad),
+ *               and is the only source for levels smaller than Triad's
+ *               smallest size.
+ * 2. The intensity ladder (1/16 .. 64 flop/byte) at one working set per
+ *    level: half of L1 / L2 per thread, half the LLC, and --size for DRAM.
+ * 3. stats.roofline: ceilings, ridge point (peak / bandwidth) per level,
+ *    and attained vs min(peak, ai x bandwidth) for every point.
+ *
+ * The ceiling runs use at most 10 iterations / 2 warmups: they are
+ * calibration, not the measurement.
+ *
+ * @param conf The parsed configuration (size, threads, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_roofline_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t dram_bytes = 0;
+    try {
+        dram_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    const int threads = conf.threads;
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const std::uint64_t l1 = sys.cache_l1_bytes ? sys.cache_l1_bytes : 32u * 1024u;
+    const std::uint64_t l2 = sys.cache_l2_bytes ? sys.cache_l2_bytes : 1024u * 1024u;
+    const std::uint64_t llc = sys.cache_llc_bytes ? sys.cache_llc_bytes : 32u * 1024u * 1024u;
+
+    struct Level {
+        const char* name;
+        std::uint64_t lower;     // Triad footprints in (lower, upper] belong to this level
+        std::uint64_t upper;     // 0 = unbounded
+        std::uint64_t working_set;
+    };
+    const std::vector<Level> levels = {
+        {"l1", 0, l1 * threads, l1 / 2 * threads},
+        {"l2", l1 * threads, l2 * threads, l2 / 2 * threads},
+        {"llc", l2 * threads, llc, llc / 2},
+        {"dram", 2 * llc, 0, dram_bytes},
+    };
+    if (dram_bytes <= 2 * llc) {
+        std::cerr << "Warning: roofline --size " << conf.size << " is not well beyond the LLC ("
+                  << llc << " bytes); the dram level will be partly cache-resident\n";
+    }
+
+    // ---- Ceilings ----
+    Config calib = conf;
+    calib.iters = std::min(conf.iters, 10);
+    calib.warmup = std::min(conf.warmup, 2);
+
+    BenchmarkResult peak_res;
+    run_peak_flops_bench(calib, peak_res);
+    const double peak_gflops = peak_res.gflops;
+
+    BenchmarkResult triad_res;
+    {
+        const ScopedOmpThreads team(threads); // stream kernels use the default team size
+        run_stream_sweep(calib, triad_res, StreamOp::Triad);
+    }
+
+    json& roof = res.extra_stats["roofline"];
+    roof["peak_gflops"] = peak_gflops;
+    roof["peak_source"] = peak_res.extra_stats["peak_flops"]["best_kernel"];
+    roof["threads"] = threads;
+
+    std::map<std::string, double> bw; // GB/s per level
+    for (const auto& lv : levels) {
+        double best = 0.0;
+        for (const auto& pt : triad_res.sweep_points) {
+            const std::uint64_t footprint = 3u * static_cast<std::uint64_t>(pt.bytes);
+            const bool fits = footprint > lv.lower && (lv.upper == 0 || footprint <= lv.upper);
+            if (fits) best = std::max(best, pt.bandwidth_gb_s);
+        }
+        bw[lv.name] = best;
+        roof["levels"][lv.name]["triad_gb_s"] = best;
+    }
+
+    for (auto& pt : peak_res.sweep_points) res.sweep_points.push_back(std::move(pt));
+    for (auto& pt : triad_res.sweep_points) res.sweep_points.push_back(std::move(pt));
+
+    // ---- Intensity ladder per level ----
+    const auto ladder = build_intensity_ladder();
+    const std::uint64_t min_traffic = 32ull * 1024 * 1024; // per timed sample, for cache levels
+
+    struct LadderPoint {
+        std::string level;
+        double ai;
+        double gflops;
+        double gb_s;
+        std::size_t index; // into res.sweep_points
+    };
+    std::vector<LadderPoint> ladder_points;
+
+    for (const auto& lv : levels) {
+        // Whole blocks only: intensity_kernel() ignores a partial tail block.
+        const std::size_t block = static_cast<std::size_t>(kIntensityChains) * PeakWide::lanes;
+        const std::size_t n = bytes_to_elems(lv.working_set) / block * block;
+        if (n < block * static_cast<std::size_t>(threads)) continue;
+
+        benchmark::AlignedBuffer<double> x;
+        try {
+            x = benchmark::AlignedBuffer<double>(n, 64);
+        } catch (const std::bad_alloc&) {
+            std::cerr << "Warning: roofline skipping " << lv.name << " (allocation of "
+                      << lv.working_set << " bytes failed)\n";
+            continue;
+        }
+        double* const xp = x.data();
+        // First touch from the threads that will stream it.
+        #pragma omp parallel for schedule(static) num_threads(threads)
+        for (long long i = 0; i < static_cast<long long>(n); ++i) xp[i] = 1.0 + 1e-9 * static_cast<double>(i & 1023);
+
+        const int passes = static_cast<int>(std::max<std::uint64_t>(1, min_traffic / (n * sizeof(double))));
+        const double bytes_per_iter = static_cast<double>(n) * sizeof(double) * passes;
+
+        for (const auto& step : ladder) {
+            for (int w = 0; w < conf.warmup; ++w) {
+                const double chk = intensity_kernel<PeakWide>(xp, n, step.fmas, passes, threads);
+                do_not_optimize_away(chk);
+            }
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            double checksum = 0.0;
+            for (int it = 0; it < conf.iters; ++it) {
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                checksum = intensity_kernel<PeakWide>(xp, n, step.fmas, passes, threads);
+
+                clobber_memory();
+                samples.push_back(t.elapsed_ns());
+                do_not_optimize_away(checksum);
+            }
+
+            BenchmarkResult::Point pt;
+            std::ostringstream name;
+            name << "roofline_" << lv.name << "_ai" << step.ai;
+            pt.kernel = name.str();
+            pt.bytes = n * sizeof(double);
+            BenchmarkResult::fill_timing(pt, samples);
+            pt.checksum = checksum;
+
+            const double flops = static_cast<double>(n) * intensity_flops_per_elem(step) * passes;
+            const double gflops = (pt.median_ns > 0.0) ? flops / pt.median_ns : 0.0;
+            pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? bytes_per_iter / pt.median_ns : 0.0;
+            pt.extra["ai_flops_per_byte"] = step.ai;
+            pt.extra["gflops"] = gflops;
+            pt.extra["passes"] = passes;
+
+            ladder_points.push_back({lv.name, step.ai, gflops, pt.bandwidth_gb_s, res.sweep_points.size()});
+            res.sweep_points.push_back(std::move(pt));
+
+            if (step.fmas < 0) {
+                bw[lv.name] = std::max(bw[lv.name], ladder_points.back().gb_s);
+            }
+        }
+    }
+
+    // ---- Model ----
+    for (const auto& lv : levels) {
+        const double b = bw[lv.name];
+        roof["levels"][lv.name]["working_set_bytes"] = lv.working_set;
+        roof["levels"][lv.name]["bandwidth_gb_s"] = b;
+        roof["levels"][lv.name]["ridge_point_flops_per_byte"] = (b > 0.0) ? peak_gflops / b : 0.0;
+    }
+
+    json pts = json::array();
+    for (const auto& lp : ladder_points) {
+        const double mem_bound = lp.ai * bw[lp.level];
+        const double bound = (peak_gflops > 0.0) ? std::min(peak_gflops, mem_bound) : mem_bound;
+        auto& pt = res.sweep_points[lp.index];
+        pt.extra["bound_gflops"] = bound;
+        pt.extra["fraction_of_bound"] = (bound > 0.0) ? lp.gflops / bound : 0.0;
+
+        json p;
+        p["level"] = lp.level;
+        p["ai_flops_per_byte"] = lp.ai;
+        p["attained_gflops"] = lp.gflops;
+        p["attained_gb_s"] = lp.gb_s;
+        p["bound_gflops"] = bound;
+        p["bound_by"] = (mem_bound < peak_gflops) ? "memory" : "compute";
+        p["fraction_of_bound"] = (bound > 0.0) ? lp.gflops / bound : 0.0;
+        pts.push_back(p);
+
+        std::cout << "[Roofline] " << lp.level << " ai=" << lp.ai << " gflops=" << lp.gflops
+                  << " bound=" << bound << "\n";
+    }
+    roof["points"] = pts;
+
+    res.gflops = peak_gflops;
+}
+
+/**
+ * @brief Dense GEMM runner for --kernel gemm.
+ *
+ * Three implementations of C += A x B (square, row-major, fp64):
+ *
+ * - naive  : i-j-k triple loop (only up to n = 512; it is 10-100x slower)
+ * - blocked: loop-tiled i-k-j, tile sizes from SystemInfo cache sizes
+ * - packed : BLIS-style packed panels + MR x NR register-tiled micro-kernel
+ *            on the widest enabled ISA (PeakWide)
+ *
+ * Sizes n = 64, 128, ... while the three matrices fit --size (max 4096);
+ * thread counts 1, 2, 4, ... up to --threads. Every point reports GFLOP/s
+ * (2 n^3 per call) and fraction_of_peak against SystemInfo's fp64 peak for
+ * that thread count. Each variant is checked once per size against a
+ * long-double reference on sampled elements (max_rel_error).
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate (res.gflops = best packed point).
+ */
+void run_gemm_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    constexpr std::size_t kNaiveMaxN = 512;
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 64; n <= 4096 && 3 * n * n * sizeof(double) <= size_bytes; n *= 2) sizes.push_back(n);
+    if (sizes.empty()) {
+        std::cerr << "Error: --size too small for gemm (need at least " << 3 * 64 * 64 * sizeof(double)
+                  << " bytes)\n";
+        return;
+    }
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    GemmBlocking bl;
+    GemmPacking pk;
+    gemm_blocking_from_caches(sys, bl, pk);
+    constexpr std::size_t NR = GemmTile<PeakWide>::NR;
+
+    const std::size_t nmax = sizes.back();
+    const std::size_t alignment = 64;
+    benchmark::AlignedBuffer<double> a(nmax * nmax, alignment), b(nmax * nmax, alignment), c(nmax * nmax, alignment);
+    benchmark::AlignedBuffer<double> apack(static_cast<std::size_t>(conf.threads) * pk.mc * pk.kc, alignment);
+    benchmark::AlignedBuffer<double> bpack(pk.kc * ((pk.nc + NR - 1) / NR) * NR, alignment);
+
+    std::mt19937_64 rng(conf.seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (std::size_t i = 0; i < nmax * nmax; ++i) {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+        c[i] = 0.0;
+    }
+
+    struct GemmVariant {
+        const char* name;
+        bool (*applies)(std::size_t);
+    };
+    const GemmVariant variants[] = {
+        {"naive", [](std::size_t n) { return n <= kNaiveMaxN; }},
+        {"blocked", [](std::size_t) { return true; }},
+        {"packed", [](std::size_t) { return true; }},
+    };
+    auto call = [&](const std::string& v, std::size_t n, int threads) {
+        if (v == "naive") {
+            gemm_naive(a.data(), b.data(), c.data(), n, n, n, threads);
+        } else if (v == "blocked") {
+            gemm_blocked(a.data(), b.data(), c.data(), n, n, n, bl, threads);
+        } else {
+            gemm_packed<PeakWide>(a.data(), b.data(), c.data(), n, n, n, pk, apack.data(), bpack.data(), threads);
+        }
+    };
+
+    json& gemm = res.extra_stats["gemm"];
+    json best = json::object();
+    double best_packed = 0.0;
+
+    for (const std::size_t n : sizes) {
+        // The matrices are used as n x n with leading dimension n (the
+        // leading n*n elements of each buffer).
+        const double flops = 2.0 * static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(n);
+
+        for (const auto& v : variants) {
+            if (!v.applies(n)) continue;
+
+            // Correctness, once per size: C = A x B from zero, sampled rows/columns.
+            std::fill(c.data(), c.data() + n * n, 0.0);
+            call(v.name, n, conf.threads);
+            double max_rel_error = 0.0;
+            const std::size_t step = std::max<std::size_t>(1, n / 16);
+            for (std::size_t i = 0; i < n; i += step) {
+                for (std::size_t j = (i / step) % 7; j < n; j += step) {
+                    long double ref = 0.0L, mag = 0.0L;
+                    for (std::size_t p = 0; p < n; ++p) {
+                        const long double t = static_cast<long double>(a[i * n + p]) * b[p * n + j];
+                        ref += t;
+                        mag += std::fabs(t);
+                    }
+                    const double err = static_cast<double>(std::fabs(c[i * n + j] - ref) / (mag > 0 ? mag : 1.0L));
+                    max_rel_error = std::max(max_rel_error, err);
+                }
+            }
+            if (max_rel_error > 1e-12) {
+                std::cerr << "CRITICAL: gemm_" << v.name << " n=" << n << " max_rel_error=" << max_rel_error << "\n";
+            }
+
+            for (const int threads : thread_counts) {
+                for (int w = 0; w < conf.warmup; ++w) call(v.name, n, threads);
+
+                std::vector<long long> samples;
+                samples.reserve(conf.iters);
+                for (int it = 0; it < conf.iters; ++it) {
+                    Timer t;
+                    clobber_memory();
+                    t.start();
+
+                    call(v.name, n, threads);
+
+                    clobber_memory();
+                    samples.push_back(t.elapsed_ns());
+                }
+
+                BenchmarkResult::Point pt;
+                pt.kernel = std::string("gemm_") + v.name;
+                pt.bytes = n * n * sizeof(double); // one matrix
+                BenchmarkResult::fill_timing(pt, samples);
+                pt.checksum = checksum_sampled_ptr(c.data(), n * n, std::max<std::size_t>(1, n * n / 1024));
+
+                const double gflops = (pt.median_ns > 0.0) ? flops / pt.median_ns : 0.0;
+                const double peak = sys.peak_gflops_fp64_per_core * threads;
+                pt.extra["n"] = static_cast<double>(n);
+                pt.extra["threads"] = threads;
+                pt.extra["gflops"] = gflops;
+                pt.extra["max_rel_error"] = max_rel_error;
+                if (peak > 0.0) pt.extra["fraction_of_peak"] = gflops / peak;
+
+                std::cout << "[GEMM] " << v.name << " n=" << n << " threads=" << threads << " gflops=" << gflops;
+                if (peak > 0.0) std::cout << " fraction_of_peak=" << gflops / peak;
+                std::cout << "\n";
+
+                json& row = best[v.name];
+                if (!row.contains("gflops") || gflops > row["gflops"].get<double>()) {
+                    row["gflops"] = gflops;
+                    row["n"] = n;
+                    row["threads"] = threads;
+                    if (peak > 0.0) row["fraction_of_peak"] = gflops / peak;
+                }
+                if (std::string(v.name) == "packed") best_packed = std::max(best_packed, gflops);
+                res.sweep_points.push_back(std::move(pt));
+            }
+        }
+    }
+
+    gemm["best"] = best;
+    gemm["isa"] = PeakWide::name;
+    gemm["micro_tile"] = {{"mr", GemmTile<PeakWide>::MR}, {"nr", GemmTile<PeakWide>::NR}};
+    gemm["packed_blocking"] = {{"mc", pk.mc}, {"kc", pk.kc}, {"nc", pk.nc}};
+    gemm["blocked_tiles"] = {{"ib", bl.ib}, {"kb", bl.kb}, {"jb", bl.jb}};
+    gemm["naive_max_n"] = kNaiveMaxN;
+    gemm["peak_gflops_per_core"] = sys.peak_gflops_fp64_per_core;
+
+    res.gflops = best_packed;
+}
+
+/**
+ * @brief BLAS-2 bandwidth runner for --kernel gemv.
+ *
+ * One fp64 matrix of --size bytes, m = 2n rows x n columns (tall, so the
+ * four layout/transpose combinations have distinct shapes):
+ *
+ * - gemv_{row,col}major_{n,t}: y = A x / y = A^T x, dot or axpy form
+ *   depending on storage order (see gemv_dot_form / gemv_axpy_form)
+ * - ger: row-major rank-1 update A += alpha x y^T (matrix read + written)
+ * - gemv_multi4 / gemv_multi8: row-major A times 4 / 8 right-hand sides
+ *
+ * GB/s counts the compulsory traffic (matrix once, or twice for ger, plus
+ * the vectors). Every point is compared with STREAM Triad measured in the
+ * same run at the closest footprint (fraction_of_triad); the multi-RHS rows
+ * also report speedup_vs_single against R separate row-major GEMVs.
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_gemv_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+    // m = 2n, m*n doubles = size -> n = sqrt(size / 16), whole cache lines per row.
+    const std::size_t n = static_cast<std::size_t>(std::sqrt(static_cast<double>(size_bytes) / 16.0)) / 8 * 8;
+    const std::size_t m = 2 * n;
+    if (n < 8) {
+        std::cerr << "Error: --size too small for gemv (" << size_bytes << " bytes)\n";
+        return;
+    }
+    const int threads = conf.threads;
+
+    // ---- Triad reference, same process ----
+    Config calib = conf;
+    calib.iters = std::min(conf.iters, 10);
+    calib.warmup = std::min(conf.warmup, 2);
+    BenchmarkResult triad_res;
+    {
+        const ScopedOmpThreads team(threads); // stream kernels use the default team size
+        run_stream_sweep(calib, triad_res, StreamOp::Triad);
+    }
+
+    /// Triad bandwidth at the footprint closest (log scale) to `bytes`.
+    auto triad_at = [&](double bytes) {
+        double best_gb_s = 0.0, best_dist = 0.0;
+        bool found = false;
+        for (const auto& pt : triad_res.sweep_points) {
+            const double footprint = 3.0 * static_cast<double>(pt.bytes);
+            const double dist = std::fabs(std::log(footprint / bytes));
+            if (!found || dist < best_dist) {
+                best_gb_s = pt.bandwidth_gb_s;
+                best_dist = dist;
+                found = true;
+            }
+        }
+        return best_gb_s;
+    };
+
+    constexpr int kMaxRhs = 8;
+    const std::size_t alignment = 64;
+    benchmark::AlignedBuffer<double> a(m * n, alignment);
+    benchmark::AlignedBuffer<double> x(kMaxRhs * m, alignment), y(kMaxRhs * m, alignment);
+
+    std::mt19937_64 rng(conf.seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> av(m * n);
+    for (auto& v : av) v = dist(rng);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(m * n); ++i) a[i] = av[i];
+    for (std::size_t i = 0; i < kMaxRhs * m; ++i) {
+        x[i] = dist(rng);
+        y[i] = 0.0;
+    }
+
+    json& gemv = res.extra_stats["gemv"];
+    gemv["rows"] = m;
+    gemv["cols"] = n;
+    gemv["threads"] = threads;
+
+    const double mat_bytes = static_cast<double>(m * n * sizeof(double));
+    std::map<std::string, double> median_ns;
+
+    auto run_point = [&](const std::string& name, double bytes, double flops, const std::function<void()>& body) {
+        for (int w = 0; w < conf.warmup; ++w) body();
+
+        std::vector<long long> samples;
+        samples.reserve(conf.iters);
+        for (int it = 0; it < conf.iters; ++it) {
+            Timer t;
+            clobber_memory();
+            t.start();
+
+            body();
+
+            clobber_memory();
+            samples.push_back(t.elapsed_ns());
+        }
+
+        BenchmarkResult::Point pt;
+        pt.kernel = name;
+        pt.bytes = m * n * sizeof(double);
+        BenchmarkResult::fill_timing(pt, samples);
+        pt.checksum = checksum_sampled_ptr(y.data(), kMaxRhs * m, std::max<std::size_t>(1, m / 64));
+
+        const double triad = triad_at(mat_bytes);
+        pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? bytes / pt.median_ns : 0.0;
+        pt.extra["gflops"] = (pt.median_ns > 0.0) ? flops / pt.median_ns : 0.0;
+        pt.extra["threads"] = threads;
+        pt.extra["triad_gb_s"] = triad;
+        if (triad > 0.0) pt.extra["fraction_of_triad"] = pt.bandwidth_gb_s / triad;
+        median_ns[name] = pt.median_ns;
+
+        json& row = gemv["variants"][name];
+        row["gb_s"] = pt.bandwidth_gb_s;
+        row["gflops"] = pt.extra["gflops"];
+        if (triad > 0.0) row["fraction_of_triad"] = pt.bandwidth_gb_s / triad;
+
+        std::cout << "[GEMV] " << name << " GB/s=" << pt.bandwidth_gb_s;
+        if (triad > 0.0) std::cout << " fraction_of_triad=" << pt.bandwidth_gb_s / triad;
+        std::cout << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    };
+
+    // Sampled check of a dot- or axpy-form result against a serial loop.
+    auto check = [&](const std::string& name, bool dot_form, std::size_t rows, std::size_t cols) {
+        const std::size_t outs = dot_form ? rows : cols;
+        const std::size_t inner = dot_form ? cols : rows;
+        double max_rel = 0.0;
+        for (std::size_t o = 0; o < outs; o += std::max<std::size_t>(1, outs / 32)) {
+            double ref = 0.0, mag = 0.0;
+            for (std::size_t i = 0; i < inner; ++i) {
+                const double t = (dot_form ? a[o * cols + i] : a[i * cols + o]) * x[i];
+                ref += t;
+                mag += std::fabs(t);
+            }
+            max_rel = std::max(max_rel, std::fabs(y[o] - ref) / (mag > 0.0 ? mag : 1.0));
+        }
+        if (max_rel > 1e-12) std::cerr << "CRITICAL: " << name << " validation failed (rel " << max_rel << ")\n";
+    };
+
+    const double flops1 = 2.0 * static_cast<double>(m) * static_cast<double>(n);
+
+    // Row-major m x n: rows = m, cols = n. Column-major m x n: stored as n rows of m.
+    struct Layout {
+        const char* name;
+        bool dot_form;
+        std::size_t rows, cols;
+    };
+    const Layout layouts[] = {
+        {"gemv_rowmajor_n", true, m, n},
+        {"gemv_rowmajor_t", false, m, n},
+        {"gemv_colmajor_n", false, n, m},
+        {"gemv_colmajor_t", true, n, m},
+    };
+    for (const auto& l : layouts) {
+        auto body = [&] {
+            if (l.dot_form) {
+                gemv_dot_form(a.data(), l.rows, l.cols, x.data(), y.data(), threads);
+            } else {
+                gemv_axpy_form(a.data(), l.rows, l.cols, x.data(), y.data(), threads);
+            }
+        };
+        body();
+        check(l.name, l.dot_form, l.rows, l.cols);
+        const double vec_bytes = static_cast<double>((l.rows + l.cols) * sizeof(double));
+        run_point(l.name, mat_bytes + vec_bytes, flops1, body);
+    }
+
+    // GER: matrix read and written once. alpha is tiny so A stays O(1)
+    // over any number of iterations.
+    {
+        const double alpha = 1e-9;
+        const double old = a[(m / 2) * n + n / 3];
+        ger_rank1(a.data(), m, n, alpha, x.data(), x.data() + m, threads);
+        const double want = old + alpha * x[m / 2] * x[m + n / 3];
+        if (std::fabs(a[(m / 2) * n + n / 3] - want) > 1e-15) {
+            std::cerr << "CRITICAL: ger validation failed\n";
+        }
+        run_point("ger", 2.0 * mat_bytes + static_cast<double>((m + n) * sizeof(double)), flops1,
+                  [&] { ger_rank1(a.data(), m, n, alpha, x.data(), x.data() + m, threads); });
+    }
+
+    // Multi-RHS, row-major A x X with X = R vectors of n.
+    auto multi = [&](auto rhs_tag) {
+        constexpr int R = decltype(rhs_tag)::value;
+        const std::string name = "gemv_multi" + std::to_string(R);
+        auto body = [&] { gemv_multi_rhs<R>(a.data(), m, n, x.data(), y.data(), threads); };
+        body();
+        check(name, true, m, n); // first right-hand side
+        run_point(name, mat_bytes + static_cast<double>(R * (m + n) * sizeof(double)), R * flops1, body);
+
+        const double single = median_ns["gemv_rowmajor_n"];
+        const double multi_ns = median_ns[name];
+        if (multi_ns > 0.0) {
+            const double speedup = R * single / multi_ns;
+            res.sweep_points.back().extra["speedup_vs_single"] = speedup;
+            gemv["variants"][name]["speedup_vs_single"] = speedup;
+        }
+    };
+    multi(std::integral_constant<int, 4>{});
+    multi(std::integral_constant<int, 8>{});
+
+    gemv["triad_gb_s"] = triad_at(mat_bytes);
+}
+
 /**
  * @brief Compute microbenchmark runner for --kernel flops / fma.
  *
@@ -208,12 +1791,13 @@ void run_compute_bench(const Config& conf, BenchmarkResult& res, const std::stri
         return;
     }
 
-    // Inner work per element (for flops/fma). Keep it fixed so comparisons stay stable.
+    // Inner work per element (for flops/fma), --inner (default 64).
     // Intentionally moderate to avoid very long runs on huge sizes.
-    const int inner = 64;
+    const int inner = conf.inner;
 
     const bool use_aligned = conf.aligned;
     const std::size_t alignment = 64;
+    const int team_threads = default_team_size(); // these kernels follow OMP_NUM_THREADS
 
     // Allocate inputs based on kernel kind.
     std::vector<double> a;
@@ -337,12 +1921,12 @@ void run_compute_bench(const Config& conf, BenchmarkResult& res, const std::stri
             return checksum_sampled_ptr(a_ptr, n, stride);
         }
         if (kind == "dot") {
-            return compute_dot_kernel(x_ptr, y_ptr, n);
+            return compute_dot_kernel(x_ptr, y_ptr, n, team_threads);
         }
 
         // saxpy
         const double a_coeff = 3.0;
-        compute_saxpy_kernel(a_coeff, x_ptr, y_ptr, out_ptr, n);
+        compute_saxpy_kernel(a_coeff, x_ptr, y_ptr, out_ptr, n, team_threads);
         const std::size_t stride = std::max<std::size_t>(1, n / 1024);
         return checksum_sampled_ptr(out_ptr, n, stride);
     };
@@ -421,15 +2005,39 @@ void run_compute_bench(const Config& conf, BenchmarkResult& res, const std::stri
     pt.min_ns = static_cast<double>(min_sample);
     pt.max_ns = static_cast<double>(max_sample);
     pt.stddev_ns = stddev;
-    pt.bandwidth_gb_s = 0.0;
+    // dot streams x and y (16 bytes per element); other kinds report GFLOP/s only.
+    pt.bandwidth_gb_s = (kind == "dot" && med > 0.0) ? 16.0 * static_cast<double>(n) / med : 0.0;
     pt.checksum = checksum;
 
+    // Efficiency against the machine's fp64 peak for the team that ran
+    // (flops/fma with --aligned run a serial loop).
+    const bool serial = use_aligned && (kind == "flops" || kind == "fma");
+    const int team = serial ? 1 : team_threads;
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const double peak_gflops = sys.peak_gflops_fp64_per_core * team;
+    const double efficiency = (peak_gflops > 0.0) ? gflops / peak_gflops : 0.0;
+    pt.extra["gflops"] = gflops;
+    pt.extra["peak_gflops"] = peak_gflops;
+    pt.extra["efficiency"] = efficiency;
+    pt.extra["threads"] = team;
+
     res.sweep_points.push_back(pt);
 
     res.gflops = gflops;
     res.avg_ns = med;
     res.total_ns = 0;
 
+    json& eff = res.extra_stats["efficiency"];
+    eff["gflops"] = gflops;
+    eff["peak_gflops"] = peak_gflops;
+    eff["efficiency"] = efficiency;
+    eff["threads"] = team;
+
     std::cout << "[Compute] kind=" << kind << " size=" << size_bytes << " bytes"
-              << " median_ns=" << med << " gflops=" << gflops << "\n";
+              << " median_ns=" << med << " gflops=" << gflops
+              << " efficiency=" << efficiency << "\n";
+
+    if (kind == "dot") {
+        run_dot_variants(conf, res, x_ptr, y_ptr, n, gflops);
+    }
 }
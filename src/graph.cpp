@@ -0,0 +1,105 @@
+#include "graph.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+
+namespace benchmark {
+
+namespace {
+
+constexpr double kA = 0.57, kB = 0.19, kC = 0.19; // Graph500 initiator, D = 1 - A - B - C
+constexpr std::size_t kEdgeBlock = 4096;          // edges per independently seeded RNG stream
+
+/// One R-MAT edge: descend `scale` levels of the adjacency matrix, picking a quadrant per level.
+std::pair<std::uint32_t, std::uint32_t> rmat_edge(int scale, std::mt19937_64& rng,
+                                                  std::uniform_real_distribution<double>& u01) {
+    std::uint32_t src = 0, dst = 0;
+    for (int level = 0; level < scale; ++level) {
+        const double r = u01(rng);
+        const std::uint32_t bit = 1u << level;
+        if (r < kA) continue;
+        if (r < kA + kB) {
+            dst |= bit;
+        } else if (r < kA + kB + kC) {
+            src |= bit;
+        } else {
+            src |= bit;
+            dst |= bit;
+        }
+    }
+    return {src, dst};
+}
+
+} // namespace
+
+double kronecker_bytes_per_vertex(int edgefactor) {
+    return sizeof(std::int64_t) + 2.0 * edgefactor * sizeof(std::int32_t);
+}
+
+CsrGraph generate_kronecker(int scale, int edgefactor, std::uint64_t seed) {
+    const std::size_t n = std::size_t(1) << scale;
+    const std::size_t m = n * static_cast<std::size_t>(edgefactor);
+
+    // Random relabelling, so hubs are not clustered at low ids.
+    std::vector<std::uint32_t> perm(n);
+    std::iota(perm.begin(), perm.end(), 0u);
+    std::mt19937_64 perm_rng(seed);
+    std::shuffle(perm.begin(), perm.end(), perm_rng);
+
+    std::vector<std::uint32_t> src(m), dst(m);
+    const long long blocks = static_cast<long long>((m + kEdgeBlock - 1) / kEdgeBlock);
+    #pragma omp parallel for schedule(static)
+    for (long long b = 0; b < blocks; ++b) {
+        std::mt19937_64 rng(seed ^ (0x9E3779B97F4A7C15ull * static_cast<std::uint64_t>(b + 1)));
+        std::uniform_real_distribution<double> u01(0.0, 1.0);
+        const std::size_t end = std::min(m, static_cast<std::size_t>(b + 1) * kEdgeBlock);
+        for (std::size_t e = static_cast<std::size_t>(b) * kEdgeBlock; e < end; ++e) {
+            const auto uv = rmat_edge(scale, rng, u01);
+            src[e] = perm[uv.first];
+            dst[e] = perm[uv.second];
+        }
+    }
+
+    // Both directions of every non-loop edge, bucketed by source.
+    CsrGraph g;
+    g.vertices = n;
+    std::vector<std::int64_t> count(n + 1, 0);
+    for (std::size_t e = 0; e < m; ++e) {
+        if (src[e] == dst[e]) continue;
+        ++count[src[e] + 1];
+        ++count[dst[e] + 1];
+    }
+    std::partial_sum(count.begin(), count.end(), count.begin());
+    std::vector<std::int32_t> adj(static_cast<std::size_t>(count[n]));
+    std::vector<std::int64_t> cursor(count.begin(), count.end() - 1);
+    for (std::size_t e = 0; e < m; ++e) {
+        if (src[e] == dst[e]) continue;
+        adj[static_cast<std::size_t>(cursor[src[e]]++)] = static_cast<std::int32_t>(dst[e]);
+        adj[static_cast<std::size_t>(cursor[dst[e]]++)] = static_cast<std::int32_t>(src[e]);
+    }
+    src.clear();
+    src.shrink_to_fit();
+    dst.clear();
+    dst.shrink_to_fit();
+
+    // Sort and de-duplicate each list in place, then compact.
+    std::vector<std::int64_t> kept(n + 1, 0);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (long long v = 0; v < static_cast<long long>(n); ++v) {
+        const auto first = adj.begin() + count[v], last = adj.begin() + count[v + 1];
+        std::sort(first, last);
+        kept[v + 1] = std::unique(first, last) - first;
+    }
+    std::partial_sum(kept.begin(), kept.end(), kept.begin());
+    g.adj.resize(static_cast<std::size_t>(kept[n]));
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (long long v = 0; v < static_cast<long long>(n); ++v) {
+        std::copy(adj.begin() + count[v], adj.begin() + count[v] + (kept[v + 1] - kept[v]), g.adj.begin() + kept[v]);
+    }
+    g.row_ptr = std::move(kept);
+    return g;
+}
+
+} // namespace benchmark
@@ -0,0 +1,313 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Word = std::uint64_t;
+
+constexpr Word kPoly = 0x0000000000000007ull;            // HPCC RandomAccess LFSR polynomial
+constexpr std::int64_t kPeriod = 1317624576693539401ll;  // period of that LFSR
+constexpr std::size_t kBatch = 128;                      // look-ahead of the batched variants (HPCC allows up to 1024)
+constexpr std::size_t kMinUpdates = std::size_t(1) << 20; // floor on updates per call for cache-sized tables
+constexpr std::size_t kMaxUpdates = std::size_t(1) << 23; // cap on updates per call for DRAM-sized tables
+constexpr double kMaxErrorRate = 0.01;                   // HPCC tolerance for unsynchronized updates
+
+inline Word lfsr_next(Word r) {
+    return (r << 1) ^ (static_cast<std::int64_t>(r) < 0 ? kPoly : 0);
+}
+
+/**
+ * @brief HPCC_starts: the LFSR state at position n of the stream.
+ *
+ * Jumps ahead by repeated squaring of the shift matrix over GF(2), so each
+ * thread can start at its own offset and the union of all threads' updates
+ * is exactly the serial stream.
+ */
+Word lfsr_starts(std::int64_t n) {
+    n %= kPeriod;
+    if (n < 0) n += kPeriod;
+    if (n == 0) return 0x1;
+
+    Word m2[64];
+    Word temp = 0x1;
+    for (int i = 0; i < 64; ++i) {
+        m2[i] = temp;
+        temp = lfsr_next(lfsr_next(temp));
+    }
+
+    int i = 62;
+    while (i >= 0 && !((n >> i) & 1)) --i;
+
+    Word ran = 0x2;
+    while (i > 0) {
+        temp = 0;
+        for (int j = 0; j < 64; ++j) {
+            if ((ran >> j) & 1) temp ^= m2[j];
+        }
+        ran = temp;
+        --i;
+        if ((n >> i) & 1) ran = lfsr_next(ran);
+    }
+    return ran;
+}
+
+/// One contiguous slice of the update stream: the LFSR state before its first update and its length.
+struct Stream {
+    Word start;
+    std::size_t count;
+};
+
+/// Split `updates` updates from stream position `base` into `parts` slices.
+std::vector<Stream> split_stream(std::int64_t base, std::size_t updates, std::size_t parts) {
+    std::vector<Stream> plan(parts);
+    for (std::size_t k = 0; k < parts; ++k) {
+        const std::size_t begin = updates * k / parts;
+        const std::size_t end = updates * (k + 1) / parts;
+        plan[k] = {lfsr_starts(base + static_cast<std::int64_t>(begin)), end - begin};
+    }
+    return plan;
+}
+
+enum class Batch { Plain, Batched, Prefetch };
+
+template <bool Atomic>
+inline void xor_update(Word& slot, Word v) {
+    if constexpr (Atomic) {
+        #pragma omp atomic
+        slot ^= v;
+    } else {
+        slot ^= v;
+    }
+}
+
+/**
+ * @brief Apply one stream slice: T[ran & mask] ^= ran for each LFSR value.
+ *
+ * - Plain   : generate and update one value at a time
+ * - Batched : generate kBatch values, then apply them, so the updates of a
+ *             batch are independent of the LFSR chain
+ * - Prefetch: as Batched, with a write prefetch of every target issued
+ *             while the batch is generated
+ */
+template <bool Atomic, Batch B>
+void run_stream(Word* t, Word mask, Word ran, std::size_t count) {
+    if constexpr (B == Batch::Plain) {
+        for (std::size_t i = 0; i < count; ++i) {
+            ran = lfsr_next(ran);
+            xor_update<Atomic>(t[ran & mask], ran);
+        }
+    } else {
+        Word buf[kBatch];
+        for (std::size_t done = 0; done < count; done += kBatch) {
+            const std::size_t b = std::min(kBatch, count - done);
+            for (std::size_t j = 0; j < b; ++j) {
+                ran = lfsr_next(ran);
+                buf[j] = ran;
+                if constexpr (B == Batch::Prefetch) prefetch_write(&t[ran & mask]);
+            }
+            for (std::size_t j = 0; j < b; ++j) xor_update<Atomic>(t[buf[j] & mask], buf[j]);
+        }
+    }
+}
+
+using StreamFn = void (*)(Word*, Word, Word, std::size_t);
+
+StreamFn stream_fn(bool atomic, Batch b) {
+    switch (b) {
+        case Batch::Plain: return atomic ? run_stream<true, Batch::Plain> : run_stream<false, Batch::Plain>;
+        case Batch::Batched: return atomic ? run_stream<true, Batch::Batched> : run_stream<false, Batch::Batched>;
+        default: return atomic ? run_stream<true, Batch::Prefetch> : run_stream<false, Batch::Prefetch>;
+    }
+}
+
+/// Run every slice of `plan`; with `parallel`, slices are spread over `threads` OpenMP threads.
+void run_updates(StreamFn fn, Word* t, Word mask, const std::vector<Stream>& plan, int threads, bool parallel) {
+    if (!parallel) {
+        for (const Stream& s : plan) fn(t, mask, s.start, s.count);
+        return;
+    }
+    #pragma omp parallel num_threads(threads)
+    {
+        std::size_t tid, nt;
+        team_position(tid, nt);
+        for (std::size_t k = tid; k < plan.size(); k += nt) fn(t, mask, plan[k].start, plan[k].count);
+    }
+}
+
+struct Variant {
+    const char* mode;   // serial, unsync, atomic
+    const char* option; // plain, batched, prefetch
+    Batch batch;
+};
+
+const Variant kVariants[] = {
+    {"serial", "plain", Batch::Plain}, {"serial", "batched", Batch::Batched}, {"serial", "prefetch", Batch::Prefetch},
+    {"unsync", "plain", Batch::Plain}, {"unsync", "batched", Batch::Batched}, {"unsync", "prefetch", Batch::Prefetch},
+    {"atomic", "plain", Batch::Plain}, {"atomic", "batched", Batch::Batched}, {"atomic", "prefetch", Batch::Prefetch},
+};
+
+/**
+ * @brief All variants on one table of `words` 64-bit words.
+ *
+ * Validation follows HPCC: start from T[i] = i, apply the variant's
+ * updates once, replay the same stream serially (XOR undoes it) and count
+ * words that are not back to i. Serial and atomic variants must leave no
+ * errors; unsynchronized ones may lose up to 1% of the table to races.
+ */
+void run_gups_case(const Config& conf, BenchmarkResult& res, std::size_t words, std::int64_t base,
+                   const std::vector<int>& thread_counts, json& table) {
+    const std::size_t bytes = words * sizeof(Word);
+    const std::size_t updates = std::min(std::max(4 * words, kMinUpdates), kMaxUpdates);
+    const Word mask = words - 1;
+
+    benchmark::AlignedBuffer<Word> t(words, 64);
+    auto reset = [&] {
+        #pragma omp parallel for num_threads(conf.threads) schedule(static)
+        for (long long i = 0; i < static_cast<long long>(words); ++i) t[i] = static_cast<Word>(i);
+    };
+    reset();
+
+    const std::vector<Stream> reference = split_stream(base, updates, 1);
+
+    json& row = table["sizes"][std::to_string(bytes)];
+    row["words"] = words;
+    row["updates"] = updates;
+    double best_gups = 0.0;
+    for (const Variant& v : kVariants) {
+        const bool serial = std::string(v.mode) == "serial";
+        const StreamFn fn = stream_fn(std::string(v.mode) == "atomic", v.batch);
+        double base_rate = 0.0;
+        for (const int threads : thread_counts) {
+            if (serial && threads != 1) continue;
+            const std::string name = std::string("gups_") + v.mode + "_" + v.option;
+            const std::vector<Stream> plan = split_stream(base, updates, static_cast<std::size_t>(threads));
+
+            reset();
+            run_updates(fn, t.data(), mask, plan, threads, !serial);
+            run_updates(stream_fn(false, Batch::Plain), t.data(), mask, reference, 1, false);
+            std::size_t errors = 0;
+            #pragma omp parallel for num_threads(conf.threads) schedule(static) reduction(+ : errors)
+            for (long long i = 0; i < static_cast<long long>(words); ++i) errors += t[i] != static_cast<Word>(i);
+            const double error_rate = static_cast<double>(errors) / static_cast<double>(words);
+            const bool ok = std::string(v.mode) == "unsync" ? error_rate <= kMaxErrorRate : errors == 0;
+            if (!ok) {
+                std::cerr << "CRITICAL: Validation failed for " << name << " at bytes=" << bytes
+                          << " threads=" << threads << " (errors=" << errors << ")\n";
+            }
+
+            for (int w = 0; w < conf.warmup; ++w) run_updates(fn, t.data(), mask, plan, threads, !serial);
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            for (int it = 0; it < conf.iters; ++it) {
+                Timer timer;
+                clobber_memory();
+                timer.start();
+
+                run_updates(fn, t.data(), mask, plan, threads, !serial);
+
+                clobber_memory();
+                samples.push_back(timer.elapsed_ns());
+            }
+            do_not_optimize_away(t[0]);
+
+            BenchmarkResult::Point pt;
+            pt.kernel = name;
+            pt.bytes = bytes;
+            BenchmarkResult::fill_timing(pt, samples);
+            pt.checksum = static_cast<double>(t[0] ^ t[words - 1]);
+
+            pt.ops_per_sec = (pt.median_ns > 0.0) ? static_cast<double>(updates) * 1e9 / pt.median_ns : 0.0;
+            const double gups = pt.ops_per_sec / 1e9;
+            if (base_rate == 0.0) base_rate = pt.ops_per_sec;
+            pt.extra["gups"] = gups;
+            pt.extra["threads"] = threads;
+            pt.extra["updates"] = static_cast<double>(updates);
+            pt.extra["error_rate"] = error_rate;
+            if (base_rate > 0.0) pt.extra["speedup"] = pt.ops_per_sec / base_rate;
+            if (ok && gups > best_gups) {
+                best_gups = gups;
+                row["best"] = {{"mode", v.mode}, {"option", v.option}, {"threads", threads}, {"gups", gups}};
+            }
+
+            json& cell = row[v.mode][v.option][std::to_string(threads)];
+            cell["gups"] = gups;
+            cell["error_rate"] = error_rate;
+            cell["valid"] = ok;
+
+            std::cout << "[GUPS] " << v.mode << " " << v.option << " bytes=" << bytes << " threads=" << threads
+                      << " GUP/s=" << gups << " errors=" << errors << "\n";
+            res.sweep_points.push_back(std::move(pt));
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief HPCC RandomAccess (GUPS) runner for --kernel gups.
+ *
+ * XOR-updates a table of 2^k 64-bit words at addresses taken from the
+ * HPCC LFSR stream (x^63 + x^2 + x + 1): T[ran & (size - 1)] ^= ran.
+ * Tables start at the L1 size and grow x4 up to --size, capped at half of
+ * RAM as in HPCC; pass a large --size to reach DRAM. Each timed call
+ * applies 4 x table-size updates, clamped to [2^20, 2^23].
+ *
+ * Variants: serial (one thread), unsync (threads race on plain XORs,
+ * HPCC's <= 1% lost-update rule applies) and atomic (omp atomic XOR) on
+ * 1, 2, 4 .. --threads threads; each as plain, batched (128-update
+ * look-ahead) and batched + write prefetch. Points report updates/s
+ * (ops_per_sec) and GUP/s; per-size results and the fastest valid
+ * variant are in stats.gups.
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_gups_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const std::size_t l1 = sys.cache_l1_bytes ? static_cast<std::size_t>(sys.cache_l1_bytes) : 32 * 1024;
+    if (sys.ram_total_gib > 0) size_bytes = std::min<std::uint64_t>(size_bytes, sys.ram_total_gib << 29);
+
+    // Power-of-two word counts.
+    auto pow2_words = [](std::uint64_t bytes) {
+        std::size_t w = 1;
+        while (2 * w * sizeof(Word) <= bytes) w *= 2;
+        return w;
+    };
+    std::vector<std::size_t> word_counts;
+    for (std::size_t w = pow2_words(l1); w * sizeof(Word) <= size_bytes; w *= 4) word_counts.push_back(w);
+    if (word_counts.empty()) word_counts.push_back(pow2_words(std::max<std::uint64_t>(size_bytes, sizeof(Word))));
+
+    const std::int64_t base = static_cast<std::int64_t>((static_cast<std::uint64_t>(conf.seed) << 32) %
+                                                        static_cast<std::uint64_t>(kPeriod));
+
+    json& table = res.extra_stats["gups"];
+    table["threads"] = thread_counts;
+    table["batch"] = kBatch;
+    table["max_error_rate"] = kMaxErrorRate;
+    for (const std::size_t words : word_counts) run_gups_case(conf, res, words, base, thread_counts, table);
+}
@@ -0,0 +1,237 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "hash_tables.hpp"
+#include "zipf.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace {
+
+constexpr double kZipfTheta = 0.99;               // YCSB default skew
+constexpr std::size_t kLookups = std::size_t(1) << 20; // lookups per timed call
+constexpr std::size_t kLoadNum = 7, kLoadDen = 8;  // 87.5% load, the Swiss-table maximum
+
+/**
+ * @brief Table keys and one query stream per (distribution, hit ratio).
+ *
+ * Stored keys come from counters [0, entries), misses from counters past
+ * that, so misses are never present. Hits pick a stored key uniformly or
+ * by Zipf rank; stored keys are random, so the hot keys land at random
+ * slots. Entry i stores value i, which gives the expected hit count and
+ * value sum for validation.
+ */
+struct Workload {
+    std::vector<std::uint64_t> keys;
+    struct Queries {
+        std::string dist;
+        int hit_pct = 100;
+        std::vector<std::uint64_t> q;
+        std::uint64_t hits = 0;
+        std::uint64_t value_sum = 0;
+    };
+    std::vector<Queries> sets;
+};
+
+Workload make_workload(std::size_t entries, std::uint64_t seed) {
+    Workload w;
+    std::uint64_t ctr = seed << 40;
+    auto next_key = [&ctr] {
+        std::uint64_t k;
+        do k = benchmark::splitmix64(ctr++);
+        while (k == 0); // 0 marks an empty slot
+        return k;
+    };
+    w.keys.resize(entries);
+    for (std::uint64_t& k : w.keys) k = next_key();
+    std::vector<std::uint64_t> misses(kLookups);
+    for (std::uint64_t& k : misses) k = next_key();
+
+    benchmark::ZipfDistribution zipf(entries, kZipfTheta);
+    for (const char* dist : {"uniform", "zipf"}) {
+        for (const int hit_pct : {100, 50, 0}) {
+            std::mt19937_64 rng(seed + static_cast<std::uint64_t>(hit_pct));
+            std::uniform_int_distribution<std::size_t> any_entry(0, entries - 1), any_miss(0, kLookups - 1);
+            std::uniform_int_distribution<int> pct(0, 99);
+            Workload::Queries s;
+            s.dist = dist;
+            s.hit_pct = hit_pct;
+            s.q.resize(kLookups);
+            for (std::uint64_t& q : s.q) {
+                if (pct(rng) < hit_pct) {
+                    const std::size_t e = std::string(dist) == "zipf" ? static_cast<std::size_t>(zipf(rng))
+                                                                      : any_entry(rng);
+                    q = w.keys[e];
+                    ++s.hits;
+                    s.value_sum += e;
+                } else {
+                    q = misses[any_miss(rng)];
+                }
+            }
+            w.sets.push_back(std::move(s));
+        }
+    }
+    return w;
+}
+
+template <class Table>
+void probe(const Table& t, const std::uint64_t* q, std::size_t n, int threads, std::uint64_t& hits,
+           std::uint64_t& value_sum) {
+    std::uint64_t h = 0, sum = 0;
+    #pragma omp parallel for num_threads(threads) schedule(static) reduction(+ : h, sum)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        std::uint64_t v;
+        if (t.find(q[i], v)) {
+            ++h;
+            sum += v;
+        }
+    }
+    hits = h;
+    value_sum = sum;
+}
+
+/**
+ * @brief Build one layout over the workload's keys and time every query
+ * stream over the thread sweep, validating hits and values first.
+ *
+ * A layout whose build fails (Robin Hood displacement overflow) is skipped
+ * with an error and recorded in row["skipped"]; the other layouts still run.
+ */
+template <class Table>
+void run_hash_layout(const Config& conf, BenchmarkResult& res, const char* layout, const Workload& w,
+                     std::size_t capacity, const std::vector<int>& thread_counts, json& row) {
+    Table table(capacity);
+    try {
+        for (std::size_t i = 0; i < w.keys.size(); ++i) table.insert(w.keys[i], i);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: hash " << layout << " at capacity=" << capacity << " skipped: " << e.what() << "\n";
+        row["skipped"][layout] = e.what();
+        return;
+    }
+
+    for (const Workload::Queries& s : w.sets) {
+        double base_rate = 0.0;
+        for (const int threads : thread_counts) {
+            const std::string name = std::string("hash_") + layout + "_" + s.dist + "_hit" + std::to_string(s.hit_pct);
+
+            std::uint64_t hits = 0, sum = 0;
+            probe(table, s.q.data(), s.q.size(), threads, hits, sum);
+            const bool ok = hits == s.hits && sum == s.value_sum;
+            if (!ok) {
+                std::cerr << "CRITICAL: Validation failed for " << name << " at capacity=" << capacity
+                          << " threads=" << threads << "\n";
+            }
+
+            for (int wu = 0; wu < conf.warmup; ++wu) probe(table, s.q.data(), s.q.size(), threads, hits, sum);
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            for (int it = 0; it < conf.iters; ++it) {
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                probe(table, s.q.data(), s.q.size(), threads, hits, sum);
+
+                clobber_memory();
+                samples.push_back(t.elapsed_ns());
+            }
+            do_not_optimize_away(sum);
+
+            BenchmarkResult::Point pt;
+            pt.kernel = name;
+            pt.bytes = table.bytes();
+            BenchmarkResult::fill_timing(pt, samples);
+            pt.checksum = static_cast<double>(sum);
+
+            pt.ops_per_sec = (pt.median_ns > 0.0) ? static_cast<double>(s.q.size()) * 1e9 / pt.median_ns : 0.0;
+            if (threads == thread_counts.front()) base_rate = pt.ops_per_sec;
+            pt.extra["capacity"] = static_cast<double>(capacity);
+            pt.extra["entries"] = static_cast<double>(w.keys.size());
+            pt.extra["hit_pct"] = s.hit_pct;
+            pt.extra["threads"] = threads;
+            pt.extra["lookups_per_sec_per_thread"] = pt.ops_per_sec / threads;
+            if (base_rate > 0.0) pt.extra["speedup"] = pt.ops_per_sec / base_rate;
+            if (s.dist == "zipf") pt.extra["zipf_theta"] = kZipfTheta;
+
+            json& cell = row[s.dist]["hit" + std::to_string(s.hit_pct)][layout][std::to_string(threads)];
+            cell["lookups_per_sec"] = pt.ops_per_sec;
+            cell["lookups_per_sec_per_thread"] = pt.ops_per_sec / threads;
+            cell["valid"] = ok;
+
+            std::cout << "[Hash] " << layout << " " << s.dist << " hit=" << s.hit_pct << "% bytes=" << table.bytes()
+                      << " threads=" << threads << " Mlookups/s=" << pt.ops_per_sec / 1e6 << "\n";
+            res.sweep_points.push_back(std::move(pt));
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Hash-table probe runner for --kernel hash.
+ *
+ * uint64 -> uint64 open-addressing tables at 87.5% load in three layouts:
+ * linear probing, Robin Hood and Swiss-table style 16-slot SIMD groups
+ * (include/hash_tables.hpp). Table sizes target half of L1, half of L2,
+ * half of the LLC and 4 x LLC (DRAM), rounded down to power-of-two slot
+ * counts. Each table answers 2^20 lookups per timed call from six
+ * streams: uniform or Zipf(0.99) over the stored keys, at 100%, 50% and
+ * 0% hits.
+ *
+ * Points report lookups/s (ops_per_sec), per thread and as speedup over
+ * one thread on 1, 2, 4 .. --threads threads; results are in stats.hash.
+ *
+ * @param conf The parsed configuration (threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_hash_bench(const Config& conf, BenchmarkResult& res) {
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const std::size_t l1 = sys.cache_l1_bytes ? static_cast<std::size_t>(sys.cache_l1_bytes) : 32 * 1024;
+    const std::size_t l2 = sys.cache_l2_bytes ? static_cast<std::size_t>(sys.cache_l2_bytes) : 1024 * 1024;
+    const std::size_t llc = sys.cache_llc_bytes ? static_cast<std::size_t>(sys.cache_llc_bytes) : 32 * 1024 * 1024;
+
+    // Power-of-two slot counts whose 16-byte slots fit the target.
+    auto slots_for = [](std::size_t bytes) {
+        std::size_t c = benchmark::SwissTable::kGroup;
+        while (2 * c * sizeof(benchmark::HashSlot) <= bytes) c *= 2;
+        return c;
+    };
+    std::vector<std::size_t> capacities = {slots_for(l1 / 2), slots_for(l2 / 2), slots_for(llc / 2),
+                                           slots_for(4 * llc)};
+    capacities.erase(std::unique(capacities.begin(), capacities.end()), capacities.end());
+
+    json& table = res.extra_stats["hash"];
+    table["threads"] = thread_counts;
+    table["load_factor"] = static_cast<double>(kLoadNum) / kLoadDen;
+    table["lookups_per_call"] = kLookups;
+    table["zipf_theta"] = kZipfTheta;
+    for (const std::size_t capacity : capacities) {
+        const std::size_t entries = capacity * kLoadNum / kLoadDen;
+        const Workload w = make_workload(entries, static_cast<std::uint64_t>(conf.seed));
+        json& row = table["sizes"][std::to_string(capacity)];
+        row["entries"] = entries;
+        row["slot_bytes"] = capacity * sizeof(benchmark::HashSlot);
+        run_hash_layout<benchmark::LinearProbeTable>(conf, res, "linear", w, capacity, thread_counts, row);
+        run_hash_layout<benchmark::RobinHoodTable>(conf, res, "robin_hood", w, capacity, thread_counts, row);
+        run_hash_layout<benchmark::SwissTable>(conf, res, "swiss", w, capacity, thread_counts, row);
+    }
+}
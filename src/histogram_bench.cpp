@@ -0,0 +1,310 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "zipf.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Bin = std::uint64_t;
+
+constexpr double kZipfTheta = 0.99;                        // YCSB default skew
+constexpr std::uint64_t kOddMix = 0x9E3779B97F4A7C15ull;   // odd: rank * kOddMix is a bijection mod 2^k
+constexpr std::size_t kPrivateLimitBytes = std::size_t(1) << 30; // cap on threads x private tables
+
+/**
+ * @brief Key streams over `bins` (a power of two) bins.
+ *
+ * - random : i.i.d. uniform bins
+ * - uniform: round-robin, key i hits bin i mod bins (every bin equally,
+ *            in address order)
+ * - zipf   : Zipf(0.99) ranks; ranks are scattered by an odd multiplier so
+ *            the hot bins do not share cache lines or partitions
+ */
+std::vector<std::uint32_t> make_keys(const std::string& dist, std::size_t n, std::size_t bins, std::uint64_t seed) {
+    std::vector<std::uint32_t> keys(n);
+    const std::uint64_t mask = bins - 1;
+    std::mt19937_64 rng(seed);
+    if (dist == "random") {
+        for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<std::uint32_t>(rng() & mask);
+    } else if (dist == "uniform") {
+        for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<std::uint32_t>(i & mask);
+    } else {
+        benchmark::ZipfDistribution zipf(bins, kZipfTheta);
+        for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<std::uint32_t>((zipf(rng) * kOddMix) & mask);
+    }
+    return keys;
+}
+
+// ---------- Shared table, atomic increments ----------
+
+void hist_atomic(const std::uint32_t* keys, std::size_t n, Bin* table, std::size_t bins, int threads) {
+    #pragma omp parallel num_threads(threads)
+    {
+        #pragma omp for schedule(static)
+        for (long long b = 0; b < static_cast<long long>(bins); ++b) table[b] = 0;
+        #pragma omp for schedule(static)
+        for (long long i = 0; i < static_cast<long long>(n); ++i) {
+            Bin& slot = table[keys[i]];
+            #pragma omp atomic
+            slot += 1;
+        }
+    }
+}
+
+// ---------- Per-thread private tables, then a merge ----------
+
+/// Each thread counts into its own copy (no sharing at all), then bins are summed across copies.
+void hist_private(const std::uint32_t* keys, std::size_t n, Bin* table, std::size_t bins, Bin* priv, int threads) {
+    #pragma omp parallel num_threads(threads)
+    {
+        std::size_t tid, nt;
+        team_position(tid, nt);
+        Bin* mine = priv + tid * bins;
+        std::fill(mine, mine + bins, Bin(0));
+        const std::size_t lo = n * tid / nt, hi = n * (tid + 1) / nt;
+        for (std::size_t i = lo; i < hi; ++i) ++mine[keys[i]];
+        #pragma omp barrier
+        #pragma omp for schedule(static)
+        for (long long b = 0; b < static_cast<long long>(bins); ++b) {
+            Bin s = 0;
+            for (std::size_t t = 0; t < nt; ++t) s += priv[t * bins + static_cast<std::size_t>(b)];
+            table[b] = s;
+        }
+    }
+}
+
+// ---------- Radix partition by high bin bits, then count without atomics ----------
+
+/**
+ * @brief Partition-then-count: keys are scattered into `parts` buckets by
+ * their high bits, then each bucket (a disjoint bin range) is counted by
+ * one thread.
+ *
+ * The scatter is a stable two-pass counting sort (per-thread bucket counts,
+ * prefix sum, scatter to `scratch`). Counting then touches only
+ * bins / parts bins at a time, so the random read-modify-writes stay in
+ * cache, at the cost of one extra sequential read and write of the keys.
+ * Skew shows up as load imbalance across buckets instead of contention.
+ */
+void hist_partitioned(const std::uint32_t* keys, std::size_t n, Bin* table, unsigned shift, std::size_t parts,
+                      std::uint32_t* scratch, std::size_t* offsets, int threads) {
+    #pragma omp parallel num_threads(threads)
+    {
+        std::size_t tid, nt;
+        team_position(tid, nt);
+        const std::size_t lo = n * tid / nt, hi = n * (tid + 1) / nt;
+        std::size_t* mine = offsets + tid * parts;
+        std::fill(mine, mine + parts, std::size_t(0));
+        for (std::size_t i = lo; i < hi; ++i) ++mine[keys[i] >> shift];
+        #pragma omp barrier
+        #pragma omp single
+        {
+            // Column-major exclusive scan: bucket p of thread t follows bucket p of thread t - 1.
+            std::size_t run = 0;
+            for (std::size_t p = 0; p < parts; ++p) {
+                for (std::size_t t = 0; t < nt; ++t) {
+                    const std::size_t c = offsets[t * parts + p];
+                    offsets[t * parts + p] = run;
+                    run += c;
+                }
+            }
+        }
+        for (std::size_t i = lo; i < hi; ++i) scratch[mine[keys[i] >> shift]++] = keys[i];
+        #pragma omp barrier
+        // After the scatter, thread t's cursor for bucket p is where thread t + 1's part of p
+        // starts; the last thread's cursor is the end of bucket p.
+        #pragma omp for schedule(dynamic, 1)
+        for (long long p = 0; p < static_cast<long long>(parts); ++p) {
+            const std::size_t pp = static_cast<std::size_t>(p);
+            const std::size_t b0 = pp << shift, b1 = (pp + 1) << shift;
+            std::fill(table + b0, table + b1, Bin(0));
+            const std::size_t begin = pp == 0 ? 0 : offsets[(nt - 1) * parts + pp - 1];
+            const std::size_t end = offsets[(nt - 1) * parts + pp];
+            for (std::size_t i = begin; i < end; ++i) ++table[scratch[i]];
+        }
+    }
+}
+
+/**
+ * @brief Time all three strategies for one key distribution and bin count
+ * over the thread sweep, validating each against a serial count first.
+ */
+void run_histogram_case(const Config& conf, BenchmarkResult& res, const std::string& dist, std::size_t bins,
+                        std::size_t n_keys, std::size_t l2_bytes, const std::vector<int>& thread_counts,
+                        json& table) {
+    const std::vector<std::uint32_t> keys = make_keys(dist, n_keys, bins, conf.seed);
+    std::vector<Bin> ref(bins, 0);
+    for (const std::uint32_t k : keys) ++ref[k];
+
+    const int max_threads = thread_counts.back();
+    const std::size_t table_bytes = bins * sizeof(Bin);
+    benchmark::AlignedBuffer<Bin> hist(bins, 64);
+
+    const bool private_ok = static_cast<std::size_t>(max_threads) * table_bytes <= kPrivateLimitBytes;
+    benchmark::AlignedBuffer<Bin> priv(private_ok ? static_cast<std::size_t>(max_threads) * bins : 1, 64);
+
+    // Buckets of at most half of L2 worth of bins, and at least 4 per thread for balance.
+    unsigned shift = 0;
+    while ((std::size_t(1) << shift) < bins && (std::size_t(1) << shift) * sizeof(Bin) < l2_bytes / 2) ++shift;
+    while (shift > 0 && (bins >> shift) < 4 * static_cast<std::size_t>(max_threads)) --shift;
+    const std::size_t parts = bins >> shift;
+    benchmark::AlignedBuffer<std::uint32_t> scratch(n_keys, 64);
+    std::vector<std::size_t> offsets(static_cast<std::size_t>(max_threads) * parts);
+
+    struct Variant {
+        const char* name;
+        std::function<void(int)> body;
+    };
+    std::vector<Variant> variants = {
+        {"atomic", [&](int th) { hist_atomic(keys.data(), n_keys, hist.data(), bins, th); }},
+    };
+    if (private_ok) {
+        variants.push_back(
+            {"private", [&](int th) { hist_private(keys.data(), n_keys, hist.data(), bins, priv.data(), th); }});
+    } else {
+        std::cout << "[Histogram] " << dist << " bins=" << bins << ": private skipped (" << max_threads
+                  << " copies exceed 1 GiB)\n";
+    }
+    variants.push_back({"partitioned", [&](int th) {
+                            hist_partitioned(keys.data(), n_keys, hist.data(), shift, parts, scratch.data(),
+                                             offsets.data(), th);
+                        }});
+
+    json& row = table[dist][std::to_string(bins)];
+    row["table_bytes"] = table_bytes;
+    row["partitions"] = parts;
+    double best_rate = 0.0;
+    std::string best;
+    for (const Variant& v : variants) {
+        for (const int threads : thread_counts) {
+            const std::string name = "histogram_" + dist + "_" + v.name;
+
+            v.body(threads);
+            const bool ok = std::equal(ref.begin(), ref.end(), hist.data());
+            if (!ok) {
+                std::cerr << "CRITICAL: Validation failed for " << name << " at bins=" << bins
+                          << " threads=" << threads << "\n";
+            }
+
+            for (int w = 0; w < conf.warmup; ++w) v.body(threads);
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            for (int it = 0; it < conf.iters; ++it) {
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                v.body(threads);
+
+                clobber_memory();
+                samples.push_back(t.elapsed_ns());
+            }
+
+            BenchmarkResult::Point pt;
+            pt.kernel = name;
+            pt.bytes = table_bytes; // the randomly updated working set
+            BenchmarkResult::fill_timing(pt, samples);
+            const std::size_t stride = std::max<std::size_t>(1, bins / 1024);
+            for (std::size_t b = 0; b < bins; b += stride) pt.checksum += static_cast<double>(hist[b]);
+
+            pt.ops_per_sec = (pt.median_ns > 0.0) ? static_cast<double>(n_keys) * 1e9 / pt.median_ns : 0.0;
+            pt.extra["bins"] = static_cast<double>(bins);
+            pt.extra["keys"] = static_cast<double>(n_keys);
+            pt.extra["threads"] = threads;
+            pt.extra["updates_per_sec_per_thread"] = pt.ops_per_sec / threads;
+            if (std::string(v.name) == "partitioned") pt.extra["partitions"] = static_cast<double>(parts);
+
+            json& cell = row[v.name][std::to_string(threads)];
+            cell["updates_per_sec"] = pt.ops_per_sec;
+            cell["valid"] = ok;
+            if (threads == max_threads && pt.ops_per_sec > best_rate) {
+                best_rate = pt.ops_per_sec;
+                best = v.name;
+            }
+
+            std::cout << "[Histogram] " << dist << " " << v.name << " bins=" << bins << " threads=" << threads
+                      << " Mupdates/s=" << pt.ops_per_sec / 1e6 << "\n";
+            res.sweep_points.push_back(std::move(pt));
+        }
+    }
+    row["best"] = best; // at --threads
+}
+
+} // namespace
+
+/**
+ * @brief Histogram runner for --kernel histogram.
+ *
+ * --size / 4 uint32 keys are counted into 64-bit bins. Bin tables span the
+ * hierarchy: 256 bins (heavy contention), half of L1, half of L2, half of
+ * the LLC and 4 x LLC (DRAM), all rounded down to powers of two. Keys are
+ * random, round-robin uniform or Zipf(0.99) (see make_keys).
+ *
+ * Strategies: one shared table with atomic increments; per-thread private
+ * tables merged at the end (skipped when the copies exceed 1 GiB); and
+ * radix partition by high bin bits followed by atomic-free counting of
+ * each L2-sized bin range. Each strategy runs on 1, 2, 4 .. --threads
+ * threads and reports updates/s (ops_per_sec); every timed call includes
+ * clearing its tables. The fastest strategy at --threads per distribution
+ * and bin count goes to stats.histogram.
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_histogram_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+    const std::size_t n_keys = static_cast<std::size_t>(size_bytes / sizeof(std::uint32_t));
+    if (n_keys == 0) {
+        std::cerr << "Error: --size too small for histogram keys\n";
+        return;
+    }
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const std::size_t l1 = sys.cache_l1_bytes ? static_cast<std::size_t>(sys.cache_l1_bytes) : 32 * 1024;
+    const std::size_t l2 = sys.cache_l2_bytes ? static_cast<std::size_t>(sys.cache_l2_bytes) : 1024 * 1024;
+    const std::size_t llc = sys.cache_llc_bytes ? static_cast<std::size_t>(sys.cache_llc_bytes) : 32 * 1024 * 1024;
+
+    auto pow2_bins = [](std::size_t bytes) {
+        std::size_t b = 1;
+        while (2 * b * sizeof(Bin) <= bytes) b *= 2;
+        return b;
+    };
+    std::vector<std::size_t> bin_counts = {256, pow2_bins(l1 / 2), pow2_bins(l2 / 2), pow2_bins(llc / 2),
+                                           pow2_bins(4 * llc)};
+    std::sort(bin_counts.begin(), bin_counts.end());
+    bin_counts.erase(std::unique(bin_counts.begin(), bin_counts.end()), bin_counts.end());
+
+    json& table = res.extra_stats["histogram"];
+    table["keys"] = n_keys;
+    table["threads"] = thread_counts;
+    table["zipf_theta"] = kZipfTheta;
+    for (const char* dist : {"random", "uniform", "zipf"}) {
+        for (const std::size_t bins : bin_counts) {
+            run_histogram_case(conf, res, dist, bins, n_keys, l2, thread_counts, table);
+        }
+    }
+}
@@ -0,0 +1,545 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "sys_info.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define BENCH_X86_SIMD 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define INSTR_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define INSTR_NOINLINE __declspec(noinline)
+#else
+#define INSTR_NOINLINE
+#endif
+
+namespace {
+
+/**
+ * @brief Keep a value in a register and hide it from the optimizer.
+ *
+ * Applied after every step of a chain. Under -ffast-math the compiler would
+ * otherwise fold `x + c + c + c` into `x + 3c` or hoist a loop-invariant
+ * `min(x, c)`. The asm emits no instruction, so the measured chain is
+ * exactly one instruction deep per step. (MSVC: no inline asm on x64, so
+ * its numbers are best-effort.)
+ */
+template <typename T>
+inline void opaque_reg(T& v) {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (std::is_integral<T>::value) {
+        asm volatile("" : "+r"(v));
+    } else {
+#if defined(__x86_64__) || defined(__i386__)
+        asm volatile("" : "+x"(v));
+#elif defined(__aarch64__)
+        asm volatile("" : "+w"(v));
+#else
+        asm volatile("" : "+m"(v));
+#endif
+    }
+#else
+    (void)v;
+#endif
+}
+
+// ---------- Operand types ----------
+//
+// Each trait bundles one register type with the operations the table covers.
+// `has_*` flags switch off rows the type (or the enabled ISA) cannot express.
+
+struct F64x1 {
+    using T = double;
+    static constexpr const char* name = "f64x1";
+    static constexpr int lanes = 1;
+    static constexpr bool is_float = true;
+#if defined(__FMA__) || defined(__aarch64__)
+    static constexpr bool has_fma = true;
+#else
+    static constexpr bool has_fma = false; // std::fma would be a libm call
+#endif
+    static T set1(double v) { return v; }
+    static T add(T a, T b) { return a + b; }
+    static T mul(T a, T b) { return a * b; }
+    static T fma(T a, T b, T c) { return std::fma(a, b, c); }
+    static T div(T a, T b) { return a / b; }
+    static T sqrt(T a) { return std::sqrt(a); }
+    static T min(T a, T b) { return std::min(a, b); }
+    static T max(T a, T b) { return std::max(a, b); }
+    static T cvt(T a) { return static_cast<double>(static_cast<std::int32_t>(a)); }
+    static double first(T a) { return a; }
+};
+
+struct F32x1 {
+    using T = float;
+    static constexpr const char* name = "f32x1";
+    static constexpr int lanes = 1;
+    static constexpr bool is_float = true;
+    static constexpr bool has_fma = F64x1::has_fma;
+    static T set1(double v) { return static_cast<float>(v); }
+    static T add(T a, T b) { return a + b; }
+    static T mul(T a, T b) { return a * b; }
+    static T fma(T a, T b, T c) { return std::fma(a, b, c); }
+    static T div(T a, T b) { return a / b; }
+    static T sqrt(T a) { return std::sqrt(a); }
+    static T min(T a, T b) { return std::min(a, b); }
+    static T max(T a, T b) { return std::max(a, b); }
+    static T cvt(T a) { return static_cast<float>(static_cast<std::int32_t>(a)); }
+    static double first(T a) { return a; }
+};
+
+#if defined(BENCH_X86_SIMD)
+
+struct F64x2 {
+    using T = __m128d;
+    static constexpr const char* name = "f64x2";
+    static constexpr int lanes = 2;
+    static constexpr bool is_float = true;
+#if defined(__FMA__)
+    static constexpr bool has_fma = true;
+    static T fma(T a, T b, T c) { return _mm_fmadd_pd(a, b, c); }
+#else
+    static constexpr bool has_fma = false;
+    static T fma(T a, T, T) { return a; }
+#endif
+    static T set1(double v) { return _mm_set1_pd(v); }
+    static T add(T a, T b) { return _mm_add_pd(a, b); }
+    static T mul(T a, T b) { return _mm_mul_pd(a, b); }
+    static T div(T a, T b) { return _mm_div_pd(a, b); }
+    static T sqrt(T a) { return _mm_sqrt_pd(a); }
+    static T min(T a, T b) { return _mm_min_pd(a, b); }
+    static T max(T a, T b) { return _mm_max_pd(a, b); }
+    static T cvt(T a) { return _mm_cvtepi32_pd(_mm_cvttpd_epi32(a)); }
+    static double first(T a) { return _mm_cvtsd_f64(a); }
+};
+
+struct F32x4 {
+    using T = __m128;
+    static constexpr const char* name = "f32x4";
+    static constexpr int lanes = 4;
+    static constexpr bool is_float = true;
+    static constexpr bool has_fma = F64x2::has_fma;
+#if defined(__FMA__)
+    static T fma(T a, T b, T c) { return _mm_fmadd_ps(a, b, c); }
+#else
+    static T fma(T a, T, T) { return a; }
+#endif
+    static T set1(double v) { return _mm_set1_ps(static_cast<float>(v)); }
+    static T add(T a, T b) { return _mm_add_ps(a, b); }
+    static T mul(T a, T b) { return _mm_mul_ps(a, b); }
+    static T div(T a, T b) { return _mm_div_ps(a, b); }
+    static T sqrt(T a) { return _mm_sqrt_ps(a); }
+    static T min(T a, T b) { return _mm_min_ps(a, b); }
+    static T max(T a, T b) { return _mm_max_ps(a, b); }
+    static T cvt(T a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+    static double first(T a) { return _mm_cvtss_f32(a); }
+};
+
+#endif // BENCH_X86_SIMD
+
+#if defined(__AVX__)
+
+struct F64x4 {
+    using T = __m256d;
+    static constexpr const char* name = "f64x4";
+    static constexpr int lanes = 4;
+    static constexpr bool is_float = true;
+    static constexpr bool has_fma = F64x2::has_fma;
+#if defined(__FMA__)
+    static T fma(T a, T b, T c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+    static T fma(T a, T, T) { return a; }
+#endif
+    static T set1(double v) { return _mm256_set1_pd(v); }
+    static T add(T a, T b) { return _mm256_add_pd(a, b); }
+    static T mul(T a, T b) { return _mm256_mul_pd(a, b); }
+    static T div(T a, T b) { return _mm256_div_pd(a, b); }
+    static T sqrt(T a) { return _mm256_sqrt_pd(a); }
+    static T min(T a, T b) { return _mm256_min_pd(a, b); }
+    static T max(T a, T b) { return _mm256_max_pd(a, b); }
+    static T cvt(T a) { return _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(a)); }
+    static double first(T a) { return _mm256_cvtsd_f64(a); }
+};
+
+struct F32x8 {
+    using T = __m256;
+    static constexpr const char* name = "f32x8";
+    static constexpr int lanes = 8;
+    static constexpr bool is_float = true;
+    static constexpr bool has_fma = F64x2::has_fma;
+#if defined(__FMA__)
+    static T fma(T a, T b, T c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+    static T fma(T a, T, T) { return a; }
+#endif
+    static T set1(double v) { return _mm256_set1_ps(static_cast<float>(v)); }
+    static T add(T a, T b) { return _mm256_add_ps(a, b); }
+    static T mul(T a, T b) { return _mm256_mul_ps(a, b); }
+    static T div(T a, T b) { return _mm256_div_ps(a, b); }
+    static T sqrt(T a) { return _mm256_sqrt_ps(a); }
+    static T min(T a, T b) { return _mm256_min_ps(a, b); }
+    static T max(T a, T b) { return _mm256_max_ps(a, b); }
+    static T cvt(T a) { return _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a)); }
+    static double first(T a) { return _mm256_cvtss_f32(a); }
+};
+
+#endif // __AVX__
+
+#if defined(__AVX512F__)
+
+struct F64x8 {
+    using T = __m512d;
+    static constexpr const char* name = "f64x8";
+    static constexpr int lanes = 8;
+    static constexpr bool is_float = true;
+    static constexpr bool has_fma = true;
+    static T set1(double v) { return _mm512_set1_pd(v); }
+    static T add(T a, T b) { return _mm512_add_pd(a, b); }
+    static T mul(T a, T b) { return _mm512_mul_pd(a, b); }
+    static T fma(T a, T b, T c) { return _mm512_fmadd_pd(a, b, c); }
+    static T div(T a, T b) { return _mm512_div_pd(a, b); }
+    static T sqrt(T a) { return _mm512_sqrt_pd(a); }
+    static T min(T a, T b) { return _mm512_min_pd(a, b); }
+    static T max(T a, T b) { return _mm512_max_pd(a, b); }
+    static T cvt(T a) { return _mm512_cvtepi32_pd(_mm512_cvttpd_epi32(a)); }
+    static double first(T a) { return _mm512_cvtsd_f64(a); }
+};
+
+struct F32x16 {
+    using T = __m512;
+    static constexpr const char* name = "f32x16";
+    static constexpr int lanes = 16;
+    static constexpr bool is_float = true;
+    static constexpr bool has_fma = true;
+    static T set1(double v) { return _mm512_set1_ps(static_cast<float>(v)); }
+    static T add(T a, T b) { return _mm512_add_ps(a, b); }
+    static T mul(T a, T b) { return _mm512_mul_ps(a, b); }
+    static T fma(T a, T b, T c) { return _mm512_fmadd_ps(a, b, c); }
+    static T div(T a, T b) { return _mm512_div_ps(a, b); }
+    static T sqrt(T a) { return _mm512_sqrt_ps(a); }
+    static T min(T a, T b) { return _mm512_min_ps(a, b); }
+    static T max(T a, T b) { return _mm512_max_ps(a, b); }
+    static T cvt(T a) { return _mm512_cvtepi32_ps(_mm512_cvttps_epi32(a)); }
+    static double first(T a) { return _mm512_cvtss_f32(a); }
+};
+
+#endif // __AVX512F__
+
+// Integer rows: add, mul, and scalar div (x86 has no SIMD integer divide).
+// Scalar rows are unsigned: the mul chain wraps, which is UB on signed types
+// and would let the compiler fold or reorder the chain being timed.
+
+struct I64x1 {
+    using T = std::uint64_t;
+    static constexpr const char* name = "i64x1";
+    static constexpr int lanes = 1;
+    static constexpr bool has_div = true;
+    static T set1(std::int64_t v) { return static_cast<T>(v); }
+    static T add(T a, T b) { return a + b; }
+    static T mul(T a, T b) { return a * b; }
+    static T div(T a, T b) { return a / b; }
+    static double first(T a) { return static_cast<double>(a); }
+};
+
+struct I32x1 {
+    using T = std::uint32_t;
+    static constexpr const char* name = "i32x1";
+    static constexpr int lanes = 1;
+    static constexpr bool has_div = true;
+    static T set1(std::int64_t v) { return static_cast<T>(v); }
+    static T add(T a, T b) { return a + b; }
+    static T mul(T a, T b) { return a * b; }
+    static T div(T a, T b) { return a / b; }
+    static double first(T a) { return static_cast<double>(a); }
+};
+
+#if defined(__AVX2__)
+struct I32x8 {
+    using T = __m256i;
+    static constexpr const char* name = "i32x8";
+    static constexpr int lanes = 8;
+    static constexpr bool has_div = false;
+    static T set1(std::int64_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+    static T add(T a, T b) { return _mm256_add_epi32(a, b); }
+    static T mul(T a, T b) { return _mm256_mullo_epi32(a, b); }
+    static T div(T a, T) { return a; }
+    static double first(T a) { return static_cast<double>(_mm256_extract_epi32(a, 0)); }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct I32x16 {
+    using T = __m512i;
+    static constexpr const char* name = "i32x16";
+    static constexpr int lanes = 16;
+    static constexpr bool has_div = false;
+    static T set1(std::int64_t v) { return _mm512_set1_epi32(static_cast<int>(v)); }
+    static T add(T a, T b) { return _mm512_add_epi32(a, b); }
+    static T mul(T a, T b) { return _mm512_mullo_epi32(a, b); }
+    static T div(T a, T) { return a; }
+    static double first(T a) { return static_cast<double>(_mm_cvtsi128_si32(_mm512_castsi512_si128(a))); }
+};
+#endif
+
+#if defined(__AVX512DQ__)
+struct I64x8 {
+    using T = __m512i;
+    static constexpr const char* name = "i64x8";
+    static constexpr int lanes = 8;
+    static constexpr bool has_div = false;
+    static T set1(std::int64_t v) { return _mm512_set1_epi64(v); }
+    static T add(T a, T b) { return _mm512_add_epi64(a, b); }
+    static T mul(T a, T b) { return _mm512_mullo_epi64(a, b); }
+    static T div(T a, T) { return a; }
+    static double first(T a) { return static_cast<double>(_mm_cvtsi128_si64(_mm512_castsi512_si128(a))); }
+};
+#endif
+
+// ---------- Chain runner ----------
+
+// Independent chains for the throughput rows: enough to cover latency x ports
+// for FMA (4-5 cycles x 2 ports) on current x86/Arm cores, while still
+// fitting in 16 architectural vector registers next to the constants.
+constexpr int kThroughputChains = 12;
+constexpr std::size_t kOpsPerIter = 1u << 18;
+
+/**
+ * @brief Run K (1 or kThroughputChains) interleaved dependent chains of
+ * `steps` applications of `step`.
+ *
+ * Accumulators are named locals rather than an array: GCC does not promote
+ * an array whose elements pass through inline asm to registers, and the
+ * store/reload it then adds to every step would dominate both rows. Kept out
+ * of line for the same reason: inlined into the timing loop, the chain is
+ * live across the clock calls (which clobber every vector register).
+ */
+template <int K, class T, class Step>
+INSTR_NOINLINE T run_chains(T seed, std::size_t steps, Step step) {
+    static_assert(K == 1 || K == kThroughputChains, "unsupported chain count");
+    auto advance = [&step](T& x) {
+        x = step(x);
+        opaque_reg(x);
+    };
+    if constexpr (K == 1) {
+        T x = seed;
+        for (std::size_t i = 0; i < steps; ++i) advance(x);
+        return x;
+    } else {
+        T a0 = seed, a1 = seed, a2 = seed, a3 = seed, a4 = seed, a5 = seed;
+        T a6 = seed, a7 = seed, a8 = seed, a9 = seed, a10 = seed, a11 = seed;
+        for (std::size_t i = 0; i < steps; ++i) {
+            advance(a0); advance(a1); advance(a2); advance(a3);
+            advance(a4); advance(a5); advance(a6); advance(a7);
+            advance(a8); advance(a9); advance(a10); advance(a11);
+        }
+        opaque_reg(a1); opaque_reg(a2); opaque_reg(a3); opaque_reg(a4); opaque_reg(a5);
+        opaque_reg(a6); opaque_reg(a7); opaque_reg(a8); opaque_reg(a9); opaque_reg(a10);
+        opaque_reg(a11);
+        return a0;
+    }
+}
+
+struct ChainTiming {
+    double ns_per_op = 0.0;
+    BenchmarkResult::Point pt;
+};
+
+/**
+ * @brief Time one row: K = 1 (latency) or K = kThroughputChains (throughput).
+ */
+template <int K, class Tr, class Step>
+ChainTiming time_chain(const Config& conf, const std::string& kernel, typename Tr::T seed, Step step) {
+    const std::size_t steps = kOpsPerIter / K;
+    const double ops = static_cast<double>(steps * K);
+
+    typename Tr::T sink = seed;
+    for (int w = 0; w < conf.warmup; ++w) {
+        sink = run_chains<K>(seed, steps, step);
+        opaque_reg(sink);
+    }
+
+    std::vector<long long> samples;
+    samples.reserve(conf.iters);
+    for (int it = 0; it < conf.iters; ++it) {
+        Timer t;
+        clobber_memory();
+        t.start();
+
+        sink = run_chains<K>(seed, steps, step);
+
+        clobber_memory();
+        samples.push_back(t.elapsed_ns());
+        opaque_reg(sink);
+    }
+
+    ChainTiming out;
+    out.pt.kernel = kernel;
+    out.pt.bytes = 0;
+    BenchmarkResult::fill_timing(out.pt, samples);
+    out.pt.checksum = Tr::first(sink);
+    out.ns_per_op = out.pt.median_ns / ops;
+    out.pt.ops_per_sec = (out.ns_per_op > 0.0) ? 1e9 / out.ns_per_op : 0.0;
+    out.pt.extra["ns_per_op"] = out.ns_per_op;
+    out.pt.extra["chains"] = K;
+    out.pt.extra["lanes"] = Tr::lanes;
+    return out;
+}
+
+/**
+ * @brief Collects rows and converts ns to cycles with a calibrated clock.
+ */
+struct InstrTable {
+    const Config& conf;
+    BenchmarkResult& res;
+    double ns_per_cycle = 0.0; // from benchmark::measure_core_ghz() (1-cycle add chain)
+
+    template <class Tr, class Step>
+    void row(const std::string& op, typename Tr::T seed, Step step) {
+        const std::string base = std::string(op) + "_" + Tr::name;
+        ChainTiming lat = time_chain<1, Tr>(conf, "instr_lat_" + base, seed, step);
+        ChainTiming tput = time_chain<kThroughputChains, Tr>(conf, "instr_tput_" + base, seed, step);
+
+        json entry;
+        entry["lanes"] = Tr::lanes;
+        entry["latency_ns"] = lat.ns_per_op;
+        entry["rthroughput_ns"] = tput.ns_per_op;
+        if (ns_per_cycle > 0.0) {
+            const double lat_cyc = lat.ns_per_op / ns_per_cycle;
+            const double tput_cyc = tput.ns_per_op / ns_per_cycle;
+            entry["latency_cycles"] = lat_cyc;
+            entry["rthroughput_cycles"] = tput_cyc;
+            // Independent accumulators needed to hide the latency (unroll factor).
+            entry["chains_to_saturate"] = (tput_cyc > 0.0) ? std::ceil(lat_cyc / tput_cyc - 0.05) : 0.0;
+            lat.pt.extra["cycles_per_op"] = lat_cyc;
+            tput.pt.extra["cycles_per_op"] = tput_cyc;
+        }
+        res.extra_stats["instruction_table"]["ops"][Tr::name][op] = entry;
+
+        std::cout << "[Instr] " << base << " lat_ns=" << lat.ns_per_op << " rtput_ns=" << tput.ns_per_op;
+        if (entry.contains("latency_cycles")) {
+            std::cout << " lat_cyc=" << entry["latency_cycles"].get<double>()
+                      << " rtput_cyc=" << entry["rthroughput_cycles"].get<double>();
+        }
+        std::cout << "\n";
+
+        res.sweep_points.push_back(lat.pt);
+        res.sweep_points.push_back(tput.pt);
+    }
+
+    template <class Tr>
+    void float_rows() {
+        using T = typename Tr::T;
+        // Constants near 1 keep every chain finite and away from denormals.
+        const T c = Tr::set1(1.0000001);
+        const T c2 = Tr::set1(1e-9);
+        const T hi = Tr::set1(4.0);
+        const T lo = Tr::set1(0.25);
+        const T one = Tr::set1(1.0);
+        row<Tr>("add", one, [c2](T x) { return Tr::add(x, c2); });
+        row<Tr>("mul", one, [c](T x) { return Tr::mul(x, c); });
+        if constexpr (Tr::has_fma) {
+            row<Tr>("fma", one, [c, c2](T x) { return Tr::fma(x, c, c2); });
+        }
+        // The divisor is laundered every step; otherwise -ffast-math turns x / c
+        // into x * (1 / c) and the row silently measures mul.
+        row<Tr>("div", one, [c](T x) {
+            T d = c;
+            opaque_reg(d);
+            return Tr::div(x, d);
+        });
+        row<Tr>("sqrt", Tr::set1(2.0), [](T x) { return Tr::sqrt(x); });
+        row<Tr>("min", one, [hi](T x) { return Tr::min(x, hi); });
+        row<Tr>("max", one, [lo](T x) { return Tr::max(x, lo); });
+        // Round trip float -> int32 -> float (two instructions per step).
+        row<Tr>("cvt_f2i2f", Tr::set1(3.0), [](T x) { return Tr::cvt(x); });
+    }
+
+    template <class Tr>
+    void int_rows() {
+        using T = typename Tr::T;
+        const T one = Tr::set1(1);
+        const T odd = Tr::set1(0x9E3779B1);
+        row<Tr>("add", one, [one](T x) { return Tr::add(x, one); });
+        row<Tr>("mul", Tr::set1(3), [odd](T x) { return Tr::mul(x, odd); });
+        if constexpr (Tr::has_div) {
+            // big / x with x ~ sqrt(big) stays near sqrt(big): operand widths (and
+            // hence the data-dependent divider latency) stay constant along the chain.
+            const T big = (sizeof(T) == 8) ? Tr::set1(std::int64_t(1) << 62) : Tr::set1(std::int64_t(1) << 30);
+            const T start = (sizeof(T) == 8) ? Tr::set1(std::int64_t(1) << 31) : Tr::set1(std::int64_t(1) << 15);
+            row<Tr>("div", start, [big](T x) { return Tr::div(big, x); });
+        }
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Instruction latency / reciprocal-throughput table for --kernel instr.
+ *
+ * For each operation (add, mul, fma, div, sqrt, min, max, float<->int
+ * conversion round trip, integer add/mul/div) and each register width the
+ * build enables (scalar, SSE2, AVX/AVX2, AVX-512), it times:
+ *
+ * - latency     : one dependent chain (each op consumes the previous result)
+ * - rthroughput : kThroughputChains independent chains interleaved
+ *
+ * ns are converted to core cycles with benchmark::measure_core_ghz() (a
+ * scalar integer add chain, 1-cycle latency on every modern core), so the table is in the units unroll decisions are
+ * made in (e.g. chains_to_saturate = latency / rthroughput for FMA is the
+ * number of independent accumulators compute_fma_kernel() needs).
+ *
+ * The table lands in stats.instruction_table; every row is also a sweep
+ * point (instr_lat_* / instr_tput_*).
+ *
+ * @param conf The parsed configuration (warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_instr_bench(const Config& conf, BenchmarkResult& res) {
+    InstrTable table{conf, res};
+
+    const double est_ghz = benchmark::measure_core_ghz();
+    table.ns_per_cycle = (est_ghz > 0.0) ? 1.0 / est_ghz : 0.0;
+    res.extra_stats["instruction_table"]["est_core_ghz"] = est_ghz;
+    res.extra_stats["instruction_table"]["throughput_chains"] = kThroughputChains;
+    std::cout << "[Instr] calibrated core clock ~" << est_ghz << " GHz\n";
+
+    table.float_rows<F64x1>();
+    table.float_rows<F32x1>();
+#if defined(BENCH_X86_SIMD)
+    table.float_rows<F64x2>();
+    table.float_rows<F32x4>();
+#endif
+#if defined(__AVX__)
+    table.float_rows<F64x4>();
+    table.float_rows<F32x8>();
+#endif
+#if defined(__AVX512F__)
+    table.float_rows<F64x8>();
+    table.float_rows<F32x16>();
+#endif
+
+    table.int_rows<I64x1>();
+    table.int_rows<I32x1>();
+#if defined(__AVX2__)
+    table.int_rows<I32x8>();
+#endif
+#if defined(__AVX512F__)
+    table.int_rows<I32x16>();
+#endif
+#if defined(__AVX512DQ__)
+    table.int_rows<I64x8>();
+#endif
+}
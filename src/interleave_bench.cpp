@@ -0,0 +1,350 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "hash_tables.hpp"
+#include "pointer_chase.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using benchmark::ChaseNode;
+
+constexpr std::size_t kMaxGroup = 64;                  // largest interleaving width G
+constexpr std::size_t kLookups = std::size_t(1) << 20; // hash lookups per timed call
+constexpr std::size_t kLoadNum = 7, kLoadDen = 8;      // same 87.5% load as --kernel hash
+
+/*
+ * Interleaving is written as explicit state machines (the tree is C++17,
+ * so no coroutines). Each of G in-flight operations is a tiny state
+ * struct; "suspend" means: issue a prefetch for the line the next step
+ * needs, then switch to the next operation round-robin. By the time the
+ * scheduler comes back, the line has (ideally) arrived, so up to G misses
+ * overlap on one core.
+ */
+
+// ---------- Pointer chase: G independent cursors on one random cycle ----------
+
+/// One chase: the node it will read on resume.
+struct ChaseTask {
+    std::uint32_t cur;
+};
+
+/**
+ * @brief Advance G chases `rounds` hops each, round-robin.
+ *
+ * Resume = consume the prefetched node (cur = next), prefetch the new
+ * node, suspend. Returns the XOR of the final cursors.
+ */
+std::uint32_t chase_interleaved(const ChaseNode* nodes, ChaseTask* tasks, std::size_t g, std::size_t rounds) {
+    for (std::size_t r = 0; r < rounds; ++r) {
+        for (std::size_t k = 0; k < g; ++k) {
+            const std::uint32_t next = nodes[tasks[k].cur].next;
+            tasks[k].cur = next;
+            prefetch_read(&nodes[next]);
+        }
+    }
+    std::uint32_t x = 0;
+    for (std::size_t k = 0; k < g; ++k) x ^= tasks[k].cur;
+    return x;
+}
+
+// ---------- Hash probe: G lookups in flight ----------
+
+/// One lookup: stage 1 hashed and prefetched its home line; stage 2 (find) runs on resume.
+struct ProbeTask {
+    std::uint64_t key;
+};
+
+/**
+ * @brief Run lookups through a ring of G probe tasks.
+ *
+ * Lookup i starts in slot i mod G (hash + prefetch, then suspend) and is
+ * finished by the find() that runs when the ring comes back to that slot,
+ * G lookups later. Returns the sum of found values; `hits` counts them.
+ */
+template <class Table>
+std::uint64_t probe_interleaved(const Table& t, const std::uint64_t* q, std::size_t n, std::size_t g,
+                                std::uint64_t& hits) {
+    ProbeTask ring[kMaxGroup];
+    std::uint64_t sum = 0, h = 0, v = 0;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i >= g && t.find(ring[k].key, v)) {
+            ++h;
+            sum += v;
+        }
+        ring[k].key = q[i];
+        t.prefetch(q[i]);
+        k = (k + 1 == g) ? 0 : k + 1;
+    }
+    for (std::size_t left = std::min(n, g); left > 0; --left) { // drain, oldest first
+        if (t.find(ring[k].key, v)) {
+            ++h;
+            sum += v;
+        }
+        k = (k + 1 == g) ? 0 : k + 1;
+    }
+    hits = h;
+    return sum;
+}
+
+/// Plain lookup loop: no prefetch, overlap left to the out-of-order core.
+template <class Table>
+std::uint64_t probe_plain(const Table& t, const std::uint64_t* q, std::size_t n, std::uint64_t& hits) {
+    std::uint64_t sum = 0, h = 0, v = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (t.find(q[i], v)) {
+            ++h;
+            sum += v;
+        }
+    }
+    hits = h;
+    return sum;
+}
+
+/// Warmup, then conf.iters timed calls of `body`; fills the timing fields of a point.
+template <class F>
+BenchmarkResult::Point time_point(const Config& conf, const std::string& name, std::size_t bytes, F&& body) {
+    for (int w = 0; w < conf.warmup; ++w) body();
+
+    std::vector<long long> samples;
+    samples.reserve(conf.iters);
+    for (int it = 0; it < conf.iters; ++it) {
+        Timer t;
+        clobber_memory();
+        t.start();
+
+        body();
+
+        clobber_memory();
+        samples.push_back(t.elapsed_ns());
+    }
+
+    BenchmarkResult::Point pt;
+    pt.kernel = name;
+    pt.bytes = bytes;
+    BenchmarkResult::fill_timing(pt, samples);
+    return pt;
+}
+
+const std::size_t kGroups[] = {1, 2, 4, 8, 16, 32, 64};
+
+/**
+ * @brief Serialized chase, then G-way interleaved chases over one random
+ * cycle of `bytes`; returns the serialized ns per access.
+ */
+double run_chase_case(const Config& conf, BenchmarkResult& res, std::size_t bytes, json& row) {
+    const std::size_t n = bytes / sizeof(ChaseNode);
+    benchmark::AlignedBuffer<ChaseNode> nodes(n, 64);
+    for (std::size_t i = 0; i < n; ++i) nodes[i] = ChaseNode{0, {0}};
+    benchmark::build_random_cycle(nodes.data(), n, static_cast<std::uint32_t>(conf.seed) ^ static_cast<std::uint32_t>(bytes));
+
+    // Same step count as run_latency_bench.
+    const std::size_t steps = std::min<std::size_t>(std::max<std::size_t>(n, 200'000), 5'000'000);
+
+    std::uint32_t sink = 0;
+    BenchmarkResult::Point serial = time_point(conf, "interleave_chase_serial", bytes, [&] {
+        sink = benchmark::chase_serial(nodes.data(), sink % n, steps);
+        do_not_optimize_away(sink);
+    });
+    serial.ns_per_access = serial.median_ns / static_cast<double>(steps);
+    serial.ops_per_sec = (serial.median_ns > 0.0) ? static_cast<double>(steps) * 1e9 / serial.median_ns : 0.0;
+    serial.checksum = static_cast<double>(sink);
+    serial.extra["group"] = 0;
+    const double serial_ns = serial.ns_per_access;
+    row["chase"]["serial_ns_per_access"] = serial_ns;
+    std::cout << "[Interleave] chase serial bytes=" << bytes << " ns_per_access=" << serial_ns << "\n";
+    res.sweep_points.push_back(std::move(serial));
+
+    // Evenly spaced starts along the cycle: the G chases stay n / G nodes apart,
+    // so no two visit the same node in the same round. Rounds usually exceed
+    // n / G (small rings), so each chase does cover nodes another one visited
+    // earlier; the ring size, not the spacing, sets what is still cached.
+    std::vector<std::uint32_t> order(n);
+    order[0] = 0;
+    for (std::size_t i = 1; i < n; ++i) order[i] = nodes[order[i - 1]].next;
+
+    double best_speedup = 0.0;
+    std::size_t best_g = 1;
+    for (const std::size_t g : kGroups) {
+        if (g > n) break;
+        const std::size_t rounds = steps / g;
+        ChaseTask tasks[kMaxGroup];
+        auto reset = [&] {
+            for (std::size_t k = 0; k < g; ++k) tasks[k].cur = order[n * k / g];
+        };
+
+        reset();
+        chase_interleaved(nodes.data(), tasks, g, rounds);
+        bool ok = true;
+        for (std::size_t k = 0; k < g; ++k) {
+            ok = ok && tasks[k].cur == benchmark::chase_serial(nodes.data(), order[n * k / g], rounds);
+        }
+        if (!ok) std::cerr << "CRITICAL: Validation failed for interleave_chase at G=" << g << " bytes=" << bytes << "\n";
+
+        BenchmarkResult::Point pt = time_point(conf, "interleave_chase", bytes, [&] {
+            reset();
+            sink = chase_interleaved(nodes.data(), tasks, g, rounds);
+            do_not_optimize_away(sink);
+        });
+        const double accesses = static_cast<double>(rounds * g);
+        pt.ns_per_access = pt.median_ns / accesses;
+        pt.ops_per_sec = (pt.median_ns > 0.0) ? accesses * 1e9 / pt.median_ns : 0.0;
+        pt.checksum = static_cast<double>(sink);
+        const double speedup = (pt.ns_per_access > 0.0) ? serial_ns / pt.ns_per_access : 0.0;
+        pt.extra["group"] = static_cast<double>(g);
+        pt.extra["speedup_vs_serial_chase"] = speedup;
+        if (speedup > best_speedup) {
+            best_speedup = speedup;
+            best_g = g;
+        }
+
+        json& cell = row["chase"][std::to_string(g)];
+        cell["ns_per_access"] = pt.ns_per_access;
+        cell["speedup_vs_serial_chase"] = speedup;
+        cell["valid"] = ok;
+        std::cout << "[Interleave] chase G=" << g << " bytes=" << bytes << " ns_per_access=" << pt.ns_per_access
+                  << " speedup=" << speedup << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    }
+    row["chase"]["best_group"] = best_g;
+    row["chase"]["best_speedup"] = best_speedup;
+    return serial_ns;
+}
+
+/**
+ * @brief Plain and G-way interleaved lookups (100% uniform hits) on one
+ * table layout of about `bytes`.
+ */
+template <class Table>
+void run_probe_case(const Config& conf, BenchmarkResult& res, const char* layout, std::size_t capacity,
+                    double serial_ns, json& row) {
+    const std::size_t entries = capacity * kLoadNum / kLoadDen;
+    Table table(capacity);
+    std::vector<std::uint64_t> keys(entries);
+    std::uint64_t ctr = static_cast<std::uint64_t>(conf.seed) << 40;
+    for (std::size_t i = 0; i < entries; ++i) {
+        do keys[i] = benchmark::splitmix64(ctr++);
+        while (keys[i] == 0); // 0 marks an empty slot
+        table.insert(keys[i], i);
+    }
+    std::mt19937_64 rng(static_cast<std::uint64_t>(conf.seed));
+    std::uniform_int_distribution<std::size_t> any_entry(0, entries - 1);
+    std::vector<std::uint64_t> q(kLookups);
+    std::uint64_t expect_sum = 0;
+    for (std::uint64_t& k : q) {
+        const std::size_t e = any_entry(rng);
+        k = keys[e];
+        expect_sum += e;
+    }
+
+    const std::string base = std::string("interleave_hash_") + layout;
+    std::uint64_t hits = 0, sum = 0;
+    BenchmarkResult::Point plain = time_point(conf, base + "_plain", table.bytes(), [&] {
+        sum = probe_plain(table, q.data(), q.size(), hits);
+        do_not_optimize_away(sum);
+    });
+    plain.ns_per_access = plain.median_ns / static_cast<double>(kLookups);
+    plain.ops_per_sec = (plain.median_ns > 0.0) ? static_cast<double>(kLookups) * 1e9 / plain.median_ns : 0.0;
+    plain.checksum = static_cast<double>(sum);
+    plain.extra["group"] = 0;
+    if (plain.ns_per_access > 0.0) plain.extra["speedup_vs_serial_chase"] = serial_ns / plain.ns_per_access;
+    const double plain_ns = plain.ns_per_access;
+    json& out = row["hash"][layout];
+    out["plain_ns_per_lookup"] = plain_ns;
+    std::cout << "[Interleave] hash " << layout << " plain bytes=" << table.bytes() << " ns_per_lookup=" << plain_ns
+              << "\n";
+    res.sweep_points.push_back(std::move(plain));
+
+    double best_rate = 0.0;
+    std::size_t best_g = 1;
+    for (const std::size_t g : kGroups) {
+        sum = probe_interleaved(table, q.data(), q.size(), g, hits);
+        const bool ok = hits == kLookups && sum == expect_sum;
+        if (!ok) {
+            std::cerr << "CRITICAL: Validation failed for " << base << " at G=" << g << " bytes=" << table.bytes()
+                      << "\n";
+        }
+
+        BenchmarkResult::Point pt = time_point(conf, base, table.bytes(), [&] {
+            sum = probe_interleaved(table, q.data(), q.size(), g, hits);
+            do_not_optimize_away(sum);
+        });
+        pt.ns_per_access = pt.median_ns / static_cast<double>(kLookups);
+        pt.ops_per_sec = (pt.median_ns > 0.0) ? static_cast<double>(kLookups) * 1e9 / pt.median_ns : 0.0;
+        pt.checksum = static_cast<double>(sum);
+        pt.extra["group"] = static_cast<double>(g);
+        if (pt.ns_per_access > 0.0) {
+            pt.extra["speedup_vs_plain"] = plain_ns / pt.ns_per_access;
+            pt.extra["speedup_vs_serial_chase"] = serial_ns / pt.ns_per_access;
+        }
+        if (pt.ops_per_sec > best_rate) {
+            best_rate = pt.ops_per_sec;
+            best_g = g;
+        }
+
+        json& cell = out[std::to_string(g)];
+        cell["ns_per_lookup"] = pt.ns_per_access;
+        if (pt.ns_per_access > 0.0) cell["speedup_vs_plain"] = plain_ns / pt.ns_per_access;
+        cell["valid"] = ok;
+        std::cout << "[Interleave] hash " << layout << " G=" << g << " bytes=" << table.bytes()
+                  << " ns_per_lookup=" << pt.ns_per_access << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    }
+    out["best_group"] = best_g;
+}
+
+} // namespace
+
+/**
+ * @brief Software memory-level parallelism runner for --kernel interleave.
+ *
+ * One thread keeps G = 1, 2, 4 .. 64 independent operations in flight as
+ * hand-rolled state machines that prefetch on every suspend:
+ *
+ * - chase: G cursors on the random cycle of run_latency_bench, evenly
+ *   spaced, advanced round-robin; compared with the serialized chase
+ *   (same code and step count as --kernel latency) in the same run.
+ * - hash: lookups through a ring of G probe tasks (hash + prefetch, then
+ *   find G lookups later) on the --kernel hash layouts at 87.5% load,
+ *   100% uniform hits; compared with the plain lookup loop.
+ *
+ * Working sets are half of L2, half of the LLC and 4 x LLC. Every point
+ * reports ns_per_access and ops_per_sec; speedup_vs_serial_chase is the
+ * serialized chase latency over the interleaved time per operation, i.e.
+ * the misses one core overlaps. Best G per workload and size goes to
+ * stats.interleave.
+ *
+ * @param conf The parsed configuration (seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_interleave_bench(const Config& conf, BenchmarkResult& res) {
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const std::size_t l2 = sys.cache_l2_bytes ? static_cast<std::size_t>(sys.cache_l2_bytes) : 1024 * 1024;
+    const std::size_t llc = sys.cache_llc_bytes ? static_cast<std::size_t>(sys.cache_llc_bytes) : 32 * 1024 * 1024;
+
+    json& table = res.extra_stats["interleave"];
+    table["groups"] = std::vector<std::size_t>(std::begin(kGroups), std::end(kGroups));
+    for (const std::size_t target : {l2 / 2, llc / 2, 4 * llc}) {
+        // Power-of-two sizes: node count for the chase, slot count for the tables.
+        std::size_t bytes = 64 * sizeof(ChaseNode);
+        while (2 * bytes <= target) bytes *= 2;
+        json& row = table["sizes"][std::to_string(bytes)];
+
+        const double serial_ns = run_chase_case(conf, res, bytes, row);
+        const std::size_t capacity = bytes / sizeof(benchmark::HashSlot);
+        run_probe_case<benchmark::LinearProbeTable>(conf, res, "linear", capacity, serial_ns, row);
+        run_probe_case<benchmark::RobinHoodTable>(conf, res, "robin_hood", capacity, serial_ns, row);
+        run_probe_case<benchmark::SwissTable>(conf, res, "swiss", capacity, serial_ns, row);
+    }
+}
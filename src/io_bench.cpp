@@ -0,0 +1,566 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "scratch_file.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define BENCH_HAVE_IO_URING 1
+#endif
+#endif
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * @brief Block sizes swept by the iops runner (4 KiB to 1 MiB).
+ */
+std::vector<std::size_t> build_block_sweep() {
+    std::vector<std::size_t> sizes;
+    for (std::size_t kb = 4; kb <= 1024; kb *= 4) sizes.push_back(kb * 1024);
+    return sizes;
+}
+
+#if defined(BENCH_HAVE_IO_URING)
+
+/**
+ * @brief Minimal io_uring wrapper on raw syscalls (no liburing dependency).
+ *
+ * Only what the benchmark needs: one SQ/CQ pair, IORING_OP_READ/WRITE on a
+ * single fd, and a run loop that keeps up to `entries` requests in flight.
+ * The SQ tail and CQ head are published with release stores and the CQ tail
+ * is read with an acquire load, which is the ordering the kernel ABI expects.
+ */
+class IoUring {
+public:
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+    ~IoUring() { reset(); }
+
+    bool init(unsigned entries, std::string& err) {
+        io_uring_params p {};
+        const long fd = ::syscall(__NR_io_uring_setup, entries, &p);
+        if (fd < 0) {
+            err = std::string("io_uring_setup: ") + std::strerror(errno);
+            return false;
+        }
+        ring_fd_ = static_cast<int>(fd);
+        entries_ = p.sq_entries;
+
+        sq_sz_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_sz_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) sq_sz_ = cq_sz_ = std::max(sq_sz_, cq_sz_);
+
+        sq_ptr_ = ::mmap(nullptr, sq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) {
+            sq_ptr_ = nullptr;
+            err = std::string("mmap(sq): ") + std::strerror(errno);
+            return false;
+        }
+        if (single_mmap) {
+            cq_ptr_ = sq_ptr_;
+        } else {
+            cq_ptr_ = ::mmap(nullptr, cq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring_fd_, IORING_OFF_CQ_RING);
+            if (cq_ptr_ == MAP_FAILED) {
+                cq_ptr_ = nullptr;
+                err = std::string("mmap(cq): ") + std::strerror(errno);
+                return false;
+            }
+        }
+
+        sqes_sz_ = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ring_fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            err = std::string("mmap(sqes): ") + std::strerror(errno);
+            return false;
+        }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<unsigned char*>(sq_ptr_);
+        auto* cq = static_cast<unsigned char*>(cq_ptr_);
+        sq_tail_  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask_  = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        cq_head_  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail_  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask_  = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_     = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    unsigned entries() const { return entries_; }
+
+    /**
+     * @brief Issue one I/O per offset, keeping up to `qd` requests in flight.
+     *
+     * Slot `s` owns buffer `bufs + s * block`; its submit timestamp is taken
+     * right before the SQE is published, and latency is recorded when the
+     * matching CQE is reaped.
+     *
+     * On a failed or short completion no further requests are submitted, but
+     * every request already in flight is still reaped before returning, so
+     * the kernel is done with `bufs` and no stale CQE leaks into the next
+     * call. Only if io_uring_enter itself fails can requests remain in
+     * flight; idle() then reports false and the ring must not be reused.
+     */
+    bool run(int fd, bool write, unsigned char* bufs, std::size_t block, unsigned qd,
+             const std::vector<std::uint64_t>& offsets, std::vector<long long>& lat, std::string& err) {
+        qd = std::min(qd, entries_);
+        std::vector<long long> start(qd, 0);
+        std::vector<unsigned> free_slots(qd);
+        for (unsigned s = 0; s < qd; ++s) free_slots[s] = qd - 1 - s;
+
+        const std::size_t total = offsets.size();
+        std::size_t next = 0;
+        std::size_t done = 0;
+        unsigned unsubmitted = 0;
+        bool failed = false;
+
+        while (done < (failed ? next : total)) {
+            unsigned tail = *sq_tail_; // single producer: plain read of our own tail
+            while (!failed && next < total && !free_slots.empty()) {
+                const unsigned slot = free_slots.back();
+                free_slots.pop_back();
+
+                const unsigned idx = tail & sq_mask_;
+                io_uring_sqe* sqe = &sqes_[idx];
+                std::memset(sqe, 0, sizeof(*sqe));
+                sqe->opcode = static_cast<std::uint8_t>(write ? IORING_OP_WRITE : IORING_OP_READ);
+                sqe->fd = fd;
+                sqe->off = offsets[next];
+                sqe->addr = reinterpret_cast<std::uint64_t>(bufs + static_cast<std::size_t>(slot) * block);
+                sqe->len = static_cast<std::uint32_t>(block);
+                sqe->user_data = slot;
+                sq_array_[idx] = idx;
+
+                start[slot] = Timer::now_ns();
+                ++tail;
+                ++next;
+                ++unsubmitted;
+            }
+            __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+            const long rc = ::syscall(__NR_io_uring_enter, ring_fd_, unsubmitted, 1u,
+                                      IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (rc < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+                if (!failed) err = std::string("io_uring_enter: ") + std::strerror(errno);
+                inflight_ = next - done;
+                return false;
+            }
+            unsubmitted -= static_cast<unsigned>(rc);
+
+            unsigned head = *cq_head_; // single consumer
+            const unsigned ctail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+            const long long t_done = Timer::now_ns();
+            while (head != ctail) {
+                const io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+                const unsigned slot = static_cast<unsigned>(cqe->user_data);
+                if (cqe->res != static_cast<std::int32_t>(block) && !failed) {
+                    err = (cqe->res < 0) ? std::string("I/O failed: ") + std::strerror(-cqe->res)
+                                         : std::string("short I/O: ") + std::to_string(cqe->res);
+                    failed = true; // stop submitting, keep reaping what is in flight
+                }
+                if (!failed) lat.push_back(t_done - start[slot]);
+                free_slots.push_back(slot);
+                ++done;
+                ++head;
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        }
+        inflight_ = 0;
+        return !failed;
+    }
+
+    /// False if the last run() returned with requests still in flight.
+    bool idle() const { return inflight_ == 0; }
+
+private:
+    void reset() {
+        if (sqes_) ::munmap(sqes_, sqes_sz_);
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_sz_);
+        if (sq_ptr_) ::munmap(sq_ptr_, sq_sz_);
+        if (ring_fd_ >= 0) ::close(ring_fd_);
+        sqes_ = nullptr;
+        sq_ptr_ = cq_ptr_ = nullptr;
+        ring_fd_ = -1;
+    }
+
+    int ring_fd_ = -1;
+    unsigned entries_ = 0;
+    std::size_t inflight_ = 0;
+
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    std::size_t sq_sz_ = 0;
+    std::size_t cq_sz_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqes_sz_ = 0;
+
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+#endif // BENCH_HAVE_IO_URING
+
+/**
+ * @brief Fallback engine: N persistent threads doing blocking pread/pwrite.
+ *
+ * Queue depth is emulated by the number of workers. Threads are created once
+ * per pool and parked on a condition variable between rounds so that thread
+ * creation never lands inside the timed region.
+ */
+class PreadPool {
+public:
+    explicit PreadPool(unsigned workers) : lat_(workers), errors_(workers) {
+        threads_.reserve(workers);
+        for (unsigned w = 0; w < workers; ++w) {
+            threads_.emplace_back([this, w]() { worker_loop(w); });
+        }
+    }
+
+    PreadPool(const PreadPool&) = delete;
+    PreadPool& operator=(const PreadPool&) = delete;
+
+    ~PreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stop_ = true;
+            ++generation_;
+        }
+        cv_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    bool run(int fd, bool write, unsigned char* bufs, std::size_t block,
+             const std::vector<std::uint64_t>& offsets, std::vector<long long>& lat, std::string& err) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            fd_ = fd;
+            write_ = write;
+            bufs_ = bufs;
+            block_ = block;
+            offsets_ = &offsets;
+            pending_ = static_cast<unsigned>(threads_.size());
+            ++generation_;
+        }
+        cv_.notify_all();
+
+        std::unique_lock<std::mutex> lock(mu_);
+        done_cv_.wait(lock, [this]() { return pending_ == 0; });
+
+        for (std::size_t w = 0; w < threads_.size(); ++w) {
+            if (!errors_[w].empty()) {
+                err = errors_[w];
+                return false;
+            }
+            lat.insert(lat.end(), lat_[w].begin(), lat_[w].end());
+        }
+        return true;
+    }
+
+private:
+    void worker_loop(unsigned w) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mu_);
+                cv_.wait(lock, [&]() { return generation_ != seen; });
+                seen = generation_;
+                if (stop_) return;
+            }
+
+            lat_[w].clear();
+            errors_[w].clear();
+            unsigned char* buf = bufs_ + static_cast<std::size_t>(w) * block_;
+            const std::size_t stride = threads_.size();
+            for (std::size_t i = w; i < offsets_->size(); i += stride) {
+                const off_t off = static_cast<off_t>((*offsets_)[i]);
+                const long long t0 = Timer::now_ns();
+                const ssize_t r = write_ ? ::pwrite(fd_, buf, block_, off) : ::pread(fd_, buf, block_, off);
+                const long long t1 = Timer::now_ns();
+                if (r != static_cast<ssize_t>(block_)) {
+                    errors_[w] = (r < 0) ? std::string("I/O failed: ") + std::strerror(errno)
+                                         : std::string("short I/O: ") + std::to_string(r);
+                    break;
+                }
+                lat_[w].push_back(t1 - t0);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                if (--pending_ == 0) done_cv_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::vector<std::vector<long long>> lat_;
+    std::vector<std::string> errors_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    std::uint64_t generation_ = 0;
+    unsigned pending_ = 0;
+    bool stop_ = false;
+
+    int fd_ = -1;
+    bool write_ = false;
+    unsigned char* bufs_ = nullptr;
+    std::size_t block_ = 0;
+    const std::vector<std::uint64_t>* offsets_ = nullptr;
+};
+
+} // namespace
+
+#endif // __linux__
+
+/**
+ * @brief Random-access file I/O runner for --kernel iops.
+ *
+ * Issues block-aligned random reads (or writes, with --rw write) against a
+ * scratch file of `--size` bytes and sweeps the block size from 4 KiB to
+ * 1 MiB. Requests are submitted through io_uring (raw syscalls) with `--qd`
+ * requests in flight, or through a pool of `--qd` threads doing pread/pwrite
+ * when io_uring is unavailable or `--io-engine threads` is requested.
+ *
+ * Each point reports IOPS (ops_per_sec), bandwidth, and per-I/O latency
+ * percentiles gathered across all measured rounds. Without --direct the file
+ * goes through the page cache, so a file that fits in RAM measures per-I/O
+ * submission/completion overhead against cached pages rather than the
+ * device; --direct opens it with O_DIRECT to bypass the cache.
+ *
+ * @param conf The parsed configuration (size, file, qd, io_engine, rw, ...).
+ * @param res The result object to populate with one point per block size.
+ */
+void run_iops_bench(const Config& conf, BenchmarkResult& res) {
+#if !defined(__linux__)
+    (void)res;
+    std::cerr << "Error: --kernel " << conf.kernel << " requires Linux (pread/io_uring).\n";
+#else
+    std::uint64_t file_bytes = 0;
+    try {
+        file_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        std::cerr << "Examples: 64MB, 512KiB, 1GiB\n";
+        return;
+    }
+    if (file_bytes < 4096) {
+        std::cerr << "Error: --size too small for iops (" << file_bytes << " bytes, need >= 4KiB)\n";
+        return;
+    }
+
+    bool created = false;
+    int fd = prepare_scratch_file(conf.file, file_bytes, created);
+    if (fd < 0) {
+        std::cerr << "Error: cannot prepare --file '" << conf.file << "': " << std::strerror(errno) << "\n";
+        return;
+    }
+    if (conf.direct) {
+        // The fill above uses unaligned buffers, so O_DIRECT is applied on a reopen.
+        ::close(fd);
+        fd = ::open(conf.file.c_str(), O_RDWR | O_DIRECT);
+        if (fd < 0) {
+            std::cerr << "Error: cannot open --file '" << conf.file << "' with O_DIRECT: "
+                      << std::strerror(errno) << " (tmpfs does not support --direct)\n";
+            if (created) ::unlink(conf.file.c_str());
+            return;
+        }
+    }
+
+    const bool write = (conf.rw == "write");
+    const unsigned qd = static_cast<unsigned>(conf.qd);
+
+    // ---- Engine selection (auto prefers io_uring, falls back to threads) ----
+    std::string engine = conf.io_engine;
+    // Buffers of an aborted round whose requests could not be reaped; they
+    // must outlive the ring, so this is declared before it.
+    std::vector<benchmark::AlignedBuffer<unsigned char>> retired;
+#if defined(BENCH_HAVE_IO_URING)
+    IoUring ring;
+    if (engine != "threads") {
+        std::string err;
+        bool ok = ring.init(qd, err);
+        if (ok) {
+            // Probe: IORING_OP_READ/WRITE need Linux 5.6+, older kernels fail per-request.
+            benchmark::AlignedBuffer<unsigned char> probe(4096, 4096);
+            std::vector<std::uint64_t> one{0};
+            std::vector<long long> sink;
+            ok = ring.run(fd, false, probe.data(), 4096, 1, one, sink, err);
+        }
+        if (!ok) {
+            if (engine == "uring") {
+                std::cerr << "Error: io_uring unavailable (" << err << ")\n";
+                ::close(fd);
+                if (created) ::unlink(conf.file.c_str());
+                return;
+            }
+            std::cerr << "[IOPS] io_uring unavailable (" << err << "), falling back to threads\n";
+            engine = "threads";
+        } else {
+            engine = "uring";
+        }
+    }
+#else
+    if (engine == "uring") {
+        std::cerr << "Error: built without <linux/io_uring.h>; use --io-engine threads\n";
+        ::close(fd);
+        if (created) ::unlink(conf.file.c_str());
+        return;
+    }
+    engine = "threads";
+#endif
+
+    std::unique_ptr<PreadPool> pool;
+    if (engine == "threads") pool = std::make_unique<PreadPool>(qd);
+
+    const std::string kernel_name = "iops_" + engine + (write ? "_randwrite" : "_randread");
+    std::mt19937_64 rng(static_cast<std::uint64_t>(conf.seed));
+
+    for (std::size_t block : build_block_sweep()) {
+        if (block > file_bytes) continue;
+        const std::uint64_t nblocks = file_bytes / block;
+
+        // Enough I/Os per round to amortize the round start while keeping huge blocks bounded.
+        const std::size_t ios = std::max<std::size_t>(
+            static_cast<std::size_t>(qd) * 4,
+            static_cast<std::size_t>(std::min<std::uint64_t>(std::max<std::uint64_t>(nblocks, 256), 8192)));
+
+        benchmark::AlignedBuffer<unsigned char> bufs;
+        try {
+            bufs = benchmark::AlignedBuffer<unsigned char>(static_cast<std::size_t>(qd) * block, 4096);
+        } catch (const std::bad_alloc&) {
+            std::cerr << "[IOPS] Allocation failed for block=" << block << ". Skipping.\n";
+            continue;
+        }
+        std::memset(bufs.data(), 0x5a, bufs.size());
+
+        std::uniform_int_distribution<std::uint64_t> pick(0, nblocks - 1);
+        std::vector<std::uint64_t> offsets(ios);
+        auto refill_offsets = [&]() {
+            for (auto& off : offsets) off = pick(rng) * block;
+        };
+
+        std::vector<long long> lat_round;
+        lat_round.reserve(ios);
+        std::string err;
+        auto one_round = [&]() -> bool {
+            lat_round.clear();
+#if defined(BENCH_HAVE_IO_URING)
+            if (engine == "uring") return ring.run(fd, write, bufs.data(), block, qd, offsets, lat_round, err);
+#endif
+            return pool->run(fd, write, bufs.data(), block, offsets, lat_round, err);
+        };
+
+        bool failed = false;
+        for (int w = 0; w < conf.warmup && !failed; ++w) {
+            refill_offsets();
+            failed = !one_round();
+        }
+
+        std::vector<long long> samples;
+        samples.reserve(conf.iters);
+        std::vector<long long> lat_all;
+        lat_all.reserve(static_cast<std::size_t>(conf.iters) * ios);
+        double checksum = 0.0;
+
+        for (int it = 0; it < conf.iters && !failed; ++it) {
+            refill_offsets();
+
+            Timer t;
+            clobber_memory();
+            t.start();
+
+            failed = !one_round();
+
+            clobber_memory();
+            samples.push_back(t.elapsed_ns());
+
+            lat_all.insert(lat_all.end(), lat_round.begin(), lat_round.end());
+            checksum += static_cast<double>(bufs[static_cast<std::size_t>(it % qd) * block]);
+            do_not_optimize_away(checksum);
+        }
+
+        if (failed) {
+            std::cerr << "[IOPS] block=" << block << " aborted: " << err << "\n";
+#if defined(BENCH_HAVE_IO_URING)
+            if (engine == "uring" && !ring.idle()) {
+                std::cerr << "[IOPS] io_uring left requests in flight; stopping sweep\n";
+                retired.push_back(std::move(bufs));
+                break;
+            }
+#endif
+            continue;
+        }
+        if (samples.empty()) continue;
+
+        BenchmarkResult::Point pt;
+        pt.kernel = kernel_name;
+        pt.bytes = block;
+        BenchmarkResult::fill_timing(pt, samples);
+
+        const double med = pt.median_ns;
+        pt.ops_per_sec = (med > 0.0) ? static_cast<double>(ios) * 1e9 / med : 0.0;
+        pt.bandwidth_gb_s = (med > 0.0) ? static_cast<double>(ios) * static_cast<double>(block) / med : 0.0;
+        pt.checksum = checksum;
+
+        std::sort(lat_all.begin(), lat_all.end());
+        double lat_sum = 0.0;
+        for (auto ns : lat_all) lat_sum += static_cast<double>(ns);
+
+        pt.extra["file_bytes"] = static_cast<double>(file_bytes);
+        pt.extra["qd"] = static_cast<double>(qd);
+        pt.extra["ios_per_iter"] = static_cast<double>(ios);
+        pt.extra["lat_mean_ns"] = lat_all.empty() ? 0.0 : lat_sum / static_cast<double>(lat_all.size());
+        pt.extra["lat_p50_ns"] = percentile_ns(lat_all, 50.0);
+        pt.extra["lat_p99_ns"] = percentile_ns(lat_all, 99.0);
+        pt.extra["lat_p999_ns"] = percentile_ns(lat_all, 99.9);
+
+        res.sweep_points.push_back(pt);
+
+        std::cout << "[IOPS] engine=" << engine << " rw=" << conf.rw << " block=" << block
+                  << " qd=" << qd << " iops=" << pt.ops_per_sec
+                  << " bw_gb_s=" << pt.bandwidth_gb_s
+                  << " p99_ns=" << pt.extra["lat_p99_ns"] << "\n";
+    }
+
+    pool.reset();
+    ::close(fd);
+    if (created) ::unlink(conf.file.c_str());
+#endif
+}
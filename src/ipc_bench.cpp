@@ -0,0 +1,615 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * @brief IPC mechanisms compared by the ipc runner.
+ *
+ * Eventfd carries no payload (an 8-byte counter), so it is only measured as
+ * a ping-pong wakeup; the others carry `msg` bytes per message.
+ */
+enum class IpcChannel { Pipe, UnixStream, UnixDgram, Eventfd, ShmRing };
+
+const char* ipc_channel_name(IpcChannel c) {
+    switch (c) {
+        case IpcChannel::Pipe:       return "pipe";
+        case IpcChannel::UnixStream: return "unix_stream";
+        case IpcChannel::UnixDgram:  return "unix_dgram";
+        case IpcChannel::Eventfd:    return "eventfd";
+        case IpcChannel::ShmRing:    return "shm_ring";
+    }
+    return "unknown";
+}
+
+enum class IpcMode { PingPong, Stream };
+
+/**
+ * @brief Message sizes swept per channel (8 B to 64 KiB).
+ */
+std::vector<std::size_t> build_msg_sweep() {
+    return {8, 64, 512, 4096, 32768, 65536};
+}
+
+// ---------- Shared-memory SPSC byte ring with futex wakeups ----------
+
+long futex_call(std::atomic<std::uint32_t>* word, int op, std::uint32_t val, const timespec* timeout) {
+    // Shared (non-private) futex: the word lives in a MAP_SHARED mapping used by two processes.
+    return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), op, val, timeout, nullptr, 0);
+}
+
+/**
+ * @brief Lock-free single-producer/single-consumer byte ring in shared memory.
+ *
+ * `head` counts bytes published by the producer, `tail` bytes consumed.
+ * Each side spins briefly and then sleeps on a futex sequence word; the
+ * other side bumps the word and only issues FUTEX_WAKE if a waiter
+ * registered, so the uncontended fast path is syscall-free.
+ */
+struct alignas(64) ShmRing {
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+    alignas(64) std::atomic<std::uint32_t> data_seq;
+    std::atomic<std::uint32_t> data_waiters;
+    alignas(64) std::atomic<std::uint32_t> space_seq;
+    std::atomic<std::uint32_t> space_waiters;
+    std::uint64_t cap;
+
+    unsigned char* bytes() { return reinterpret_cast<unsigned char*>(this + 1); }
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shm ring needs lock-free 64-bit atomics");
+
+constexpr std::size_t kRingCap = 1024 * 1024;
+constexpr int kSpinPolls = 4096;
+
+ShmRing* ring_create() {
+    void* p = ::mmap(nullptr, sizeof(ShmRing) + kRingCap, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return nullptr;
+    auto* r = new (p) ShmRing();
+    r->head.store(0);
+    r->tail.store(0);
+    r->data_seq.store(0);
+    r->data_waiters.store(0);
+    r->space_seq.store(0);
+    r->space_waiters.store(0);
+    r->cap = kRingCap;
+    return r;
+}
+
+void ring_destroy(ShmRing* r) {
+    if (r) ::munmap(r, sizeof(ShmRing) + kRingCap);
+}
+
+/**
+ * @brief Block until `ready()` holds: spin first, then sleep on `seq`.
+ *
+ * The waiter registers in `waiters` before re-checking, and the notifier
+ * bumps `seq` before reading `waiters` (all seq_cst), so a wakeup cannot be
+ * lost. `peer` (parent side only) lets us notice a dead child instead of
+ * sleeping forever.
+ */
+template <class Ready>
+bool ring_wait(std::atomic<std::uint32_t>& seq, std::atomic<std::uint32_t>& waiters, Ready ready, pid_t peer) {
+    for (int i = 0; i < kSpinPolls; ++i) {
+        if (ready()) return true;
+    }
+    for (;;) {
+        waiters.fetch_add(1);
+        const std::uint32_t s = seq.load();
+        if (ready()) {
+            waiters.fetch_sub(1);
+            return true;
+        }
+        const timespec timeout {1, 0};
+        futex_call(&seq, FUTEX_WAIT, s, &timeout);
+        waiters.fetch_sub(1);
+        if (ready()) return true;
+        if (peer > 0) {
+            int st = 0;
+            if (::waitpid(peer, &st, WNOHANG) == peer) return false;
+        }
+    }
+}
+
+void ring_notify(std::atomic<std::uint32_t>& seq, std::atomic<std::uint32_t>& waiters) {
+    seq.fetch_add(1);
+    if (waiters.load() > 0) futex_call(&seq, FUTEX_WAKE, 1, nullptr);
+}
+
+bool ring_write(ShmRing* r, const unsigned char* src, std::size_t n, pid_t peer) {
+    std::uint64_t head = r->head.load(std::memory_order_relaxed);
+    while (n > 0) {
+        std::uint64_t space = 0;
+        auto has_space = [&]() {
+            space = r->cap - (head - r->tail.load(std::memory_order_acquire));
+            return space > 0;
+        };
+        if (!ring_wait(r->space_seq, r->space_waiters, has_space, peer)) return false;
+
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(n, space));
+        const std::size_t pos = static_cast<std::size_t>(head % r->cap);
+        const std::size_t first = std::min(len, static_cast<std::size_t>(r->cap) - pos);
+        std::memcpy(r->bytes() + pos, src, first);
+        std::memcpy(r->bytes(), src + first, len - first);
+
+        head += len;
+        r->head.store(head);
+        ring_notify(r->data_seq, r->data_waiters);
+        src += len;
+        n -= len;
+    }
+    return true;
+}
+
+bool ring_read(ShmRing* r, unsigned char* dst, std::size_t n, pid_t peer) {
+    std::uint64_t tail = r->tail.load(std::memory_order_relaxed);
+    while (n > 0) {
+        std::uint64_t avail = 0;
+        auto has_data = [&]() {
+            avail = r->head.load(std::memory_order_acquire) - tail;
+            return avail > 0;
+        };
+        if (!ring_wait(r->data_seq, r->data_waiters, has_data, peer)) return false;
+
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(n, avail));
+        const std::size_t pos = static_cast<std::size_t>(tail % r->cap);
+        const std::size_t first = std::min(len, static_cast<std::size_t>(r->cap) - pos);
+        std::memcpy(dst, r->bytes() + pos, first);
+        std::memcpy(dst + first, r->bytes(), len - first);
+
+        tail += len;
+        r->tail.store(tail);
+        ring_notify(r->space_seq, r->space_waiters);
+        dst += len;
+        n -= len;
+    }
+    return true;
+}
+
+// ---------- Endpoints ----------
+
+/**
+ * @brief One side of a bidirectional channel (what the parent or child holds).
+ */
+struct Endpoint {
+    IpcChannel kind = IpcChannel::Pipe;
+    int tx_fd = -1;
+    int rx_fd = -1;
+    ShmRing* tx_ring = nullptr;
+    ShmRing* rx_ring = nullptr;
+    pid_t peer = -1; // set on the parent side to detect a dead child
+};
+
+bool fd_write_all(int fd, const unsigned char* p, std::size_t n) {
+    while (n > 0) {
+        const ssize_t w = ::write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+bool fd_read_all(int fd, unsigned char* p, std::size_t n) {
+    while (n > 0) {
+        const ssize_t r = ::read(fd, p, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+bool ep_send(Endpoint& ep, const unsigned char* buf, std::size_t n) {
+    switch (ep.kind) {
+        case IpcChannel::Pipe:
+        case IpcChannel::UnixStream:
+            return fd_write_all(ep.tx_fd, buf, n);
+        case IpcChannel::UnixDgram: {
+            for (;;) {
+                const ssize_t w = ::send(ep.tx_fd, buf, n, 0);
+                if (w < 0 && errno == EINTR) continue;
+                return w == static_cast<ssize_t>(n);
+            }
+        }
+        case IpcChannel::Eventfd: {
+            const std::uint64_t one = 1;
+            return fd_write_all(ep.tx_fd, reinterpret_cast<const unsigned char*>(&one), sizeof(one));
+        }
+        case IpcChannel::ShmRing:
+            return ring_write(ep.tx_ring, buf, n, ep.peer);
+    }
+    return false;
+}
+
+bool ep_recv(Endpoint& ep, unsigned char* buf, std::size_t n) {
+    switch (ep.kind) {
+        case IpcChannel::Pipe:
+        case IpcChannel::UnixStream:
+            return fd_read_all(ep.rx_fd, buf, n);
+        case IpcChannel::UnixDgram: {
+            for (;;) {
+                const ssize_t r = ::recv(ep.rx_fd, buf, n, 0);
+                if (r < 0 && errno == EINTR) continue;
+                return r == static_cast<ssize_t>(n);
+            }
+        }
+        case IpcChannel::Eventfd: {
+            std::uint64_t v = 0;
+            return fd_read_all(ep.rx_fd, reinterpret_cast<unsigned char*>(&v), sizeof(v));
+        }
+        case IpcChannel::ShmRing:
+            return ring_read(ep.rx_ring, buf, n, ep.peer);
+    }
+    return false;
+}
+
+/**
+ * @brief Kernel objects backing one channel, created before fork().
+ */
+struct ChannelFds {
+    int a[2] = {-1, -1};  // pipe parent->child, socketpair, or eventfd pair
+    int b[2] = {-1, -1};  // pipe child->parent
+    ShmRing* to_child = nullptr;
+    ShmRing* to_parent = nullptr;
+};
+
+bool channel_open(IpcChannel c, std::size_t max_msg, ChannelFds& f) {
+    switch (c) {
+        case IpcChannel::Pipe:
+            if (::pipe(f.a) != 0) return false;
+            if (::pipe(f.b) != 0) return false;
+            return true;
+        case IpcChannel::UnixStream:
+            return ::socketpair(AF_UNIX, SOCK_STREAM, 0, f.a) == 0;
+        case IpcChannel::UnixDgram: {
+            if (::socketpair(AF_UNIX, SOCK_DGRAM, 0, f.a) != 0) return false;
+            // A datagram must fit the send buffer in one piece.
+            const int buf = static_cast<int>(std::max<std::size_t>(max_msg * 4, 256 * 1024));
+            for (int fd : f.a) {
+                ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buf, sizeof(buf));
+                ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf, sizeof(buf));
+            }
+            return true;
+        }
+        case IpcChannel::Eventfd:
+            f.a[0] = ::eventfd(0, 0);
+            f.a[1] = ::eventfd(0, 0);
+            return f.a[0] >= 0 && f.a[1] >= 0;
+        case IpcChannel::ShmRing:
+            f.to_child = ring_create();
+            f.to_parent = ring_create();
+            return f.to_child && f.to_parent;
+    }
+    return false;
+}
+
+void channel_close(ChannelFds& f) {
+    for (int* pair : {f.a, f.b}) {
+        for (int i = 0; i < 2; ++i) {
+            if (pair[i] >= 0) ::close(pair[i]);
+            pair[i] = -1;
+        }
+    }
+    ring_destroy(f.to_child);
+    ring_destroy(f.to_parent);
+    f.to_child = f.to_parent = nullptr;
+}
+
+Endpoint parent_endpoint(IpcChannel c, ChannelFds& f, pid_t child) {
+    Endpoint ep;
+    ep.kind = c;
+    ep.peer = child;
+    switch (c) {
+        case IpcChannel::Pipe:       ep.tx_fd = f.a[1]; ep.rx_fd = f.b[0]; break;
+        case IpcChannel::UnixStream:
+        case IpcChannel::UnixDgram:  ep.tx_fd = ep.rx_fd = f.a[0]; break;
+        case IpcChannel::Eventfd:    ep.tx_fd = f.a[0]; ep.rx_fd = f.a[1]; break;
+        case IpcChannel::ShmRing:    ep.tx_ring = f.to_child; ep.rx_ring = f.to_parent; break;
+    }
+    return ep;
+}
+
+Endpoint child_endpoint(IpcChannel c, ChannelFds& f) {
+    Endpoint ep;
+    ep.kind = c;
+    switch (c) {
+        case IpcChannel::Pipe:       ep.tx_fd = f.b[1]; ep.rx_fd = f.a[0]; break;
+        case IpcChannel::UnixStream:
+        case IpcChannel::UnixDgram:  ep.tx_fd = ep.rx_fd = f.a[1]; break;
+        case IpcChannel::Eventfd:    ep.tx_fd = f.a[1]; ep.rx_fd = f.a[0]; break;
+        case IpcChannel::ShmRing:    ep.tx_ring = f.to_parent; ep.rx_ring = f.to_child; break;
+    }
+    return ep;
+}
+
+// ---------- CPU placement ----------
+
+/**
+ * @brief Where parent and child run: unpinned, both on one CPU, or apart.
+ */
+struct Placement {
+    const char* name;
+    int parent_cpu; // -1 = leave unpinned
+    int child_cpu;
+};
+
+std::vector<int> allowed_cpus(const cpu_set_t& set) {
+    std::vector<int> cpus;
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (CPU_ISSET(c, &set)) cpus.push_back(c);
+    }
+    return cpus;
+}
+
+std::vector<Placement> build_placements(const std::vector<int>& cpus) {
+    std::vector<Placement> out;
+    out.push_back({"unpinned", -1, -1});
+    if (!cpus.empty()) out.push_back({"same_cpu", cpus.front(), cpus.front()});
+    // Last allowed CPU: most likely a different physical core (or socket) than the first.
+    if (cpus.size() >= 2) out.push_back({"cross_cpu", cpus.front(), cpus.back()});
+    return out;
+}
+
+void pin_to(int cpu, const cpu_set_t& fallback) {
+    if (cpu < 0) {
+        ::sched_setaffinity(0, sizeof(fallback), &fallback);
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    ::sched_setaffinity(0, sizeof(set), &set);
+}
+
+// ---------- One measurement ----------
+
+struct IpcParams {
+    IpcChannel channel;
+    IpcMode mode;
+    std::size_t msg;
+    std::size_t msgs_per_iter; // round trips (ping-pong) or messages (stream)
+    int warmup;
+    int iters;
+};
+
+/**
+ * @brief The peer's side of one iteration (mirror of the parent's).
+ */
+bool child_iteration(Endpoint& ep, const IpcParams& p, unsigned char* buf) {
+    if (p.mode == IpcMode::PingPong) {
+        for (std::size_t r = 0; r < p.msgs_per_iter; ++r) {
+            if (!ep_recv(ep, buf, p.msg)) return false;
+            if (!ep_send(ep, buf, p.msg)) return false;
+        }
+        return true;
+    }
+    for (std::size_t m = 0; m < p.msgs_per_iter; ++m) {
+        if (!ep_recv(ep, buf, p.msg)) return false;
+    }
+    // Ack so the parent's timer covers delivery, not just enqueueing.
+    return ep_send(ep, buf, 8);
+}
+
+bool parent_iteration(Endpoint& ep, const IpcParams& p, unsigned char* buf) {
+    if (p.mode == IpcMode::PingPong) {
+        for (std::size_t r = 0; r < p.msgs_per_iter; ++r) {
+            if (!ep_send(ep, buf, p.msg)) return false;
+            if (!ep_recv(ep, buf, p.msg)) return false;
+        }
+        return true;
+    }
+    for (std::size_t m = 0; m < p.msgs_per_iter; ++m) {
+        if (!ep_send(ep, buf, p.msg)) return false;
+    }
+    return ep_recv(ep, buf, 8);
+}
+
+/**
+ * @brief Fork a peer, run warmup + timed iterations, and collect samples.
+ * @return false if the channel could not be set up or the peer failed.
+ */
+bool measure(const IpcParams& p, const Placement& pl, const cpu_set_t& orig, std::vector<long long>& samples,
+             double& checksum) {
+    ChannelFds f;
+    if (!channel_open(p.channel, p.msg, f)) {
+        channel_close(f);
+        return false;
+    }
+
+    const pid_t child = ::fork();
+    if (child < 0) {
+        channel_close(f);
+        return false;
+    }
+
+    if (child == 0) {
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        pin_to(pl.child_cpu, orig);
+        Endpoint ep = child_endpoint(p.channel, f);
+        std::vector<unsigned char> buf(std::max<std::size_t>(p.msg, 8), 0);
+        for (int it = 0; it < p.warmup + p.iters; ++it) {
+            if (!child_iteration(ep, p, buf.data())) ::_exit(1);
+        }
+        ::_exit(0);
+    }
+
+    pin_to(pl.parent_cpu, orig);
+    Endpoint ep = parent_endpoint(p.channel, f, child);
+    std::vector<unsigned char> buf(std::max<std::size_t>(p.msg, 8), 0);
+    for (std::size_t i = 0; i < buf.size(); ++i) buf[i] = static_cast<unsigned char>(i * 131u + 7u);
+
+    bool ok = true;
+    for (int w = 0; w < p.warmup && ok; ++w) ok = parent_iteration(ep, p, buf.data());
+
+    for (int it = 0; it < p.iters && ok; ++it) {
+        Timer t;
+        clobber_memory();
+        t.start();
+
+        ok = parent_iteration(ep, p, buf.data());
+
+        clobber_memory();
+        samples.push_back(t.elapsed_ns());
+        checksum += static_cast<double>(buf[0]);
+    }
+
+    if (!ok) ::kill(child, SIGKILL);
+    int status = 0;
+    while (::waitpid(child, &status, 0) < 0 && errno == EINTR) {
+    }
+    pin_to(-1, orig);
+    channel_close(f);
+
+    return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+#endif // __linux__
+
+/**
+ * @brief Local IPC runner for --kernel ipc.
+ *
+ * Forks a peer process per measurement and compares pipes, Unix domain
+ * sockets (stream and datagram), eventfd signaling, and a lock-free
+ * shared-memory ring with futex wakeups. Two modes per channel:
+ *
+ * - pingpong: round trips of `msg` bytes; reports rtt_ns and one_way_ns.
+ * - stream  : one-directional messages, acknowledged once per iteration;
+ *             reports bandwidth and messages/s.
+ *
+ * Message size is swept from 8 B to 64 KiB and each combination is run
+ * unpinned, with both processes on one CPU, and on two distant CPUs
+ * (when the affinity mask allows). `--size` bounds the bytes streamed per
+ * iteration.
+ *
+ * @param conf The parsed configuration (size, warmup, iters, ...).
+ * @param res The result object to populate with sweep points.
+ */
+void run_ipc_bench(const Config& conf, BenchmarkResult& res) {
+#if !defined(__linux__)
+    (void)res;
+    std::cerr << "Error: --kernel " << conf.kernel << " requires Linux (fork/eventfd/futex).\n";
+#else
+    std::uint64_t stream_bytes = 0;
+    try {
+        stream_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        std::cerr << "Examples: 64MB, 512KiB, 1GiB\n";
+        return;
+    }
+
+    // A child blocked in write() on a dead parent must not take us down with SIGPIPE.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    cpu_set_t orig;
+    CPU_ZERO(&orig);
+    ::sched_getaffinity(0, sizeof(orig), &orig);
+    const auto placements = build_placements(allowed_cpus(orig));
+
+    const IpcChannel channels[] = {IpcChannel::Pipe, IpcChannel::UnixStream, IpcChannel::UnixDgram,
+                                   IpcChannel::Eventfd, IpcChannel::ShmRing};
+    const std::size_t pingpong_rounds = 256;
+
+    for (IpcChannel ch : channels) {
+        for (IpcMode mode : {IpcMode::PingPong, IpcMode::Stream}) {
+            if (ch == IpcChannel::Eventfd && mode == IpcMode::Stream) continue; // counter coalesces, no payload
+
+            for (std::size_t msg : build_msg_sweep()) {
+                if (ch == IpcChannel::Eventfd && msg != 8) continue;
+
+                for (const Placement& pl : placements) {
+                    IpcParams p {};
+                    p.channel = ch;
+                    p.mode = mode;
+                    p.msg = msg;
+                    p.msgs_per_iter = (mode == IpcMode::PingPong)
+                                          ? pingpong_rounds
+                                          : static_cast<std::size_t>(std::min<std::uint64_t>(
+                                                std::max<std::uint64_t>(stream_bytes / msg, 16), 65536));
+                    p.warmup = conf.warmup;
+                    p.iters = conf.iters;
+
+                    std::vector<long long> samples;
+                    samples.reserve(conf.iters);
+                    double checksum = 0.0;
+                    const std::string kernel = std::string("ipc_") + ipc_channel_name(ch) +
+                                               (mode == IpcMode::PingPong ? "_pingpong_" : "_stream_") + pl.name;
+
+                    if (!measure(p, pl, orig, samples, checksum) || samples.empty()) {
+                        std::cerr << "[IPC] " << kernel << " msg=" << msg << " failed, skipping\n";
+                        continue;
+                    }
+
+                    BenchmarkResult::Point pt;
+                    pt.kernel = kernel;
+                    pt.bytes = msg;
+                    BenchmarkResult::fill_timing(pt, samples);
+                    pt.checksum = checksum;
+
+                    const double med = pt.median_ns;
+                    const double msgs = static_cast<double>(p.msgs_per_iter);
+                    pt.extra["msgs_per_iter"] = msgs;
+                    pt.extra["parent_cpu"] = pl.parent_cpu;
+                    pt.extra["child_cpu"] = pl.child_cpu;
+                    if (mode == IpcMode::PingPong) {
+                        pt.extra["rtt_ns"] = med / msgs;
+                        pt.extra["one_way_ns"] = med / msgs / 2.0;
+                        pt.ops_per_sec = (med > 0.0) ? msgs * 1e9 / med : 0.0;
+                        // Payload crosses the channel twice per round trip.
+                        pt.bandwidth_gb_s = (med > 0.0) ? 2.0 * msgs * static_cast<double>(msg) / med : 0.0;
+                    } else {
+                        pt.ops_per_sec = (med > 0.0) ? msgs * 1e9 / med : 0.0;
+                        pt.bandwidth_gb_s = (med > 0.0) ? msgs * static_cast<double>(msg) / med : 0.0;
+                    }
+
+                    res.sweep_points.push_back(pt);
+
+                    std::cout << "[IPC] " << kernel << " msg=" << msg;
+                    if (mode == IpcMode::PingPong) {
+                        std::cout << " one_way_ns=" << pt.extra["one_way_ns"] << "\n";
+                    } else {
+                        std::cout << " bw_gb_s=" << pt.bandwidth_gb_s << "\n";
+                    }
+                }
+            }
+        }
+    }
+#endif
+}
@@ -3,31 +3,18 @@
 #include "timer.hpp"
 #include "utils.hpp"
 #include "aligned_buffer.hpp"
+#include "pointer_chase.hpp"
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <new>
-#include <random>
 #include <vector>
 
 namespace {
 
-/**
- * @brief A node in the linked list used for pointer chasing.
- *
- * The `alignas(64)` attribute ensures that each node occupies exactly one
- * cache line (64 bytes on most modern architectures). This prevents
- * "false sharing" and ensures that when we fetch a node, we are fetching
- * exactly one cache line, making the latency measurement accurate.
- *
- * The `pad` array fills the rest of the 64 bytes after the 4-byte `next` index.
- */
-struct alignas(64) Node {
-    std::uint32_t next;
-    std::uint32_t pad[15]; // 64B total (1 + 15)*4
-};
+using benchmark::ChaseNode;
 
 /**
  * @brief Build a sweep of working set sizes for the latency benchmark.
@@ -52,46 +39,13 @@ static std::vector<std::size_t> build_sweep_bytes() {
 }
 
 /**
- * @brief Convert a size in bytes to the number of `Node` elements.
+ * @brief Convert a size in bytes to the number of `ChaseNode` elements.
  *
  * @param bytes The total size in bytes.
- * @return The number of `Node` elements (bytes / 64).
+ * @return The number of `ChaseNode` elements (bytes / 64).
  */
 static std::size_t bytes_to_nodes(std::size_t bytes) {
-    return bytes / sizeof(Node);
-}
-
-/**
- * @brief Build a randomized single-cycle linked list.
- *
- * This is the core setup for a pointer-chasing benchmark. It creates a linked
- * list where every node is visited exactly once before returning to the start.
- * The order of nodes is randomized to defeat hardware prefetchers. If the
- * accesses were sequential, the CPU would prefetch the next cache line, hiding
- * the true memory latency.
- *
- * @param nodes Pointer to the array of nodes.
- * @param n Total number of nodes.
- * @param seed Random seed for reproducibility.
- */
-static void build_random_cycle(Node* nodes, std::size_t n, std::uint32_t seed) {
-    // Build a single random cycle permutation: next[i] = perm[i+1], last points to first.
-    std::vector<std::uint32_t> idx(n);
-    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(n); ++i) idx[i] = i;
-
-    // Shuffle indices to create a random access pattern (defeats hardware prefetchers).
-    std::mt19937 rng(seed);
-    std::shuffle(idx.begin(), idx.end(), rng);
-
-    // Link each node to the next random node in the shuffled list.
-    for (std::size_t i = 0; i + 1 < n; ++i) {
-        nodes[idx[i]].next = idx[i + 1];
-    }
-    // Close the cycle by linking the last node back to the first.
-    nodes[idx[n - 1]].next = idx[0];
-
-    // Touch pads so the compiler can't assume they're unused and optimize them away.
-    nodes[idx[0]].pad[0] = 1;
+    return bytes / sizeof(ChaseNode);
 }
 
 } // namespace
@@ -100,7 +54,7 @@ static void build_random_cycle(Node* nodes, std::size_t n, std::uint32_t seed) {
  * @brief Pointer-chasing latency benchmark runner.
  *
  * This function executes the latency benchmark across a range of working set
- * sizes. For each size, it allocates an array of `Node`s, builds a randomized
+ * sizes. For each size, it allocates an array of `ChaseNode`s, builds a randomized
  * linked list, and then times how long it takes to traverse the list.
  *
  * The result is a sweep of `ns_per_access` vs working-set size (bytes), which
@@ -119,18 +73,18 @@ void run_latency_bench(const Config& conf, BenchmarkResult& res) {
         if (n < 2) continue;
 
         // Allocate nodes (aligned, one node per cache line).
-        std::vector<Node> nodes_vec;
-        benchmark::AlignedBuffer<Node> nodes_aligned;
-        Node* nodes = nullptr;
+        std::vector<ChaseNode> nodes_vec;
+        benchmark::AlignedBuffer<ChaseNode> nodes_aligned;
+        ChaseNode* nodes = nullptr;
 
         try {
             if (use_aligned) {
-                nodes_aligned = benchmark::AlignedBuffer<Node>(n, alignment);
+                nodes_aligned = benchmark::AlignedBuffer<ChaseNode>(n, alignment);
                 nodes = nodes_aligned.data();
                 // Value-init (posix_memalign/_aligned_malloc are uninitialized)
-                for (std::size_t i = 0; i < n; ++i) nodes[i] = Node{0, {0}};
+                for (std::size_t i = 0; i < n; ++i) nodes[i] = ChaseNode{0, {0}};
             } else {
-                nodes_vec.assign(n, Node{0, {0}});
+                nodes_vec.assign(n, ChaseNode{0, {0}});
                 nodes = nodes_vec.data();
             }
         } catch (const std::bad_alloc&) {
@@ -141,7 +95,7 @@ void run_latency_bench(const Config& conf, BenchmarkResult& res) {
 
         // Optional prefault.
         if (conf.prefault) {
-            const std::size_t page_nodes = 4096 / sizeof(Node);
+            const std::size_t page_nodes = 4096 / sizeof(ChaseNode);
             const std::size_t step = std::max<std::size_t>(1, page_nodes);
             for (std::size_t i = 0; i < n; i += step) {
                 volatile std::uint32_t t = nodes[i].next;
@@ -150,7 +104,7 @@ void run_latency_bench(const Config& conf, BenchmarkResult& res) {
             do_not_optimize_away(nodes[0].next);
         }
 
-        build_random_cycle(nodes, n, static_cast<std::uint32_t>(conf.seed) ^ static_cast<std::uint32_t>(size_bytes));
+        benchmark::build_random_cycle(nodes, n, static_cast<std::uint32_t>(conf.seed) ^ static_cast<std::uint32_t>(size_bytes));
 
         // Choose number of dependent loads per iteration.
         // For very large working sets, scaling as O(n) can get too slow.
@@ -161,11 +115,7 @@ void run_latency_bench(const Config& conf, BenchmarkResult& res) {
         const std::size_t steps = std::min<std::size_t>(std::max<std::size_t>(n, min_steps), max_steps);
 
         auto chase = [&](std::uint32_t start) -> std::uint32_t {
-            std::uint32_t cur = start;
-            for (std::size_t i = 0; i < steps; ++i) {
-                cur = nodes[cur].next;
-            }
-            return cur;
+            return benchmark::chase_serial(nodes, start, steps);
         };
 
         // Warmup
@@ -10,9 +10,51 @@
 void run_stream_sweep(const Config& conf, BenchmarkResult& res, StreamOp op);
 
 void run_compute_bench(const Config& conf, BenchmarkResult& res, const std::string& kind);
+void run_peak_flops_bench(const Config& conf, BenchmarkResult& res);
+void run_roofline_bench(const Config& conf, BenchmarkResult& res);
+void run_gemm_bench(const Config& conf, BenchmarkResult& res);
+void run_gemv_bench(const Config& conf, BenchmarkResult& res);
+
+void run_precision_bench(const Config& conf, BenchmarkResult& res);
+
+void run_stencil_bench(const Config& conf, BenchmarkResult& res);
+
+void run_spmv_bench(const Config& conf, BenchmarkResult& res);
+
+void run_cg_bench(const Config& conf, BenchmarkResult& res);
+
+void run_transpose_bench(const Config& conf, BenchmarkResult& res);
+
+void run_scan_bench(const Config& conf, BenchmarkResult& res);
+
+void run_histogram_bench(const Config& conf, BenchmarkResult& res);
+
+void run_sort_bench(const Config& conf, BenchmarkResult& res);
+
+void run_hash_bench(const Config& conf, BenchmarkResult& res);
+
+void run_interleave_bench(const Config& conf, BenchmarkResult& res);
+
+void run_gups_bench(const Config& conf, BenchmarkResult& res);
+
+void run_bfs_bench(const Config& conf, BenchmarkResult& res);
+
+void run_search_bench(const Config& conf, BenchmarkResult& res);
 
 void run_latency_bench(const Config& conf, BenchmarkResult& res);
 
+void run_iops_bench(const Config& conf, BenchmarkResult& res);
+
+void run_zerocopy_bench(const Config& conf, BenchmarkResult& res);
+
+void run_ipc_bench(const Config& conf, BenchmarkResult& res);
+
+void run_syscall_bench(const Config& conf, BenchmarkResult& res);
+
+void run_branch_bench(const Config& conf, BenchmarkResult& res);
+
+void run_instr_bench(const Config& conf, BenchmarkResult& res);
+
 int main(int argc, char** argv) {
     Config conf = parse_args(argc, argv);
     BenchmarkResult res;
@@ -39,9 +81,78 @@ int main(int argc, char** argv) {
     else if (conf.kernel == "flops" || conf.kernel == "fma" || conf.kernel == "dot" || conf.kernel == "saxpy") {
         run_compute_bench(conf, res, conf.kernel);
     } 
+    else if (conf.kernel == "peak") {
+        run_peak_flops_bench(conf, res);
+    }
+    else if (conf.kernel == "roofline") {
+        run_roofline_bench(conf, res);
+    }
+    else if (conf.kernel == "gemm") {
+        run_gemm_bench(conf, res);
+    }
+    else if (conf.kernel == "gemv") {
+        run_gemv_bench(conf, res);
+    }
+    else if (conf.kernel == "stencil") {
+        run_stencil_bench(conf, res);
+    }
+    else if (conf.kernel == "spmv") {
+        run_spmv_bench(conf, res);
+    }
+    else if (conf.kernel == "cg") {
+        run_cg_bench(conf, res);
+    }
+    else if (conf.kernel == "transpose") {
+        run_transpose_bench(conf, res);
+    }
+    else if (conf.kernel == "scan") {
+        run_scan_bench(conf, res);
+    }
+    else if (conf.kernel == "histogram") {
+        run_histogram_bench(conf, res);
+    }
+    else if (conf.kernel == "sort") {
+        run_sort_bench(conf, res);
+    }
+    else if (conf.kernel == "hash") {
+        run_hash_bench(conf, res);
+    }
+    else if (conf.kernel == "interleave") {
+        run_interleave_bench(conf, res);
+    }
+    else if (conf.kernel == "gups") {
+        run_gups_bench(conf, res);
+    }
+    else if (conf.kernel == "bfs") {
+        run_bfs_bench(conf, res);
+    }
+    else if (conf.kernel == "search") {
+        run_search_bench(conf, res);
+    }
+    else if (conf.kernel == "precision") {
+        run_precision_bench(conf, res);
+    }
     else if (conf.kernel == "latency") {
         run_latency_bench(conf, res);
     }
+    else if (conf.kernel == "iops") {
+        run_iops_bench(conf, res);
+    }
+    else if (conf.kernel == "zerocopy") {
+        run_zerocopy_bench(conf, res);
+    }
+    else if (conf.kernel == "ipc") {
+        run_ipc_bench(conf, res);
+    }
+    else if (conf.kernel == "syscall") {
+        run_syscall_bench(conf, res);
+    }
+    else if (conf.kernel == "branch") {
+        run_branch_bench(conf, res);
+    }
+    else if (conf.kernel == "instr") {
+        run_instr_bench(conf, res);
+    }
     else {
         std::cerr << "Error: Unknown kernel: " << conf.kernel << "\n";
         return 1;
@@ -0,0 +1,494 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "compute_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace {
+
+using bf16_t = std::uint16_t;
+
+/// bf16 -> fp32 is exact: the bf16 bits are the top half of the fp32 bits.
+inline float bf16_to_float(bf16_t h) {
+    const std::uint32_t u = static_cast<std::uint32_t>(h) << 16;
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+/// fp32 -> bf16 with round-to-nearest-even (NaN payloads are not preserved).
+inline bf16_t float_to_bf16(float f) {
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    u += 0x7FFFu + ((u >> 16) & 1u);
+    return static_cast<bf16_t>(u >> 16);
+}
+
+/**
+ * @brief Contiguous slice [lo, hi) of n elements for the calling OpenMP thread.
+ *
+ * Slice starts are multiples of `align` elements so the SIMD paths below
+ * only need a scalar tail on the last slice.
+ */
+inline void thread_slice(std::size_t n, std::size_t align, std::size_t& lo, std::size_t& hi) {
+#if defined(_OPENMP)
+    const std::size_t t = static_cast<std::size_t>(omp_get_thread_num());
+    const std::size_t nt = static_cast<std::size_t>(omp_get_num_threads());
+#else
+    const std::size_t t = 0, nt = 1;
+#endif
+    const std::size_t units = (n + align - 1) / align;
+    const std::size_t per = (units + nt - 1) / nt;
+    lo = std::min(n, t * per * align);
+    hi = std::min(n, (t + 1) * per * align);
+}
+
+// ---------- dot (fp64 is compute_dot_kernel) ----------
+
+/// fp32 storage and fp32 accumulation (auto-vectorized).
+float dot_f32(const float* x, const float* y, std::size_t n) {
+    float sum = 0.0f;
+    #pragma omp parallel for reduction(+:sum) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) sum += x[i] * y[i];
+    return sum;
+}
+
+/**
+ * @brief bf16 x bf16 with fp32 accumulation over [0, n) of one slice.
+ *
+ * AVX512-BF16: vdpbf16ps (pairwise products summed into fp32 lanes).
+ * AVX-512F / AVX2: widen 16 / 8 bf16 to fp32 by a 16-bit shift, then FMA.
+ * Otherwise a scalar loop the compiler may vectorize.
+ */
+float dot_bf16_range(const bf16_t* x, const bf16_t* y, std::size_t n) {
+    std::size_t i = 0;
+    float sum = 0.0f;
+#if defined(__AVX512BF16__) && (defined(__GNUC__) || defined(__clang__))
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    for (; i + 64 <= n; i += 64) {
+        const __m512bh a0 = (__m512bh)_mm512_loadu_si512(x + i);
+        const __m512bh b0 = (__m512bh)_mm512_loadu_si512(y + i);
+        const __m512bh a1 = (__m512bh)_mm512_loadu_si512(x + i + 32);
+        const __m512bh b1 = (__m512bh)_mm512_loadu_si512(y + i + 32);
+        acc0 = _mm512_dpbf16_ps(acc0, a0, b0);
+        acc1 = _mm512_dpbf16_ps(acc1, a1, b1);
+    }
+    sum = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+#elif defined(__AVX512F__)
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    for (; i + 32 <= n; i += 32) {
+        const __m512 a0 = _mm512_castsi512_ps(_mm512_slli_epi32(
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i))), 16));
+        const __m512 b0 = _mm512_castsi512_ps(_mm512_slli_epi32(
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i))), 16));
+        const __m512 a1 = _mm512_castsi512_ps(_mm512_slli_epi32(
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + 16))), 16));
+        const __m512 b1 = _mm512_castsi512_ps(_mm512_slli_epi32(
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i + 16))), 16));
+        acc0 = _mm512_fmadd_ps(a0, b0, acc0);
+        acc1 = _mm512_fmadd_ps(a1, b1, acc1);
+    }
+    sum = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+#elif defined(__AVX2__) && defined(__FMA__)
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+        const __m256 a0 = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i))), 16));
+        const __m256 b0 = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i))), 16));
+        const __m256 a1 = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 8))), 16));
+        const __m256 b1 = _mm256_castsi256_ps(_mm256_slli_epi32(
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i + 8))), 16));
+        acc0 = _mm256_fmadd_ps(a0, b0, acc0);
+        acc1 = _mm256_fmadd_ps(a1, b1, acc1);
+    }
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 s4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s4 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
+    s4 = _mm_add_ss(s4, _mm_movehdup_ps(s4));
+    sum = _mm_cvtss_f32(s4);
+#endif
+    for (; i < n; ++i) sum += bf16_to_float(x[i]) * bf16_to_float(y[i]);
+    return sum;
+}
+
+float dot_bf16(const bf16_t* x, const bf16_t* y, std::size_t n) {
+    float sum = 0.0f;
+    #pragma omp parallel reduction(+:sum)
+    {
+        std::size_t lo = 0, hi = 0;
+        thread_slice(n, 64, lo, hi);
+        if (hi > lo) sum += dot_bf16_range(x + lo, y + lo, hi - lo);
+    }
+    return sum;
+}
+
+/**
+ * @brief int8 x int8 -> int32 over one block of at most kI8Block elements.
+ *
+ * AVX-512BW / AVX2: sign-extend to int16 and vpmaddwd (pairs of products
+ * summed into int32 lanes). VNNI's vpdpbusd is unsigned x signed, so it
+ * does not apply to int8 x int8 without a bias correction pass.
+ */
+std::int32_t dot_i8_block(const std::int8_t* x, const std::int8_t* y, std::size_t n) {
+    std::size_t i = 0;
+    std::int32_t sum = 0;
+#if defined(__AVX512BW__)
+    __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+    for (; i + 64 <= n; i += 64) {
+        const __m512i a0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)));
+        const __m512i b0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)));
+        const __m512i a1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + 32)));
+        const __m512i b1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i + 32)));
+        acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(a0, b0));
+        acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(a1, b1));
+    }
+    sum = _mm512_reduce_add_epi32(_mm512_add_epi32(acc0, acc1));
+#elif defined(__AVX2__)
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+        const __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)));
+        const __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 16)));
+        const __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i + 16)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(a0, b0));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(a1, b1));
+    }
+    const __m256i acc = _mm256_add_epi32(acc0, acc1);
+    __m128i s4 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0x4E));
+    s4 = _mm_add_epi32(s4, _mm_shuffle_epi32(s4, 0xB1));
+    sum = _mm_cvtsi128_si32(s4);
+#endif
+    for (; i < n; ++i) sum += static_cast<std::int32_t>(x[i]) * static_cast<std::int32_t>(y[i]);
+    return sum;
+}
+
+/// int32 lanes cannot overflow within a block (|x*y| <= 2^14, 2^16 elements);
+/// block sums are widened to int64.
+constexpr std::size_t kI8Block = std::size_t(1) << 16;
+
+std::int64_t dot_i8_range(const std::int8_t* x, const std::int8_t* y, std::size_t n) {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < n; i += kI8Block) {
+        sum += dot_i8_block(x + i, y + i, std::min(kI8Block, n - i));
+    }
+    return sum;
+}
+
+std::int64_t dot_i8(const std::int8_t* x, const std::int8_t* y, std::size_t n) {
+    std::int64_t sum = 0;
+    #pragma omp parallel reduction(+:sum)
+    {
+        std::size_t lo = 0, hi = 0;
+        thread_slice(n, 64, lo, hi);
+        if (hi > lo) sum += dot_i8_range(x + lo, y + lo, hi - lo);
+    }
+    return sum;
+}
+
+// ---------- saxpy (auto-vectorized; the conversions are plain shifts/adds; fp64 is compute_saxpy_kernel) ----------
+
+void saxpy_f32(float a, const float* x, const float* y, float* out, std::size_t n) {
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) out[i] = a * x[i] + y[i];
+}
+
+/// bf16 in/out, fp32 arithmetic, round-to-nearest-even on store.
+void saxpy_bf16(float a, const bf16_t* x, const bf16_t* y, bf16_t* out, std::size_t n) {
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        out[i] = float_to_bf16(a * bf16_to_float(x[i]) + bf16_to_float(y[i]));
+    }
+}
+
+/// int8 in, int32 out: out = a * x + y (no saturation needed at int32).
+void saxpy_i8(std::int32_t a, const std::int8_t* x, const std::int8_t* y, std::int32_t* out, std::size_t n) {
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        out[i] = a * static_cast<std::int32_t>(x[i]) + static_cast<std::int32_t>(y[i]);
+    }
+}
+
+/// Reference dot and sum |x_i * y_i| of the values as stored in one format.
+struct DotReference {
+    double value = 0.0;
+    double abs_sum = 0.0;
+};
+
+/**
+ * @brief Neumaier-compensated long double dot of `prod(i)`, i in [0, n).
+ *
+ * Accurate to about one ulp of fp64 for these inputs; abs_sum scales the
+ * a-priori error bound the timed results are checked against.
+ */
+template <class Product>
+DotReference reference_dot(std::size_t n, Product prod) {
+    long double s = 0.0L, c = 0.0L, a = 0.0L;
+    for (std::size_t i = 0; i < n; ++i) {
+        const long double p = prod(i);
+        const long double t = s + p;
+        c += (std::fabs(s) >= std::fabs(p)) ? (s - t) + p : (p - t) + s;
+        s = t;
+        a += std::fabs(p);
+    }
+    return {static_cast<double>(s + c), static_cast<double>(a)};
+}
+
+/**
+ * @brief Warmup + timed loop around `body`, returning a Point with timing filled.
+ */
+BenchmarkResult::Point time_body(const Config& conf, const std::string& kernel,
+                                 const std::function<double()>& body) {
+    double checksum = 0.0;
+    for (int w = 0; w < conf.warmup; ++w) {
+        checksum = body();
+        do_not_optimize_away(checksum);
+    }
+
+    std::vector<long long> samples;
+    samples.reserve(conf.iters);
+    for (int it = 0; it < conf.iters; ++it) {
+        Timer t;
+        clobber_memory();
+        t.start();
+
+        checksum = body();
+
+        clobber_memory();
+        samples.push_back(t.elapsed_ns());
+        do_not_optimize_away(checksum);
+    }
+
+    BenchmarkResult::Point pt;
+    pt.kernel = kernel;
+    BenchmarkResult::fill_timing(pt, samples);
+    pt.checksum = checksum;
+    return pt;
+}
+
+} // namespace
+
+/**
+ * @brief Mixed / low-precision dot and saxpy for --kernel precision.
+ *
+ * The same n = --size / 8 random values are stored as fp64, fp32 and bf16,
+ * so the memory-bound gain of narrower storage shows directly in time and
+ * GB/s; int8 gets its own small integers k in [-8, 8]. fp64 runs the shared
+ * compute_dot_kernel / compute_saxpy_kernel. Variants:
+ *
+ * - dot   : fp64, fp32 (fp32 accumulation), bf16 (fp32 accumulation),
+ *           int8 x int8 -> int32
+ * - saxpy : fp64, fp32, bf16 (fp32 arithmetic, RNE store), int8 -> int32
+ *
+ * Floating-point inputs have random signs and magnitudes 2^-12 .. 2^13, so
+ * the sums cancel and round like real data. Outside the timed region each
+ * dot row reports rel_error against a compensated long double dot of the
+ * fp64 values (storage + accumulation error) and accum_rel_error against
+ * the same reference on the values as stored in that format (accumulation
+ * error only); a result outside the a-priori bound 2 n u sum|x y| of its
+ * format is reported as CRITICAL. int8 is checked for exact equality.
+ * saxpy rows report the sampled norm-wise error against fp64.
+ *
+ * GFLOP/s counts 2 ops per element (GOP/s for int8), as does ops_per_sec;
+ * GB/s counts the stored bytes read and written.
+ *
+ * @param conf The parsed configuration (size, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_precision_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+    const std::size_t n = static_cast<std::size_t>(size_bytes / sizeof(double));
+    if (n == 0) {
+        std::cerr << "Error: --size too small (" << size_bytes << " bytes)\n";
+        return;
+    }
+
+    const std::size_t alignment = 64;
+    benchmark::AlignedBuffer<double> x64(n, alignment), y64(n, alignment), o64(n, alignment);
+    benchmark::AlignedBuffer<float> x32(n, alignment), y32(n, alignment), o32(n, alignment);
+    benchmark::AlignedBuffer<bf16_t> xbf(n, alignment), ybf(n, alignment), obf(n, alignment);
+    benchmark::AlignedBuffer<std::int8_t> x8(n, alignment), y8(n, alignment);
+    benchmark::AlignedBuffer<std::int32_t> o8(n, alignment);
+
+    // Values are generated serially (reproducible for --seed), then written by
+    // the OpenMP team so the pages are first-touched where they are streamed.
+    std::vector<double> fx(n), fy(n);
+    std::vector<std::int8_t> kx(n), ky(n);
+    {
+        std::mt19937_64 rng(static_cast<std::uint64_t>(conf.seed));
+        std::uniform_real_distribution<double> mant(1.0, 2.0);
+        std::uniform_int_distribution<int> expo(-12, 12);
+        std::bernoulli_distribution sign(0.5);
+        std::uniform_int_distribution<int> small(-8, 8);
+        for (std::size_t i = 0; i < n; ++i) {
+            fx[i] = (sign(rng) ? -1.0 : 1.0) * std::ldexp(mant(rng), expo(rng));
+            fy[i] = (sign(rng) ? -1.0 : 1.0) * std::ldexp(mant(rng), expo(rng));
+            kx[i] = static_cast<std::int8_t>(small(rng));
+            ky[i] = static_cast<std::int8_t>(small(rng));
+        }
+    }
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        x64[i] = fx[i];
+        y64[i] = fy[i];
+        x32[i] = static_cast<float>(fx[i]);
+        y32[i] = static_cast<float>(fy[i]);
+        xbf[i] = float_to_bf16(x32[i]);
+        ybf[i] = float_to_bf16(y32[i]);
+        x8[i] = kx[i];
+        y8[i] = ky[i];
+        o64[i] = 0.0;
+        o32[i] = 0.0f;
+        obf[i] = 0;
+        o8[i] = 0;
+    }
+
+    // ---- references (outside the timed region) ----
+    const DotReference ref64 = reference_dot(n, [&](std::size_t i) {
+        return static_cast<long double>(x64[i]) * static_cast<long double>(y64[i]);
+    });
+    const DotReference ref32 = reference_dot(n, [&](std::size_t i) {
+        return static_cast<long double>(x32[i]) * static_cast<long double>(y32[i]);
+    });
+    const DotReference refbf = reference_dot(n, [&](std::size_t i) {
+        return static_cast<long double>(bf16_to_float(xbf[i])) * static_cast<long double>(bf16_to_float(ybf[i]));
+    });
+    std::int64_t exact_i8 = 0;
+    for (std::size_t i = 0; i < n; ++i) exact_i8 += static_cast<std::int64_t>(kx[i]) * ky[i];
+
+    auto rel = [](double v, double ref) { return (ref != 0.0) ? std::abs(v - ref) / std::abs(ref) : std::abs(v); };
+
+    auto finish = [&](BenchmarkResult::Point pt, std::size_t elem_bytes, double streams) {
+        const double ops = 2.0 * static_cast<double>(n);
+        const double bytes = streams * static_cast<double>(n) * static_cast<double>(elem_bytes);
+        pt.bytes = n * elem_bytes;
+        pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? bytes / pt.median_ns : 0.0;
+        pt.ops_per_sec = (pt.median_ns > 0.0) ? ops / pt.median_ns * 1e9 : 0.0;
+        // The 1-byte rows are int8: integer ops, reported as GOP/s rather than GFLOP/s.
+        const std::string rate_key = (elem_bytes == sizeof(std::int8_t)) ? "gops" : "gflops";
+        pt.extra[rate_key] = (pt.median_ns > 0.0) ? ops / pt.median_ns : 0.0;
+        pt.extra["elem_bytes"] = static_cast<double>(elem_bytes);
+        std::cout << "[Precision] " << pt.kernel << " " << rate_key << "=" << pt.extra[rate_key]
+                  << " GB/s=" << pt.bandwidth_gb_s;
+        if (pt.extra.count("rel_error")) std::cout << " rel_error=" << pt.extra["rel_error"];
+        std::cout << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    };
+
+    /// Dot row: error vs fp64 and vs the stored values; `unit` is the
+    /// accumulator's unit roundoff for the a-priori bound.
+    auto finish_dot = [&](BenchmarkResult::Point pt, std::size_t elem_bytes, double value,
+                          const DotReference& stored, double unit) {
+        pt.extra["rel_error"] = rel(value, ref64.value);
+        pt.extra["accum_rel_error"] = rel(value, stored.value);
+        const double bound = 2.0 * static_cast<double>(n) * unit * stored.abs_sum;
+        if (!(std::abs(value - stored.value) <= bound)) {
+            std::cerr << "CRITICAL: Validation failed for " << pt.kernel << ": got=" << value
+                      << " reference=" << stored.value << " bound=" << bound << "\n";
+        }
+        finish(std::move(pt), elem_bytes, 2.0);
+    };
+
+    const double u64 = std::ldexp(1.0, -53), u32 = std::ldexp(1.0, -24);
+
+    // ---- dot ----
+    const int team = default_team_size();
+    double v = compute_dot_kernel(x64.data(), y64.data(), n, team);
+    finish_dot(time_body(conf, "precision_dot_f64", [&] { return compute_dot_kernel(x64.data(), y64.data(), n, team); }),
+               sizeof(double), v, ref64, u64);
+    v = dot_f32(x32.data(), y32.data(), n);
+    finish_dot(time_body(conf, "precision_dot_f32", [&] { return static_cast<double>(dot_f32(x32.data(), y32.data(), n)); }),
+               sizeof(float), v, ref32, u32);
+    v = dot_bf16(xbf.data(), ybf.data(), n);
+    finish_dot(time_body(conf, "precision_dot_bf16", [&] { return static_cast<double>(dot_bf16(xbf.data(), ybf.data(), n)); }),
+               sizeof(bf16_t), v, refbf, u32);
+    const std::int64_t got_i8 = dot_i8(x8.data(), y8.data(), n);
+    {
+        BenchmarkResult::Point pt =
+            time_body(conf, "precision_dot_i8", [&] { return static_cast<double>(dot_i8(x8.data(), y8.data(), n)); });
+        pt.extra["rel_error"] = rel(static_cast<double>(got_i8), static_cast<double>(exact_i8));
+        if (got_i8 != exact_i8) {
+            std::cerr << "CRITICAL: Validation failed for precision_dot_i8: got=" << got_i8
+                      << " expected=" << exact_i8 << "\n";
+        }
+        finish(std::move(pt), sizeof(std::int8_t), 2.0);
+    }
+
+    // ---- saxpy ----
+    BenchmarkResult::Point p64 = time_body(conf, "precision_saxpy_f64", [&] {
+        compute_saxpy_kernel(0.5, x64.data(), y64.data(), o64.data(), n, team);
+        return o64[n / 2];
+    });
+    BenchmarkResult::Point p32 = time_body(conf, "precision_saxpy_f32", [&] {
+        saxpy_f32(0.5f, x32.data(), y32.data(), o32.data(), n);
+        return static_cast<double>(o32[n / 2]);
+    });
+    BenchmarkResult::Point pbf = time_body(conf, "precision_saxpy_bf16", [&] {
+        saxpy_bf16(0.5f, xbf.data(), ybf.data(), obf.data(), n);
+        return static_cast<double>(bf16_to_float(obf[n / 2]));
+    });
+    BenchmarkResult::Point pi8 = time_body(conf, "precision_saxpy_i8", [&] {
+        saxpy_i8(2, x8.data(), y8.data(), o8.data(), n);
+        return static_cast<double>(o8[n / 2]);
+    });
+
+    // Correctness and accuracy (outside timed region), on a sample of elements:
+    // each format must be within one rounding of its own inputs (two for bf16:
+    // fp32 arithmetic, then the bf16 store); the error vs fp64 is norm-wise.
+    const std::size_t stride = std::max<std::size_t>(1, n / 1024);
+    double ref_norm = 0.0, err32 = 0.0, errbf = 0.0;
+    bool saxpy_ok = true;
+    for (std::size_t i = 0; i < n && saxpy_ok; i += stride) {
+        const double want64 = 0.5 * x64[i] + y64[i];
+        const double want32 = 0.5 * static_cast<double>(x32[i]) + static_cast<double>(y32[i]);
+        const double wantbf = 0.5 * static_cast<double>(bf16_to_float(xbf[i])) + bf16_to_float(ybf[i]);
+        const double got_bf = bf16_to_float(obf[i]);
+        if (std::abs(o64[i] - want64) > 2.0 * u64 * std::abs(want64) ||
+            std::abs(o32[i] - want32) > 2.0 * u32 * std::abs(want32) ||
+            std::abs(got_bf - wantbf) > std::ldexp(1.0, -7) * std::abs(wantbf) ||
+            o8[i] != 2 * kx[i] + ky[i]) {
+            std::cerr << "CRITICAL: Validation failed for precision saxpy at i=" << i << "\n";
+            saxpy_ok = false;
+        }
+        ref_norm += std::abs(o64[i]);
+        err32 += std::abs(o32[i] - o64[i]);
+        errbf += std::abs(got_bf - o64[i]);
+    }
+    p64.extra["rel_error"] = 0.0;
+    p32.extra["rel_error"] = (ref_norm > 0.0) ? err32 / ref_norm : 0.0;
+    pbf.extra["rel_error"] = (ref_norm > 0.0) ? errbf / ref_norm : 0.0;
+    finish(std::move(p64), sizeof(double), 3.0);
+    finish(std::move(p32), sizeof(float), 3.0);
+    finish(std::move(pbf), sizeof(bf16_t), 3.0);
+    // int8 inputs, int32 output: 1 + 1 + 4 bytes per element.
+    finish(std::move(pi8), sizeof(std::int8_t), 6.0);
+}
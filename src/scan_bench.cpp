@@ -0,0 +1,352 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+std::function<double(double)> stream_copy_reference(const Config& conf);
+
+namespace {
+
+using Elem = std::int64_t; // same width as CsrMatrix::row_ptr
+
+void cpu_relax() {
+#if defined(__SSE2__)
+    _mm_pause();
+#endif
+}
+
+// ---------- Chunk primitives: every variant is built from these ----------
+
+Elem chunk_sum(const Elem* in, std::size_t n) {
+    Elem s = 0;
+    for (std::size_t i = 0; i < n; ++i) s += in[i];
+    return s;
+}
+
+/// Scan in[0, n) into out starting from `carry`; returns carry + sum(in).
+Elem scan_chunk_scalar(const Elem* in, Elem* out, std::size_t n, Elem carry, bool exclusive) {
+    if (exclusive) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = carry;
+            carry += in[i];
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            carry += in[i];
+            out[i] = carry;
+        }
+    }
+    return carry;
+}
+
+#if defined(__AVX2__)
+/**
+ * @brief AVX2 in-register scan, 4 x int64 per step.
+ *
+ * log2(4) = 2 shift-and-add steps build the lane-local inclusive scan
+ * (shift by one lane: permute + blend in zero; by two: 128-bit lane move)
+ * and the running carry is added. The carry advances by the broadcast
+ * block total, computed off the loop-carried chain, so the chain is one
+ * vector add per 4 elements. Exclusive output subtracts the input back out.
+ */
+Elem scan_chunk_simd(const Elem* in, Elem* out, std::size_t n, Elem carry, bool exclusive) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i c = _mm256_set1_epi64x(carry);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i x = _mm256_add_epi64(
+            v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+        x = _mm256_add_epi64(x, _mm256_permute2x128_si256(x, x, 0x08));
+        const __m256i total = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+        x = _mm256_add_epi64(x, c);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), exclusive ? _mm256_sub_epi64(x, v) : x);
+        c = _mm256_add_epi64(c, total);
+    }
+    carry = static_cast<Elem>(_mm_cvtsi128_si64(_mm256_castsi256_si128(c)));
+    return scan_chunk_scalar(in + i, out + i, n - i, carry, exclusive);
+}
+#endif
+
+using ChunkScan = Elem (*)(const Elem*, Elem*, std::size_t, Elem, bool);
+
+/// Chunk scan used inside the parallel variants: SIMD when compiled for AVX2.
+#if defined(__AVX2__)
+constexpr ChunkScan kParallelChunk = scan_chunk_simd;
+#else
+constexpr ChunkScan kParallelChunk = scan_chunk_scalar;
+#endif
+
+// ---------- Two-pass blocked (reduce, then scan) ----------
+
+struct alignas(64) Partial {
+    Elem sum = 0;
+};
+
+/**
+ * @brief Reduce-then-scan: each thread sums its contiguous block, one
+ * barrier, then scans its block seeded with the sum of all earlier blocks.
+ *
+ * Reads the input twice (3 x N elements of traffic once the input no longer
+ * fits in cache) but synchronizes exactly once.
+ */
+void scan_two_pass(const Elem* in, Elem* out, std::size_t n, bool exclusive, Partial* partial, int threads) {
+    #pragma omp parallel num_threads(threads)
+    {
+        std::size_t tid, nt;
+        team_position(tid, nt);
+        const std::size_t lo = n * tid / nt, hi = n * (tid + 1) / nt;
+        partial[tid].sum = chunk_sum(in + lo, hi - lo);
+        #pragma omp barrier
+        Elem offset = 0;
+        for (std::size_t t = 0; t < tid; ++t) offset += partial[t].sum;
+        kParallelChunk(in + lo, out + lo, hi - lo, offset, exclusive);
+    }
+}
+
+// ---------- Single-pass decoupled look-back ----------
+
+enum TileFlag : int { kInvalid = 0, kAggregate = 1, kPrefix = 2 };
+
+/// Per-tile look-back descriptor; the values are published by the release store of `flag`.
+struct alignas(64) TileStatus {
+    std::atomic<int> flag{kInvalid};
+    Elem aggregate = 0; // sum of this tile
+    Elem prefix = 0;    // inclusive prefix through this tile
+};
+
+/**
+ * @brief Single-pass scan with decoupled look-back (Merrill & Garland).
+ *
+ * Tiles are handed out in order by an atomic counter. A tile publishes its
+ * own sum, then walks back over its predecessors adding aggregates until
+ * it meets a published inclusive prefix, publishes its own prefix and
+ * scans. Each tile is read twice but the second read hits cache, so the
+ * input streams from memory once; the cost is the look-back spin instead
+ * of a global barrier.
+ */
+void scan_lookback(const Elem* in, Elem* out, std::size_t n, std::size_t tile, bool exclusive, TileStatus* status,
+                   int threads) {
+    const std::size_t tiles = (n + tile - 1) / tile;
+    for (std::size_t t = 0; t < tiles; ++t) status[t].flag.store(kInvalid, std::memory_order_relaxed);
+    std::atomic<std::size_t> next{0};
+
+    #pragma omp parallel num_threads(threads)
+    {
+        for (;;) {
+            const std::size_t t = next.fetch_add(1, std::memory_order_relaxed);
+            if (t >= tiles) break;
+            const std::size_t lo = t * tile, hi = std::min(n, lo + tile);
+            TileStatus& self = status[t];
+            if (t == 0) {
+                self.prefix = kParallelChunk(in, out, hi, 0, exclusive);
+                self.flag.store(kPrefix, std::memory_order_release);
+                continue;
+            }
+            const Elem agg = chunk_sum(in + lo, hi - lo);
+            self.aggregate = agg;
+            self.flag.store(kAggregate, std::memory_order_release);
+
+            Elem offset = 0;
+            for (std::size_t p = t; p-- > 0;) {
+                int f;
+                while ((f = status[p].flag.load(std::memory_order_acquire)) == kInvalid) cpu_relax();
+                if (f == kPrefix) {
+                    offset += status[p].prefix;
+                    break;
+                }
+                offset += status[p].aggregate;
+            }
+            self.prefix = offset + agg;
+            self.flag.store(kPrefix, std::memory_order_release);
+            kParallelChunk(in + lo, out + lo, hi - lo, offset, exclusive);
+        }
+    }
+}
+
+/**
+ * @brief Time every scan variant for one array of n elements, both modes.
+ *
+ * Sequential and SIMD run single-threaded; the two-pass and look-back
+ * variants run on each entry of `thread_counts`. Every (variant, threads)
+ * pair is validated against the serial scan before timing.
+ */
+void run_scan_case(const Config& conf, BenchmarkResult& res, std::size_t n, std::size_t tile,
+                   const std::vector<int>& thread_counts, const std::function<double(double)>& copy_at,
+                   json& table) {
+    benchmark::AlignedBuffer<Elem> in(n, 64), out(n, 64);
+    std::mt19937_64 rng(conf.seed);
+    std::uniform_int_distribution<int> dist(0, 15); // row-length-like counts
+    for (std::size_t i = 0; i < n; ++i) in[i] = dist(rng);
+
+    const int max_threads = thread_counts.empty() ? 1 : thread_counts.back();
+    std::vector<Partial> partial(static_cast<std::size_t>(max_threads));
+    const std::size_t tiles = (n + tile - 1) / tile;
+    std::unique_ptr<TileStatus[]> status(new TileStatus[tiles]);
+
+    const double bytes = 2.0 * static_cast<double>(n * sizeof(Elem)); // read once, written once
+    const double copy = copy_at(bytes);
+    json& row = table["sizes"][std::to_string(n)];
+    row["bytes"] = bytes;
+    row["copy_gb_s"] = copy;
+
+    struct Variant {
+        const char* name;
+        bool parallel;
+        std::function<void(bool, int)> body; // (exclusive, threads)
+    };
+    std::vector<Variant> variants = {
+        {"sequential", false, [&](bool ex, int) { scan_chunk_scalar(in.data(), out.data(), n, 0, ex); }},
+#if defined(__AVX2__)
+        {"simd", false, [&](bool ex, int) { scan_chunk_simd(in.data(), out.data(), n, 0, ex); }},
+#endif
+        {"two_pass", true,
+         [&](bool ex, int th) { scan_two_pass(in.data(), out.data(), n, ex, partial.data(), th); }},
+        {"lookback", true,
+         [&](bool ex, int th) { scan_lookback(in.data(), out.data(), n, tile, ex, status.get(), th); }},
+    };
+
+    for (const bool exclusive : {false, true}) {
+        const std::string mode = exclusive ? "exclusive" : "inclusive";
+        double best_gb_s = 0.0;
+        std::string best;
+        for (const Variant& v : variants) {
+            const std::vector<int> counts = v.parallel ? thread_counts : std::vector<int>{1};
+            for (const int threads : counts) {
+                const std::string name = std::string("scan_") + (exclusive ? "excl" : "incl") + "_" + v.name;
+
+                // Validate one call against the serial running sum.
+                std::fill(out.data(), out.data() + n, Elem(-1));
+                v.body(exclusive, threads);
+                bool ok = true;
+                Elem run = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const Elem expect = exclusive ? run : run + in[i];
+                    run += in[i];
+                    if (out[i] != expect) {
+                        ok = false;
+                        break;
+                    }
+                }
+                if (!ok) {
+                    std::cerr << "CRITICAL: Validation failed for " << name << " at n=" << n
+                              << " threads=" << threads << "\n";
+                }
+
+                for (int w = 0; w < conf.warmup; ++w) v.body(exclusive, threads);
+
+                std::vector<long long> samples;
+                samples.reserve(conf.iters);
+                for (int it = 0; it < conf.iters; ++it) {
+                    Timer t;
+                    clobber_memory();
+                    t.start();
+
+                    v.body(exclusive, threads);
+
+                    clobber_memory();
+                    samples.push_back(t.elapsed_ns());
+                }
+
+                BenchmarkResult::Point pt;
+                pt.kernel = name;
+                pt.bytes = n * sizeof(Elem); // one array
+                BenchmarkResult::fill_timing(pt, samples);
+                const std::size_t stride = std::max<std::size_t>(1, n / 1024);
+                for (std::size_t i = 0; i < n; i += stride) pt.checksum += static_cast<double>(out[i]);
+
+                pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? bytes / pt.median_ns : 0.0;
+                pt.extra["n"] = static_cast<double>(n);
+                pt.extra["threads"] = threads;
+                pt.extra["copy_gb_s"] = copy;
+                if (copy > 0.0) pt.extra["pct_of_copy"] = 100.0 * pt.bandwidth_gb_s / copy;
+                if (std::string(v.name) == "lookback") pt.extra["tile"] = static_cast<double>(tile);
+
+                json& cell = row[mode][v.name][std::to_string(threads)];
+                cell["gb_s"] = pt.bandwidth_gb_s;
+                if (copy > 0.0) cell["pct_of_copy"] = 100.0 * pt.bandwidth_gb_s / copy;
+                cell["valid"] = ok;
+                if (pt.bandwidth_gb_s > best_gb_s) {
+                    best_gb_s = pt.bandwidth_gb_s;
+                    best = std::string(v.name) + "@" + std::to_string(threads);
+                }
+
+                std::cout << "[Scan] " << mode << " " << v.name << " n=" << n << " threads=" << threads
+                          << " GB/s=" << pt.bandwidth_gb_s;
+                if (copy > 0.0) std::cout << " pct_of_copy=" << 100.0 * pt.bandwidth_gb_s / copy;
+                std::cout << "\n";
+                res.sweep_points.push_back(std::move(pt));
+            }
+        }
+        row[mode]["best"] = best;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Prefix-sum runner for --kernel scan.
+ *
+ * Inclusive and exclusive scans of int64 counts (the CSR row_ptr type)
+ * over arrays whose input + output footprint steps 32 KB, 128 KB, ..
+ * (x4) up to --size. Variants: sequential, AVX2 in-register (single
+ * thread), two-pass reduce-then-scan and single-pass decoupled look-back
+ * (tiles of a quarter of L2); the parallel variants run on 1, 2, 4 ..
+ * --threads threads and use the SIMD chunk scan when available.
+ *
+ * Effective bandwidth counts each element read once and written once
+ * (2 x array bytes), the minimum any scan must move, and is reported as a
+ * percentage of STREAM Copy measured in the same run at the closest
+ * footprint. Two-pass reads the input twice, so it tops out near 2/3 of
+ * Copy once the array leaves cache; look-back can approach Copy.
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_scan_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    // ---- STREAM Copy reference, same process ----
+    const std::function<double(double)> copy_at = stream_copy_reference(conf);
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const std::size_t l2 = sys.cache_l2_bytes ? static_cast<std::size_t>(sys.cache_l2_bytes) : 1024 * 1024;
+    // Tile input + output stay in L2 between the aggregate and the scan pass.
+    const std::size_t tile = std::max<std::size_t>(1024, l2 / 4 / sizeof(Elem));
+
+    json& table = res.extra_stats["scan"];
+    table["threads"] = thread_counts;
+    table["lookback_tile"] = tile;
+    for (std::uint64_t footprint = 32 * 1024; footprint <= size_bytes; footprint *= 4) {
+        const std::size_t n = static_cast<std::size_t>(footprint / (2 * sizeof(Elem)));
+        run_scan_case(conf, res, n, tile, thread_counts, copy_at, table);
+    }
+}
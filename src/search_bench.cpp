@@ -0,0 +1,355 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using Key = std::int32_t;
+
+constexpr Key kNone = std::numeric_limits<Key>::max();      // "no key >= x"; also the padding key
+constexpr std::size_t kLookups = std::size_t(1) << 20;      // lookups per timed call
+constexpr std::size_t kNodeKeys = 64 / sizeof(Key);         // B+tree node: one cache line of keys
+constexpr std::size_t kMapLimitBytes = std::size_t(1) << 30; // skip std::map above this (est. 48 B/node)
+
+/**
+ * @brief Index of the lowest set bit (portable ctz; `m` must be non-zero).
+ */
+inline unsigned ctz64(std::uint64_t m) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(m));
+#else
+    unsigned k = 0;
+    for (; !(m & 1u); m >>= 1) ++k;
+    return k;
+#endif
+}
+
+// ---------- Sorted array ----------
+
+Key search_std(const Key* a, std::size_t n, Key x) {
+    const Key* it = std::lower_bound(a, a + n, x);
+    return it == a + n ? kNone : *it;
+}
+
+/**
+ * @brief Branchless binary search: the loop trip count depends only on n.
+ *
+ * The halving step adds `half` masked by the comparison (setcc / neg /
+ * and). The obvious `cond ? base + half : base` is compiled by GCC 12 at
+ * -O3 to a conditional jump, which mispredicts like std::lower_bound.
+ */
+Key search_branchless(const Key* a, std::size_t n, Key x) {
+    const Key* base = a;
+    std::size_t len = n;
+    while (len > 1) {
+        const std::size_t half = len / 2;
+        base += (std::size_t(0) - static_cast<std::size_t>(base[half - 1] < x)) & half;
+        len -= half;
+    }
+    const Key* it = base + (*base < x);
+    return it == a + n ? kNone : *it;
+}
+
+// ---------- Eytzinger (BFS-order) array ----------
+
+/**
+ * @brief Eytzinger layout: 1-based heap order, children of k at 2k and 2k + 1.
+ *
+ * The first four levels of every search sit in a few lines, and the 16
+ * great-great-grandchildren of k share one 64 B line (b is 64-byte aligned),
+ * so the search prefetches that line four levels ahead.
+ */
+struct Eytzinger {
+    explicit Eytzinger(const std::vector<Key>& sorted) : n(sorted.size()), b(sorted.size() + 1, 64) {
+        b[0] = kNone;
+        std::size_t i = 0;
+        fill(sorted, i, 1);
+    }
+
+    Key search(Key x) const {
+        std::size_t k = 1;
+        while (k <= n) {
+            prefetch_read(b.data() + k * kNodeKeys);
+            k = 2 * k + (b[k] < x);
+        }
+        k >>= ctz64(~static_cast<std::uint64_t>(k)) + 1; // undo the trailing right turns
+        return k ? b[k] : kNone;
+    }
+
+    std::size_t n;
+    benchmark::AlignedBuffer<Key> b;
+
+private:
+    void fill(const std::vector<Key>& sorted, std::size_t& i, std::size_t k) {
+        if (k > n) return;
+        fill(sorted, i, 2 * k);
+        b[k] = sorted[i++];
+        fill(sorted, i, 2 * k + 1);
+    }
+};
+
+// ---------- Implicit static B+tree ----------
+
+/**
+ * @brief Implicit (pointer-free) static B+tree with one-cache-line nodes.
+ *
+ * Layer 0 holds the sorted keys padded to whole 16-key nodes; each upper
+ * layer holds, for node p, the first key of children p(B+1)+1 ..
+ * p(B+1)+B. A lookup counts the node keys below x (two AVX2 compares)
+ * and descends to that child, reading one line per layer; at the leaf the
+ * answer is the key at that rank, possibly the first key of the next leaf.
+ */
+struct StaticBPlusTree {
+    static constexpr std::size_t B = kNodeKeys;
+
+    explicit StaticBPlusTree(const std::vector<Key>& sorted) {
+        std::vector<std::size_t> nodes{(sorted.size() + B - 1) / B + 1}; // + one padding leaf
+        while (nodes.back() > 1) nodes.push_back((nodes.back() + B) / (B + 1));
+        std::size_t total = 0;
+        for (const std::size_t c : nodes) {
+            offset.push_back(total);
+            total += c * B;
+        }
+        t = benchmark::AlignedBuffer<Key>(total, 64);
+        std::fill(t.data(), t.data() + total, kNone);
+        std::copy(sorted.begin(), sorted.end(), t.data());
+
+        // Span of one layer-h node in leaf nodes: (B+1)^h.
+        std::size_t span = 1;
+        for (std::size_t h = 1; h < nodes.size(); ++h) {
+            span *= B + 1;
+            const std::size_t child_span = span / (B + 1);
+            for (std::size_t p = 0; p < nodes[h]; ++p) {
+                for (std::size_t j = 0; j < B; ++j) {
+                    const std::size_t leaf = (p * (B + 1) + j + 1) * child_span;
+                    t[offset[h] + p * B + j] = leaf * B < sorted.size() ? sorted[leaf * B] : kNone;
+                }
+            }
+        }
+    }
+
+    static unsigned rank(const Key* node, Key x) {
+#if defined(__AVX2__)
+        const __m256i xv = _mm256_set1_epi32(x);
+        const __m256i lo = _mm256_cmpgt_epi32(xv, _mm256_load_si256(reinterpret_cast<const __m256i*>(node)));
+        const __m256i hi = _mm256_cmpgt_epi32(xv, _mm256_load_si256(reinterpret_cast<const __m256i*>(node + 8)));
+        const unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(lo))) |
+                           static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hi))) << 8;
+        return static_cast<unsigned>(__builtin_popcount(m));
+#else
+        unsigned r = 0;
+        for (std::size_t j = 0; j < B; ++j) r += node[j] < x;
+        return r;
+#endif
+    }
+
+    Key search(Key x) const {
+        std::size_t p = 0;
+        for (std::size_t h = offset.size() - 1; h > 0; --h) p = p * (B + 1) + rank(&t[offset[h] + p * B], x);
+        return t[p * B + rank(&t[p * B], x)];
+    }
+
+    std::size_t bytes() const { return (offset.back() + B) * sizeof(Key); }
+
+    std::vector<std::size_t> offset; // first key of each layer, leaves first
+    benchmark::AlignedBuffer<Key> t;
+};
+
+struct Layout {
+    const char* name;
+    std::function<std::uint64_t(const Key*, std::size_t)> run; // sum of answers over a query batch
+    std::size_t bytes;
+};
+
+template <class F>
+std::uint64_t sum_lookups(const Key* q, std::size_t m, F&& search) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < m; ++i) sum += static_cast<std::uint64_t>(search(q[i]));
+    return sum;
+}
+
+/**
+ * @brief Build every layout over n keys and time 2^20 lower_bound lookups.
+ */
+void run_search_case(const Config& conf, BenchmarkResult& res, benchmark::PerfCounters& perf, std::size_t n,
+                     json& table) {
+    // Distinct sorted keys: one random key per stride, so x in [0, 2^31) hits each gap uniformly.
+    const std::size_t stride = (std::size_t(1) << 31) / n;
+    std::mt19937_64 rng(static_cast<std::uint64_t>(conf.seed) ^ n);
+    std::uniform_int_distribution<std::size_t> jitter(0, stride - 2);
+    std::vector<Key> sorted(n);
+    for (std::size_t i = 0; i < n; ++i) sorted[i] = static_cast<Key>(i * stride + jitter(rng));
+
+    std::uniform_int_distribution<Key> any(0, kNone - 1);
+    std::vector<Key> q(kLookups);
+    for (Key& x : q) x = any(rng);
+
+    const Eytzinger eytz(sorted);
+    const StaticBPlusTree btree(sorted);
+    std::map<Key, std::uint32_t> tree;
+    const bool with_map = n * 48 <= kMapLimitBytes;
+    if (with_map) {
+        for (std::size_t i = 0; i < n; ++i) tree.emplace_hint(tree.end(), sorted[i], static_cast<std::uint32_t>(i));
+    }
+
+    const Key* a = sorted.data();
+    std::vector<Layout> layouts = {
+        {"sorted_std", [&](const Key* qs, std::size_t m) { return sum_lookups(qs, m, [&](Key x) { return search_std(a, n, x); }); },
+         n * sizeof(Key)},
+        {"sorted_branchless",
+         [&](const Key* qs, std::size_t m) { return sum_lookups(qs, m, [&](Key x) { return search_branchless(a, n, x); }); },
+         n * sizeof(Key)},
+        {"eytzinger", [&](const Key* qs, std::size_t m) { return sum_lookups(qs, m, [&](Key x) { return eytz.search(x); }); },
+         (n + 1) * sizeof(Key)},
+        {"bplus_tree", [&](const Key* qs, std::size_t m) { return sum_lookups(qs, m, [&](Key x) { return btree.search(x); }); },
+         btree.bytes()},
+    };
+    if (with_map) {
+        layouts.push_back({"std_map",
+                           [&](const Key* qs, std::size_t m) {
+                               return sum_lookups(qs, m, [&](Key x) {
+                                   const auto it = tree.lower_bound(x);
+                                   return it == tree.end() ? kNone : it->first;
+                               });
+                           },
+                           n * 48});
+    }
+
+    const std::uint64_t expect = sum_lookups(q.data(), q.size(), [&](Key x) { return search_std(a, n, x); });
+
+    json& row = table["sizes"][std::to_string(n)];
+    row["key_bytes"] = n * sizeof(Key);
+    row["btree_height"] = btree.offset.size();
+    double best_rate = 0.0;
+    for (const Layout& l : layouts) {
+        const std::string name = std::string("search_") + l.name;
+        std::uint64_t sum = l.run(q.data(), q.size());
+        const bool ok = sum == expect;
+        if (!ok) std::cerr << "CRITICAL: Validation failed for " << name << " at n=" << n << "\n";
+
+        for (int w = 0; w < conf.warmup; ++w) sum = l.run(q.data(), q.size());
+
+        std::vector<long long> samples;
+        samples.reserve(conf.iters);
+        perf.start();
+        for (int it = 0; it < conf.iters; ++it) {
+            Timer t;
+            clobber_memory();
+            t.start();
+
+            sum = l.run(q.data(), q.size());
+
+            clobber_memory();
+            samples.push_back(t.elapsed_ns());
+        }
+        perf.stop();
+        do_not_optimize_away(sum);
+
+        BenchmarkResult::Point pt;
+        pt.kernel = name;
+        pt.bytes = n * sizeof(Key);
+        BenchmarkResult::fill_timing(pt, samples);
+        pt.checksum = static_cast<double>(sum);
+
+        const double total = static_cast<double>(kLookups) * static_cast<double>(samples.size());
+        pt.ops_per_sec = (pt.median_ns > 0.0) ? static_cast<double>(kLookups) * 1e9 / pt.median_ns : 0.0;
+        pt.ns_per_access = pt.median_ns / static_cast<double>(kLookups);
+        pt.extra["keys"] = static_cast<double>(n);
+        pt.extra["layout_bytes"] = static_cast<double>(l.bytes);
+
+        json& cell = row[l.name];
+        cell["lookups_per_sec"] = pt.ops_per_sec;
+        cell["ns_per_lookup"] = pt.ns_per_access;
+        cell["layout_bytes"] = l.bytes;
+        cell["valid"] = ok;
+        if (perf.available(benchmark::PerfCounters::Cycles)) {
+            pt.extra["cycles_per_lookup"] = perf.value(benchmark::PerfCounters::Cycles) / total;
+            cell["cycles_per_lookup"] = pt.extra["cycles_per_lookup"];
+        }
+        if (perf.available(benchmark::PerfCounters::L1dReadMisses)) {
+            pt.extra["l1d_misses_per_lookup"] = perf.value(benchmark::PerfCounters::L1dReadMisses) / total;
+            cell["l1d_misses_per_lookup"] = pt.extra["l1d_misses_per_lookup"];
+        }
+        if (perf.available(benchmark::PerfCounters::LlcMisses)) {
+            pt.extra["llc_misses_per_lookup"] = perf.value(benchmark::PerfCounters::LlcMisses) / total;
+            cell["llc_misses_per_lookup"] = pt.extra["llc_misses_per_lookup"];
+        }
+        if (ok && pt.ops_per_sec > best_rate) {
+            best_rate = pt.ops_per_sec;
+            row["best"] = l.name;
+        }
+
+        std::cout << "[Search] " << l.name << " n=" << n << " ns_per_lookup=" << pt.ns_per_access
+                  << " Mlookups/s=" << pt.ops_per_sec / 1e6 << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Search-structure layout runner for --kernel search.
+ *
+ * lower_bound over n distinct sorted int32 keys, 32 KB, 128 KB, .. (x4)
+ * of keys up to --size, in five layouts: sorted array with std::lower_bound
+ * and with a branchless (cmov) binary search, Eytzinger order with a
+ * prefetch four levels ahead, an implicit static B+tree with 16-key
+ * (one cache line) nodes and AVX2 in-node rank, and std::map (skipped
+ * above ~1 GiB of nodes). Each timed call answers 2^20 uniform random
+ * queries, serially.
+ *
+ * Points report lookups/s (ops_per_sec) and ns per lookup, plus cycles,
+ * L1D read misses and LLC misses per lookup when perf counters are
+ * available; the fastest layout per size is in stats.search.
+ *
+ * @param conf The parsed configuration (size, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_search_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    std::vector<std::size_t> key_counts;
+    for (std::uint64_t b = 32 * 1024; b <= size_bytes && b / sizeof(Key) <= (std::size_t(1) << 28); b *= 4) {
+        key_counts.push_back(static_cast<std::size_t>(b / sizeof(Key)));
+    }
+    if (key_counts.empty()) {
+        std::cerr << "Error: --size must be at least 32KB for search\n";
+        return;
+    }
+
+    benchmark::PerfCounters perf;
+    if (!perf.available(benchmark::PerfCounters::LlcMisses)) {
+        std::cerr << "[Search] perf counters unavailable (check perf_event_paranoid); reporting ns only\n";
+    }
+
+    json& table = res.extra_stats["search"];
+    table["lookups_per_call"] = kLookups;
+    table["node_keys"] = kNodeKeys;
+    for (const std::size_t n : key_counts) run_search_case(conf, res, perf, n, table);
+}
@@ -0,0 +1,404 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kRadixBits = 8;
+constexpr std::size_t kBuckets = std::size_t(1) << kRadixBits;
+constexpr std::size_t kFewUnique = 16; // distinct keys in the few_unique distribution
+
+/// 64-bit key with a 64-bit payload; ordered by key only.
+struct KeyValue {
+    std::uint64_t key;
+    std::uint64_t value;
+    bool operator<(const KeyValue& o) const { return key < o.key; }
+};
+
+// ---------- Per-type traits: radix key, generation, naming ----------
+
+template <class T> struct SortTraits;
+
+template <> struct SortTraits<std::uint32_t> {
+    using Radix = std::uint32_t;
+    static constexpr const char* name = "u32";
+    static Radix radix(std::uint32_t v) { return v; }
+    static std::uint32_t make(std::uint64_t bits) { return static_cast<std::uint32_t>(bits); }
+};
+
+template <> struct SortTraits<std::uint64_t> {
+    using Radix = std::uint64_t;
+    static constexpr const char* name = "u64";
+    static Radix radix(std::uint64_t v) { return v; }
+    static std::uint64_t make(std::uint64_t bits) { return bits; }
+};
+
+template <> struct SortTraits<double> {
+    using Radix = std::uint64_t;
+    static constexpr const char* name = "f64";
+    /// IEEE-754 bits mapped to an unsigned order: flip the sign bit of
+    /// positives, all bits of negatives.
+    static Radix radix(double v) {
+        std::uint64_t b;
+        std::memcpy(&b, &v, sizeof(b));
+        return (b >> 63) ? ~b : (b | (std::uint64_t(1) << 63));
+    }
+    static double make(std::uint64_t bits) {
+        // Signed values spanning many binades, so every radix digit varies.
+        const double u = static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0); // [0, 1)
+        return (bits & 1 ? -1.0 : 1.0) * std::ldexp(1.0 + u, static_cast<int>((bits >> 1) % 64) - 32);
+    }
+};
+
+template <> struct SortTraits<KeyValue> {
+    using Radix = std::uint64_t;
+    static constexpr const char* name = "kv64";
+    static Radix radix(const KeyValue& v) { return v.key; }
+    static KeyValue make(std::uint64_t bits) { return {bits, 0}; }
+};
+
+/**
+ * @brief Input keys for one distribution.
+ *
+ * - uniform   : random bits (random doubles for f64)
+ * - sorted    : uniform, already ascending
+ * - reverse   : uniform, descending
+ * - few_unique: 16 distinct random keys
+ *
+ * KeyValue payloads are the element's original index, so validation can
+ * check that every pair survived intact.
+ */
+template <class T>
+std::vector<T> make_input(const std::string& dist, std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> v(n);
+    if (dist == "few_unique") {
+        std::uint64_t pool[kFewUnique];
+        for (std::uint64_t& p : pool) p = rng();
+        for (std::size_t i = 0; i < n; ++i) v[i] = SortTraits<T>::make(pool[rng() % kFewUnique]);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) v[i] = SortTraits<T>::make(rng());
+        if (dist == "sorted") std::sort(v.begin(), v.end());
+        if (dist == "reverse") std::sort(v.begin(), v.end(), [](const T& a, const T& b) { return b < a; });
+    }
+    if constexpr (std::is_same<T, KeyValue>::value) {
+        for (std::size_t i = 0; i < n; ++i) v[i].value = i;
+    }
+    return v;
+}
+
+// ---------- LSD radix sort ----------
+
+/**
+ * @brief LSD radix sort on 8-bit digits, ping-ponging between `a` and `tmp`.
+ *
+ * One pre-pass builds all digit histograms; passes whose digit is the same
+ * for every key are skipped. With `wc`, the scatter stages elements in one
+ * 64-byte-aligned line per bucket (16 KB total, L1-resident) that mirrors
+ * the destination line the bucket is currently filling, and copies it out
+ * when that line is complete: the 256 output streams become aligned
+ * full-line writes instead of one scattered store per key. Only the first
+ * line of each bucket (shared with the previous bucket's tail) and the
+ * last one are partial. `a` and `tmp` must be 64-byte aligned and
+ * sizeof(T) must divide 64. The result ends up in `a`.
+ */
+template <class T>
+void radix_sort(T* a, T* tmp, std::size_t n, bool wc) {
+    using Traits = SortTraits<T>;
+    using Radix = typename Traits::Radix;
+    constexpr std::size_t kPasses = sizeof(Radix) * 8 / kRadixBits;
+    constexpr std::size_t kLine = 64 / sizeof(T); // elements per write-combining line
+
+    std::vector<std::size_t> hist(kPasses * kBuckets, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Radix r = Traits::radix(a[i]);
+        for (std::size_t p = 0; p < kPasses; ++p) ++hist[p * kBuckets + ((r >> (p * kRadixBits)) & (kBuckets - 1))];
+    }
+
+    static_assert(64 % sizeof(T) == 0, "write-combining lines hold whole elements");
+
+    benchmark::AlignedBuffer<T> buf(wc ? kBuckets * kLine : 0, 64);
+    std::size_t head[kBuckets]; // first valid slot of each bucket's staged line
+    T* src = a;
+    T* dst = tmp;
+    for (std::size_t p = 0; p < kPasses; ++p) {
+        std::size_t* h = &hist[p * kBuckets];
+        if (std::any_of(h, h + kBuckets, [n](std::size_t c) { return c == n; })) continue; // one digit: no-op pass
+        std::size_t run = 0;
+        for (std::size_t d = 0; d < kBuckets; ++d) {
+            const std::size_t c = h[d];
+            h[d] = run;
+            run += c;
+        }
+        const unsigned shift = static_cast<unsigned>(p * kRadixBits);
+        if (!wc) {
+            for (std::size_t i = 0; i < n; ++i) dst[h[(Traits::radix(src[i]) >> shift) & (kBuckets - 1)]++] = src[i];
+        } else {
+            // Slot s of a staged line is element s of its destination line, so a
+            // bucket starting mid-line stages from its offset in that line.
+            for (std::size_t d = 0; d < kBuckets; ++d) head[d] = h[d] % kLine;
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::size_t d = (Traits::radix(src[i]) >> shift) & (kBuckets - 1);
+                T* line = &buf[d * kLine];
+                const std::size_t slot = h[d]++ % kLine;
+                line[slot] = src[i];
+                if (slot == kLine - 1) { // destination line complete
+                    if (head[d] == 0) {
+                        std::memcpy(dst + h[d] - kLine, line, sizeof(T) * kLine);
+                    } else { // leading partial line of the bucket
+                        std::memcpy(dst + h[d] - (kLine - head[d]), line + head[d], sizeof(T) * (kLine - head[d]));
+                        head[d] = 0;
+                    }
+                }
+            }
+            for (std::size_t d = 0; d < kBuckets; ++d) {
+                const std::size_t slot = h[d] % kLine;
+                if (slot > head[d]) {
+                    std::memcpy(dst + h[d] - (slot - head[d]), &buf[d * kLine] + head[d], sizeof(T) * (slot - head[d]));
+                }
+            }
+        }
+        std::swap(src, dst);
+    }
+    if (src != a) std::memcpy(a, src, sizeof(T) * n);
+}
+
+// ---------- OpenMP merge sort ----------
+
+/// Merge-path split: number of elements taken from `x` among the first k of merge(x, y); ties go to x.
+template <class T>
+std::size_t co_rank(const T* x, std::size_t nx, const T* y, std::size_t ny, std::size_t k) {
+    std::size_t lo = k > ny ? k - ny : 0, hi = std::min(k, nx);
+    while (lo < hi) {
+        const std::size_t i = lo + (hi - lo) / 2;
+        if (!(y[k - i - 1] < x[i])) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+/**
+ * @brief Parallel merge sort: std::sort on one contiguous run per thread,
+ * then log2(threads) rounds of pairwise merges.
+ *
+ * Every merge is cut into `threads` equal output segments with a
+ * merge-path binary search, so all threads stay busy down to the last
+ * round (a plain pairwise tree would leave half of them idle per round).
+ * The merges ping-pong between `a` and `tmp`; the result ends up in `a`.
+ */
+template <class T>
+void merge_sort_parallel(T* a, T* tmp, std::size_t n, int threads) {
+    const std::size_t runs = static_cast<std::size_t>(std::max(1, threads));
+    std::vector<std::size_t> bounds(runs + 1);
+    for (std::size_t r = 0; r <= runs; ++r) bounds[r] = n * r / runs;
+
+    #pragma omp parallel for num_threads(threads) schedule(static, 1)
+    for (long long r = 0; r < static_cast<long long>(runs); ++r) {
+        std::sort(a + bounds[static_cast<std::size_t>(r)], a + bounds[static_cast<std::size_t>(r) + 1]);
+    }
+
+    T* src = a;
+    T* dst = tmp;
+    while (bounds.size() > 2) {
+        const std::size_t pairs = (bounds.size() - 1) / 2;
+        const bool odd = (bounds.size() - 1) % 2 == 1;
+        const long long segs = static_cast<long long>(runs);
+        #pragma omp parallel num_threads(threads)
+        {
+            #pragma omp for collapse(2) schedule(static)
+            for (long long p = 0; p < static_cast<long long>(pairs); ++p) {
+                for (long long s = 0; s < segs; ++s) {
+                    const std::size_t lo = bounds[2 * static_cast<std::size_t>(p)];
+                    const std::size_t mid = bounds[2 * static_cast<std::size_t>(p) + 1];
+                    const std::size_t hi = bounds[2 * static_cast<std::size_t>(p) + 2];
+                    const T* x = src + lo;
+                    const T* y = src + mid;
+                    const std::size_t nx = mid - lo, ny = hi - mid, total = nx + ny;
+                    const std::size_t k0 = total * static_cast<std::size_t>(s) / runs;
+                    const std::size_t k1 = total * (static_cast<std::size_t>(s) + 1) / runs;
+                    const std::size_t i0 = co_rank(x, nx, y, ny, k0), i1 = co_rank(x, nx, y, ny, k1);
+                    std::merge(x + i0, x + i1, y + (k0 - i0), y + (k1 - i1), dst + lo + k0);
+                }
+            }
+            if (odd) {
+                const std::size_t lo = bounds[bounds.size() - 2], hi = bounds.back();
+                #pragma omp for schedule(static)
+                for (long long i = static_cast<long long>(lo); i < static_cast<long long>(hi); ++i) dst[i] = src[i];
+            }
+        }
+        std::vector<std::size_t> next;
+        for (std::size_t r = 0; r < bounds.size(); r += 2) next.push_back(bounds[r]);
+        if (next.back() != n) next.push_back(n);
+        bounds.swap(next);
+        std::swap(src, dst);
+    }
+    if (src != a) std::memcpy(a, src, sizeof(T) * n);
+}
+
+/**
+ * @brief Time every sort for one type, distribution and size; each sort is
+ * validated against std::sort (and, for key-value pairs, payload integrity)
+ * first. The input is restored outside the timed region.
+ */
+template <class T>
+void run_sort_case(const Config& conf, BenchmarkResult& res, const std::string& dist, std::size_t n,
+                   const std::vector<int>& thread_counts, json& table) {
+    using Traits = SortTraits<T>;
+    const std::vector<T> input = make_input<T>(dist, n, conf.seed);
+    std::vector<T> ref = input;
+    std::sort(ref.begin(), ref.end());
+    benchmark::AlignedBuffer<T> work(n, 64), tmp(n, 64);
+
+    struct Variant {
+        const char* name;
+        bool parallel;
+        std::function<void(int)> body;
+    };
+    const std::vector<Variant> variants = {
+        {"std_sort", false, [&](int) { std::sort(work.data(), work.data() + n); }},
+        {"radix", false, [&](int) { radix_sort(work.data(), tmp.data(), n, false); }},
+        {"radix_wc", false, [&](int) { radix_sort(work.data(), tmp.data(), n, true); }},
+        {"merge_omp", true, [&](int th) { merge_sort_parallel(work.data(), tmp.data(), n, th); }},
+    };
+
+    const std::string type = Traits::name;
+    json& row = table[type][dist][std::to_string(n)];
+    double best_rate = 0.0;
+    std::string best;
+    for (const Variant& v : variants) {
+        const std::vector<int> counts = v.parallel ? thread_counts : std::vector<int>{1};
+        for (const int threads : counts) {
+            const std::string name = "sort_" + type + "_" + dist + "_" + v.name;
+
+            std::copy(input.begin(), input.end(), work.data());
+            v.body(threads);
+            bool ok = true;
+            std::vector<bool> seen; // payloads are the input indices: each must appear exactly once
+            if constexpr (std::is_same<T, KeyValue>::value) seen.assign(n, false);
+            for (std::size_t i = 0; i < n && ok; ++i) {
+                ok = Traits::radix(work[i]) == Traits::radix(ref[i]);
+                if constexpr (std::is_same<T, KeyValue>::value) {
+                    const std::uint64_t idx = work[i].value;
+                    ok = ok && idx < n && !seen[idx] && input[idx].key == work[i].key;
+                    if (ok) seen[idx] = true;
+                }
+            }
+            if (!ok) {
+                std::cerr << "CRITICAL: Validation failed for " << name << " at n=" << n << " threads=" << threads
+                          << "\n";
+            }
+
+            for (int w = 0; w < conf.warmup; ++w) {
+                std::copy(input.begin(), input.end(), work.data());
+                v.body(threads);
+            }
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            for (int it = 0; it < conf.iters; ++it) {
+                std::copy(input.begin(), input.end(), work.data());
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                v.body(threads);
+
+                clobber_memory();
+                samples.push_back(t.elapsed_ns());
+            }
+
+            BenchmarkResult::Point pt;
+            pt.kernel = name;
+            pt.bytes = n * sizeof(T);
+            BenchmarkResult::fill_timing(pt, samples);
+            const std::size_t stride = std::max<std::size_t>(1, n / 1024);
+            for (std::size_t i = 0; i < n; i += stride) pt.checksum += static_cast<double>(Traits::radix(work[i]));
+
+            pt.ops_per_sec = (pt.median_ns > 0.0) ? static_cast<double>(n) * 1e9 / pt.median_ns : 0.0;
+            pt.extra["n"] = static_cast<double>(n);
+            pt.extra["threads"] = threads;
+
+            json& cell = row[v.name][std::to_string(threads)];
+            cell["keys_per_sec"] = pt.ops_per_sec;
+            cell["valid"] = ok;
+            if (pt.ops_per_sec > best_rate) {
+                best_rate = pt.ops_per_sec;
+                best = std::string(v.name) + "@" + std::to_string(threads);
+            }
+
+            std::cout << "[Sort] " << type << " " << dist << " " << v.name << " n=" << n << " threads=" << threads
+                      << " Mkeys/s=" << pt.ops_per_sec / 1e6 << "\n";
+            res.sweep_points.push_back(std::move(pt));
+        }
+    }
+    row["best"] = best;
+}
+
+template <class T>
+void run_sort_type(const Config& conf, BenchmarkResult& res, std::uint64_t size_bytes,
+                   const std::vector<int>& thread_counts, json& table) {
+    for (const char* dist : {"uniform", "sorted", "reverse", "few_unique"}) {
+        for (std::uint64_t bytes = 32 * 1024; bytes <= size_bytes; bytes *= 4) {
+            run_sort_case<T>(conf, res, dist, static_cast<std::size_t>(bytes / sizeof(T)), thread_counts, table);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Sort runner for --kernel sort.
+ *
+ * uint32, uint64, double and 64-bit key + 64-bit payload records; arrays
+ * of 32 KB, 128 KB, .. (x4) up to --size; uniform, sorted, reverse and
+ * 16-distinct-key inputs from --seed. Sorts: std::sort, LSD radix (8-bit
+ * digits, constant digits skipped) with direct or write-combining
+ * buffered scatter, and an OpenMP merge sort (per-thread std::sort runs,
+ * merge-path parallel merges) on 1, 2, 4 .. --threads threads.
+ *
+ * Points report keys/s (ops_per_sec); the fastest sort per type,
+ * distribution and size goes to stats.sort.
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_sort_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    json& table = res.extra_stats["sort"];
+    table["threads"] = thread_counts;
+    run_sort_type<std::uint32_t>(conf, res, size_bytes, thread_counts, table);
+    run_sort_type<std::uint64_t>(conf, res, size_bytes, thread_counts, table);
+    run_sort_type<double>(conf, res, size_bytes, thread_counts, table);
+    run_sort_type<KeyValue>(conf, res, size_bytes, thread_counts, table);
+}
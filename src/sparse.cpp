@@ -0,0 +1,234 @@
+#include "sparse.hpp"
+#include "timer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace benchmark {
+
+namespace {
+
+constexpr int kBandHalfWidth = 13;     // 27 diagonals
+constexpr std::size_t kRandomPerRow = 16;
+constexpr double kParetoAlpha = 1.5;
+constexpr double kParetoMin = 16.0 / 3.0; // mean = alpha * min / (alpha - 1) = 16
+constexpr std::size_t kPowerLawMaxRow = 1u << 14;
+
+/// Append one row of sorted, de-duplicated random columns with values in (-1, 1).
+void append_random_row(CsrMatrix& m, std::size_t len, std::mt19937_64& rng) {
+    std::uniform_int_distribution<std::int64_t> pick(0, static_cast<std::int64_t>(m.cols) - 1);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::vector<std::int32_t> cols(len);
+    for (auto& c : cols) c = static_cast<std::int32_t>(pick(rng));
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    for (const std::int32_t c : cols) {
+        m.col.push_back(c);
+        m.val.push_back(value(rng));
+    }
+    m.row_ptr.push_back(static_cast<std::int64_t>(m.val.size()));
+}
+
+} // namespace
+
+const char* sparse_pattern_name(SparsePattern p) {
+    switch (p) {
+        case SparsePattern::Banded:   return "banded";
+        case SparsePattern::Random:   return "random";
+        case SparsePattern::PowerLaw: return "powerlaw";
+    }
+    return "unknown";
+}
+
+double sparse_pattern_mean_row(SparsePattern p) {
+    switch (p) {
+        case SparsePattern::Banded:   return 2.0 * kBandHalfWidth + 1.0;
+        case SparsePattern::Random:   return static_cast<double>(kRandomPerRow);
+        case SparsePattern::PowerLaw: return kParetoAlpha * kParetoMin / (kParetoAlpha - 1.0);
+    }
+    return 1.0;
+}
+
+CsrMatrix generate_sparse(SparsePattern p, std::size_t rows, std::uint64_t seed) {
+    CsrMatrix m;
+    m.rows = rows;
+    m.cols = rows;
+    m.row_ptr.reserve(rows + 1);
+    m.row_ptr.push_back(0);
+    const std::size_t expect = static_cast<std::size_t>(sparse_pattern_mean_row(p) * static_cast<double>(rows));
+    m.col.reserve(expect);
+    m.val.reserve(expect);
+
+    std::mt19937_64 rng(seed);
+    if (p == SparsePattern::Banded) {
+        for (std::size_t r = 0; r < rows; ++r) {
+            const std::int64_t lo = std::max<std::int64_t>(0, static_cast<std::int64_t>(r) - kBandHalfWidth);
+            const std::int64_t hi = std::min<std::int64_t>(static_cast<std::int64_t>(rows) - 1,
+                                                           static_cast<std::int64_t>(r) + kBandHalfWidth);
+            for (std::int64_t c = lo; c <= hi; ++c) {
+                m.col.push_back(static_cast<std::int32_t>(c));
+                m.val.push_back(c == static_cast<std::int64_t>(r) ? 2.0 * kBandHalfWidth + 1.0 : -1.0);
+            }
+            m.row_ptr.push_back(static_cast<std::int64_t>(m.val.size()));
+        }
+    } else if (p == SparsePattern::Random) {
+        for (std::size_t r = 0; r < rows; ++r) append_random_row(m, std::min(kRandomPerRow, rows), rng);
+    } else {
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        const std::size_t cap = std::min(kPowerLawMaxRow, rows);
+        for (std::size_t r = 0; r < rows; ++r) {
+            // Inverse-CDF Pareto sample; 1 - u keeps the base in (0, 1].
+            const double len = kParetoMin * std::pow(1.0 - u(rng), -1.0 / kParetoAlpha);
+            append_random_row(m, std::max<std::size_t>(1, std::min(cap, static_cast<std::size_t>(len))), rng);
+        }
+    }
+    return m;
+}
+
+CsrMatrix generate_stencil27(std::size_t nx, std::size_t ny, std::size_t nz) {
+    CsrMatrix m;
+    m.rows = nx * ny * nz;
+    m.cols = m.rows;
+    m.row_ptr.reserve(m.rows + 1);
+    m.row_ptr.push_back(0);
+    m.col.reserve(27 * m.rows);
+    m.val.reserve(27 * m.rows);
+    const auto in = [](std::size_t i, int d, std::size_t n) {
+        return (d >= 0 || i > 0) && (d <= 0 || i + 1 < n);
+    };
+    for (std::size_t z = 0; z < nz; ++z) {
+        for (std::size_t y = 0; y < ny; ++y) {
+            for (std::size_t x = 0; x < nx; ++x) {
+                const std::size_t r = x + nx * (y + ny * z);
+                // dz, dy, dx in increasing order keeps the columns sorted.
+                for (int dz = -1; dz <= 1; ++dz) {
+                    if (!in(z, dz, nz)) continue;
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        if (!in(y, dy, ny)) continue;
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            if (!in(x, dx, nx)) continue;
+                            const std::int64_t c = static_cast<std::int64_t>(r) + dx +
+                                                   static_cast<std::int64_t>(nx) * (dy + static_cast<std::int64_t>(ny) * dz);
+                            m.col.push_back(static_cast<std::int32_t>(c));
+                            m.val.push_back(dx == 0 && dy == 0 && dz == 0 ? 26.0 : -1.0);
+                        }
+                    }
+                }
+                m.row_ptr.push_back(static_cast<std::int64_t>(m.val.size()));
+            }
+        }
+    }
+    return m;
+}
+
+CsrMatrix load_matrix_market(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open '" + path + "'");
+
+    std::string line;
+    if (!std::getline(in, line)) throw std::runtime_error("empty file '" + path + "'");
+    std::istringstream header(line);
+    std::string banner, object, format, field, symmetry;
+    header >> banner >> object >> format >> field >> symmetry;
+    auto lower = [](std::string s) {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return s;
+    };
+    object = lower(object);
+    format = lower(format);
+    field = lower(field);
+    symmetry = lower(symmetry);
+    if (banner != "%%MatrixMarket" || object != "matrix" || format != "coordinate") {
+        throw std::runtime_error("'" + path + "' is not a Matrix Market coordinate matrix");
+    }
+    if (field != "real" && field != "integer" && field != "pattern") {
+        throw std::runtime_error("unsupported Matrix Market field '" + field + "'");
+    }
+    if (symmetry != "general" && symmetry != "symmetric") {
+        throw std::runtime_error("unsupported Matrix Market symmetry '" + symmetry + "'");
+    }
+    const bool pattern = field == "pattern";
+    const bool symmetric = symmetry == "symmetric";
+
+    while (std::getline(in, line) && (line.empty() || line[0] == '%')) {}
+    std::size_t rows = 0, cols = 0, entries = 0;
+    {
+        std::istringstream size_line(line);
+        if (!(size_line >> rows >> cols >> entries)) throw std::runtime_error("malformed size line in '" + path + "'");
+    }
+    if (rows > 0x7fffffffu || cols > 0x7fffffffu) throw std::runtime_error("matrix too large for 32-bit indices");
+
+    std::vector<std::tuple<std::int32_t, std::int32_t, double>> coo;
+    coo.reserve(symmetric ? 2 * entries : entries);
+    for (std::size_t e = 0; e < entries; ++e) {
+        std::size_t i = 0, j = 0;
+        double v = 1.0;
+        if (!(in >> i >> j) || (!pattern && !(in >> v)) || i == 0 || j == 0 || i > rows || j > cols) {
+            throw std::runtime_error("malformed entry " + std::to_string(e + 1) + " in '" + path + "'");
+        }
+        coo.emplace_back(static_cast<std::int32_t>(i - 1), static_cast<std::int32_t>(j - 1), v);
+        if (symmetric && i != j) coo.emplace_back(static_cast<std::int32_t>(j - 1), static_cast<std::int32_t>(i - 1), v);
+    }
+    std::sort(coo.begin(), coo.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+    });
+
+    CsrMatrix m;
+    m.rows = rows;
+    m.cols = cols;
+    m.row_ptr.assign(rows + 1, 0);
+    m.col.reserve(coo.size());
+    m.val.reserve(coo.size());
+    for (std::size_t k = 0; k < coo.size(); ++k) {
+        const auto& t = coo[k];
+        // Duplicate (i, j) entries are summed, as the format specifies.
+        if (k > 0 && std::get<0>(t) == std::get<0>(coo[k - 1]) && std::get<1>(t) == std::get<1>(coo[k - 1])) {
+            m.val.back() += std::get<2>(t);
+            continue;
+        }
+        ++m.row_ptr[static_cast<std::size_t>(std::get<0>(t)) + 1];
+        m.col.push_back(std::get<1>(t));
+        m.val.push_back(std::get<2>(t));
+    }
+    for (std::size_t r = 0; r < rows; ++r) m.row_ptr[r + 1] += m.row_ptr[r];
+    return m;
+}
+
+void spmv_csr(const CsrMatrix& a, const double* x, double* y, int threads, double* thread_ns) {
+    const std::int64_t* const rp = a.row_ptr.data();
+    const std::int32_t* const ci = a.col.data();
+    const double* const v = a.val.data();
+    const std::size_t rows = a.rows;
+
+    #pragma omp parallel num_threads(threads)
+    {
+#if defined(_OPENMP)
+        const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+        const std::size_t nt = static_cast<std::size_t>(omp_get_num_threads());
+#else
+        const std::size_t tid = 0, nt = 1;
+#endif
+        Timer t;
+        t.start();
+        const std::size_t lo = rows * tid / nt, hi = rows * (tid + 1) / nt;
+        for (std::size_t r = lo; r < hi; ++r) {
+            double sum = 0.0;
+            for (std::int64_t k = rp[r]; k < rp[r + 1]; ++k) sum += v[k] * x[ci[k]];
+            y[r] = sum;
+        }
+        if (thread_ns) thread_ns[tid] = static_cast<double>(t.elapsed_ns());
+    }
+}
+
+} // namespace benchmark
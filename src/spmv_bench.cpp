@@ -0,0 +1,392 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "sparse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using benchmark::CsrMatrix;
+
+namespace {
+
+/**
+ * @brief ELLPACK, row-major padded (CPU variant): every row holds `width`
+ *        slots, padding is column 0 with value 0.
+ *
+ * The GPU layout is slot-major (one thread per row, coalesced); on a CPU
+ * the row-major form keeps each row's slots contiguous for one core.
+ */
+struct EllMatrix {
+    std::size_t rows = 0, cols = 0, width = 0;
+    std::vector<std::int32_t> col;
+    std::vector<double> val;
+};
+
+/// SELL-C-sigma chunk height (8 doubles = one AVX-512 vector, two AVX vectors).
+constexpr std::size_t kSellC = 8;
+/// Rows sorted by length within windows of sigma rows (multiple of C).
+constexpr std::size_t kSellSigma = 256;
+
+/**
+ * @brief SELL-C-sigma: rows sorted by length within sigma-windows, cut into
+ *        chunks of C rows stored column-major and padded to the chunk's
+ *        longest row.
+ *
+ * Slot k of chunk c, lane l lives at chunk_ptr[c] + k * C + l, so the C
+ * lanes of one slot are one SIMD vector (and one gather of x).
+ */
+struct SellMatrix {
+    std::size_t rows = 0, cols = 0, chunks = 0;
+    std::vector<std::int64_t> chunk_ptr;   // chunks + 1 slot offsets
+    std::vector<std::int32_t> chunk_width;
+    std::vector<std::int32_t> perm;        // chunk row -> original row (rows entries)
+    std::vector<std::int32_t> col;
+    std::vector<double> val;
+};
+
+EllMatrix build_ell(const CsrMatrix& a) {
+    EllMatrix e;
+    e.rows = a.rows;
+    e.cols = a.cols;
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        e.width = std::max(e.width, static_cast<std::size_t>(a.row_ptr[r + 1] - a.row_ptr[r]));
+    }
+    e.col.assign(e.rows * e.width, 0);
+    e.val.assign(e.rows * e.width, 0.0);
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        std::size_t k = r * e.width;
+        for (std::int64_t j = a.row_ptr[r]; j < a.row_ptr[r + 1]; ++j, ++k) {
+            e.col[k] = a.col[static_cast<std::size_t>(j)];
+            e.val[k] = a.val[static_cast<std::size_t>(j)];
+        }
+    }
+    return e;
+}
+
+SellMatrix build_sell(const CsrMatrix& a) {
+    SellMatrix s;
+    s.rows = a.rows;
+    s.cols = a.cols;
+    s.chunks = (a.rows + kSellC - 1) / kSellC;
+
+    auto len = [&](std::size_t r) { return a.row_ptr[r + 1] - a.row_ptr[r]; };
+    s.perm.resize(a.rows);
+    std::iota(s.perm.begin(), s.perm.end(), 0);
+    for (std::size_t w = 0; w < a.rows; w += kSellSigma) {
+        const auto first = s.perm.begin() + static_cast<std::ptrdiff_t>(w);
+        const auto last = s.perm.begin() + static_cast<std::ptrdiff_t>(std::min(a.rows, w + kSellSigma));
+        std::stable_sort(first, last, [&](std::int32_t x, std::int32_t y) { return len(x) > len(y); });
+    }
+
+    s.chunk_ptr.assign(s.chunks + 1, 0);
+    s.chunk_width.assign(s.chunks, 0);
+    for (std::size_t c = 0; c < s.chunks; ++c) {
+        std::int64_t width = 0;
+        for (std::size_t l = 0; l < kSellC && c * kSellC + l < a.rows; ++l) {
+            width = std::max(width, len(static_cast<std::size_t>(s.perm[c * kSellC + l])));
+        }
+        s.chunk_width[c] = static_cast<std::int32_t>(width);
+        s.chunk_ptr[c + 1] = s.chunk_ptr[c] + width * static_cast<std::int64_t>(kSellC);
+    }
+
+    s.col.assign(static_cast<std::size_t>(s.chunk_ptr[s.chunks]), 0);
+    s.val.assign(static_cast<std::size_t>(s.chunk_ptr[s.chunks]), 0.0);
+    for (std::size_t c = 0; c < s.chunks; ++c) {
+        for (std::size_t l = 0; l < kSellC && c * kSellC + l < a.rows; ++l) {
+            const std::size_t r = static_cast<std::size_t>(s.perm[c * kSellC + l]);
+            std::size_t k = static_cast<std::size_t>(s.chunk_ptr[c]) + l;
+            for (std::int64_t j = a.row_ptr[r]; j < a.row_ptr[r + 1]; ++j, k += kSellC) {
+                s.col[k] = a.col[static_cast<std::size_t>(j)];
+                s.val[k] = a.val[static_cast<std::size_t>(j)];
+            }
+        }
+    }
+    return s;
+}
+
+/// ELL SpMV, rows split evenly by count (same partition as spmv_csr).
+void spmv_ell(const EllMatrix& e, const double* x, double* y, int threads, double* thread_ns) {
+    const std::int32_t* const ci = e.col.data();
+    const double* const v = e.val.data();
+    const std::size_t w = e.width;
+    #pragma omp parallel num_threads(threads)
+    {
+        std::size_t tid, nt;
+        team_position(tid, nt);
+        Timer t;
+        t.start();
+        const std::size_t lo = e.rows * tid / nt, hi = e.rows * (tid + 1) / nt;
+        for (std::size_t r = lo; r < hi; ++r) {
+            double sum = 0.0;
+            for (std::size_t k = r * w; k < (r + 1) * w; ++k) sum += v[k] * x[ci[k]];
+            y[r] = sum;
+        }
+        thread_ns[tid] = static_cast<double>(t.elapsed_ns());
+    }
+}
+
+/// SELL-C-sigma SpMV, chunks split evenly by count; the lane loop vectorizes (gather of x).
+void spmv_sell(const SellMatrix& s, const double* x, double* y, int threads, double* thread_ns) {
+    const std::int32_t* const ci = s.col.data();
+    const double* const v = s.val.data();
+    #pragma omp parallel num_threads(threads)
+    {
+        std::size_t tid, nt;
+        team_position(tid, nt);
+        Timer t;
+        t.start();
+        const std::size_t lo = s.chunks * tid / nt, hi = s.chunks * (tid + 1) / nt;
+        for (std::size_t c = lo; c < hi; ++c) {
+            double acc[kSellC] = {};
+            std::size_t k = static_cast<std::size_t>(s.chunk_ptr[c]);
+            for (std::int32_t j = 0; j < s.chunk_width[c]; ++j, k += kSellC) {
+                for (std::size_t l = 0; l < kSellC; ++l) acc[l] += v[k + l] * x[ci[k + l]];
+            }
+            for (std::size_t l = 0; l < kSellC && c * kSellC + l < s.rows; ++l) {
+                y[s.perm[c * kSellC + l]] = acc[l];
+            }
+        }
+        thread_ns[tid] = static_cast<double>(t.elapsed_ns());
+    }
+}
+
+/// max / mean of per-thread work (1.0 = perfectly balanced).
+double imbalance(const std::vector<double>& work) {
+    if (work.empty()) return 1.0;
+    const double mean = std::accumulate(work.begin(), work.end(), 0.0) / static_cast<double>(work.size());
+    return mean > 0.0 ? *std::max_element(work.begin(), work.end()) / mean : 1.0;
+}
+
+/**
+ * @brief Times CSR, ELL and SELL-C-sigma for one matrix over the thread sweep.
+ *
+ * GB/s counts each format's own stream (values + indices including padding,
+ * row/chunk pointers, permutation, y written once, x read once), so padding
+ * shows up as lost bandwidth efficiency rather than being hidden.
+ */
+void run_spmv_matrix(const Config& conf, BenchmarkResult& res, const std::string& name, const CsrMatrix& a,
+                     const std::vector<int>& thread_counts, json& table) {
+    const std::size_t nnz = a.nnz();
+    if (a.rows == 0 || nnz == 0) {
+        std::cerr << "Error: spmv matrix '" << name << "' is empty\n";
+        return;
+    }
+
+    // Row-length statistics.
+    double mean = static_cast<double>(nnz) / static_cast<double>(a.rows), var = 0.0;
+    std::int64_t min_len = a.row_ptr[1] - a.row_ptr[0], max_len = min_len;
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        const std::int64_t len = a.row_ptr[r + 1] - a.row_ptr[r];
+        min_len = std::min(min_len, len);
+        max_len = std::max(max_len, len);
+        var += (static_cast<double>(len) - mean) * (static_cast<double>(len) - mean);
+    }
+    json& m = table[name];
+    m["rows"] = a.rows;
+    m["cols"] = a.cols;
+    m["nnz"] = nnz;
+    m["row_len_mean"] = mean;
+    m["row_len_min"] = min_len;
+    m["row_len_max"] = max_len;
+    m["row_len_cv"] = mean > 0.0 ? std::sqrt(var / static_cast<double>(a.rows)) / mean : 0.0;
+
+    // ELL pads every row to the longest; skip it when that would more than
+    // quadruple the stored entries (power-law rows).
+    constexpr double kMaxEllFill = 4.0;
+    const double ell_fill = static_cast<double>(max_len) * static_cast<double>(a.rows) / static_cast<double>(nnz);
+    EllMatrix ell;
+    const bool use_ell = ell_fill <= kMaxEllFill;
+    if (use_ell) ell = build_ell(a);
+    const SellMatrix sell = build_sell(a);
+    const double sell_fill = static_cast<double>(sell.val.size()) / static_cast<double>(nnz);
+    m["ell_fill"] = ell_fill;
+    m["ell_skipped"] = !use_ell;
+    m["sell_fill"] = sell_fill;
+    m["sell_c"] = kSellC;
+    m["sell_sigma"] = kSellSigma;
+
+    std::vector<double> x(a.cols), y(a.rows), y_ref(a.rows);
+    {
+        std::mt19937_64 rng(static_cast<std::uint64_t>(conf.seed) + 1);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        for (auto& v : x) v = dist(rng);
+    }
+    std::vector<double> scratch_ns(1);
+    benchmark::spmv_csr(a, x.data(), y_ref.data(), 1, scratch_ns.data());
+
+    const double xb = static_cast<double>(a.cols) * sizeof(double);
+    const double yb = static_cast<double>(a.rows) * sizeof(double);
+    struct Format {
+        const char* name;
+        double bytes;       // per SpMV
+        double stored;      // stored slots (nnz + padding)
+        std::function<void(double*, int, double*)> run;
+        std::function<double(std::size_t, std::size_t)> slice_work; // stored slots of thread t of nt
+    };
+    std::vector<Format> formats;
+    formats.push_back({"csr", 12.0 * nnz + 8.0 * (a.rows + 1) + yb + xb, static_cast<double>(nnz),
+                       [&](double* out, int t, double* ns) { benchmark::spmv_csr(a, x.data(), out, t, ns); },
+                       [&](std::size_t t, std::size_t nt) {
+                           return static_cast<double>(a.row_ptr[a.rows * (t + 1) / nt] - a.row_ptr[a.rows * t / nt]);
+                       }});
+    if (use_ell) {
+        formats.push_back({"ell", 12.0 * ell.val.size() + yb + xb, static_cast<double>(ell.val.size()),
+                           [&](double* out, int t, double* ns) { spmv_ell(ell, x.data(), out, t, ns); },
+                           [&](std::size_t t, std::size_t nt) {
+                               return static_cast<double>((a.rows * (t + 1) / nt - a.rows * t / nt) * ell.width);
+                           }});
+    }
+    formats.push_back({"sell", 12.0 * sell.val.size() + 8.0 * (sell.chunks + 1) + 4.0 * (sell.chunks * 2 + a.rows) + yb + xb,
+                       static_cast<double>(sell.val.size()),
+                       [&](double* out, int t, double* ns) { spmv_sell(sell, x.data(), out, t, ns); },
+                       [&](std::size_t t, std::size_t nt) {
+                           const std::size_t lo = sell.chunks * t / nt, hi = sell.chunks * (t + 1) / nt;
+                           return static_cast<double>(sell.chunk_ptr[hi] - sell.chunk_ptr[lo]);
+                       }});
+
+    // sum_k |a_rk x_k| per row: scale for the validation tolerance.
+    std::vector<double> row_mag(a.rows, 0.0);
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        for (std::int64_t k = a.row_ptr[r]; k < a.row_ptr[r + 1]; ++k) {
+            row_mag[r] += std::fabs(a.val[static_cast<std::size_t>(k)] * x[static_cast<std::size_t>(a.col[static_cast<std::size_t>(k)])]);
+        }
+    }
+
+    for (const auto& f : formats) {
+        for (const int threads : thread_counts) {
+            std::vector<double> thread_ns(static_cast<std::size_t>(threads), 0.0);
+            std::fill(y.begin(), y.end(), 0.0);
+            for (int w = 0; w < conf.warmup; ++w) f.run(y.data(), threads, thread_ns.data());
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            std::vector<double> time_imb;
+            time_imb.reserve(conf.iters);
+            for (int it = 0; it < conf.iters; ++it) {
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                f.run(y.data(), threads, thread_ns.data());
+
+                clobber_memory();
+                samples.push_back(t.elapsed_ns());
+                time_imb.push_back(imbalance(thread_ns));
+            }
+            std::sort(time_imb.begin(), time_imb.end());
+
+            // Correctness of this thread count vs the serial CSR reference (untimed).
+            double max_rel = 0.0;
+            for (std::size_t r = 0; r < a.rows; ++r) {
+                max_rel = std::max(max_rel, std::fabs(y[r] - y_ref[r]) / (row_mag[r] > 0.0 ? row_mag[r] : 1.0));
+            }
+            if (max_rel > 1e-12) {
+                std::cerr << "CRITICAL: spmv " << name << " " << f.name << " threads=" << threads
+                          << " validation failed (rel " << max_rel << ")\n";
+            }
+
+            std::vector<double> work(static_cast<std::size_t>(threads));
+            for (std::size_t t = 0; t < work.size(); ++t) work[t] = f.slice_work(t, work.size());
+
+            BenchmarkResult::Point pt;
+            pt.kernel = "spmv_" + name + "_" + f.name;
+            pt.bytes = static_cast<std::size_t>(12.0 * f.stored);
+            BenchmarkResult::fill_timing(pt, samples);
+            pt.checksum = y[a.rows / 2];
+
+            const double gflops = (pt.median_ns > 0.0) ? 2.0 * static_cast<double>(nnz) / pt.median_ns : 0.0;
+            pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? f.bytes / pt.median_ns : 0.0;
+            pt.extra["gflops"] = gflops;
+            pt.extra["threads"] = threads;
+            pt.extra["nnz"] = static_cast<double>(nnz);
+            pt.extra["fill_ratio"] = f.stored / static_cast<double>(nnz);
+            pt.extra["work_imbalance"] = imbalance(work);
+            pt.extra["time_imbalance"] = time_imb[time_imb.size() / 2];
+
+            json& row = m["formats"][f.name][std::to_string(threads)];
+            row["gflops"] = gflops;
+            row["gb_s"] = pt.bandwidth_gb_s;
+            row["work_imbalance"] = pt.extra["work_imbalance"];
+            row["time_imbalance"] = pt.extra["time_imbalance"];
+
+            std::cout << "[SpMV] " << name << " " << f.name << " threads=" << threads << " gflops=" << gflops
+                      << " GB/s=" << pt.bandwidth_gb_s << " imbalance=" << pt.extra["work_imbalance"] << "\n";
+            res.sweep_points.push_back(std::move(pt));
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Sparse matrix-vector multiply runner for --kernel spmv.
+ *
+ * --matrix selects the input: `synthetic` (default: banded, random and
+ * power-law in turn), one of those names, or a Matrix Market file path.
+ * Synthetic matrices are square and sized so values + column indices take
+ * about --size bytes; they are reproducible for --seed.
+ *
+ * Each matrix runs as CSR, ELLPACK (skipped when padding would exceed 4x
+ * nnz) and SELL-C-sigma (C = 8, sigma = 256) on 1, 2, 4 .. --threads
+ * threads, rows (chunks) split evenly by count. Points report GFLOP/s
+ * (2 flops per nonzero), GB/s of the format's own traffic, fill ratio, and
+ * load imbalance both as stored work (max / mean per thread) and as
+ * measured per-thread busy time. Matrix statistics go to stats.spmv.
+ *
+ * @param conf The parsed configuration (size, matrix, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_spmv_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < conf.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(conf.threads);
+
+    using benchmark::SparsePattern;
+    const SparsePattern all[] = {SparsePattern::Banded, SparsePattern::Random, SparsePattern::PowerLaw};
+    std::vector<SparsePattern> patterns;
+    for (const SparsePattern p : all) {
+        if (conf.matrix == "synthetic" || conf.matrix == benchmark::sparse_pattern_name(p)) patterns.push_back(p);
+    }
+
+    json& table = res.extra_stats["spmv"];
+    if (patterns.empty()) {
+        CsrMatrix a;
+        try {
+            a = benchmark::load_matrix_market(conf.matrix);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: failed to load --matrix '" << conf.matrix << "': " << e.what() << "\n";
+            return;
+        }
+        table["matrix_file"] = conf.matrix;
+        run_spmv_matrix(conf, res, "file", a, thread_counts, table);
+        return;
+    }
+
+    for (const SparsePattern p : patterns) {
+        const double per_row = 12.0 * benchmark::sparse_pattern_mean_row(p);
+        const std::size_t rows = std::max<std::size_t>(
+            1024, static_cast<std::size_t>(static_cast<double>(size_bytes) / per_row));
+        const CsrMatrix a = benchmark::generate_sparse(p, rows, static_cast<std::uint64_t>(conf.seed));
+        run_spmv_matrix(conf, res, benchmark::sparse_pattern_name(p), a, thread_counts, table);
+    }
+}
@@ -0,0 +1,470 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Grid geometry: x fastest, then y, then z (nz = 1 for 2D).
+ *
+ * The outermost ring of points is a fixed (Dirichlet) boundary present in
+ * both buffers; only interior points are updated.
+ */
+struct Grid {
+    std::size_t nx = 0, ny = 0, nz = 1;
+    std::size_t sy() const { return nx; }
+    std::size_t sz() const { return nx * ny; }
+    std::size_t points() const { return nx * ny * nz; }
+};
+
+// ---------- Stencils: one interior x-range of one row per call ----------
+
+/// 2D 5-point Jacobi: centre + 4 edge neighbours (weights sum to 1).
+struct Jacobi2D5 {
+    static constexpr const char* name = "2d5";
+    static constexpr int dims = 2;
+    static void row(const double* in, double* out, std::size_t base, std::size_t x0, std::size_t x1,
+                    const Grid& g) {
+        const std::size_t sy = g.sy();
+        for (std::size_t x = x0; x < x1; ++x) {
+            const std::size_t i = base + x;
+            out[i] = 0.5 * in[i] + 0.125 * (in[i - 1] + in[i + 1] + in[i - sy] + in[i + sy]);
+        }
+    }
+};
+
+/// 3D 7-point Jacobi: centre + 6 face neighbours.
+struct Jacobi3D7 {
+    static constexpr const char* name = "3d7";
+    static constexpr int dims = 3;
+    static void row(const double* in, double* out, std::size_t base, std::size_t x0, std::size_t x1,
+                    const Grid& g) {
+        const std::size_t sy = g.sy(), sz = g.sz();
+        for (std::size_t x = x0; x < x1; ++x) {
+            const std::size_t i = base + x;
+            out[i] = 0.4 * in[i] +
+                     0.1 * (in[i - 1] + in[i + 1] + in[i - sy] + in[i + sy] + in[i - sz] + in[i + sz]);
+        }
+    }
+};
+
+/// 3D 27-point Jacobi: centre, 6 faces, 12 edges, 8 corners (0.2 / 0.05 / 0.025 / 0.025).
+struct Jacobi3D27 {
+    static constexpr const char* name = "3d27";
+    static constexpr int dims = 3;
+    static void row(const double* in, double* out, std::size_t base, std::size_t x0, std::size_t x1,
+                    const Grid& g) {
+        const std::size_t sy = g.sy(), sz = g.sz();
+        // The nine input rows around (y, z), indexed [dz + 1][dy + 1].
+        const double* r[3][3];
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                r[dz + 1][dy + 1] = in + base + dz * static_cast<std::ptrdiff_t>(sz) +
+                                    dy * static_cast<std::ptrdiff_t>(sy);
+            }
+        }
+        for (std::size_t x = x0; x < x1; ++x) {
+            const double faces = r[1][1][x - 1] + r[1][1][x + 1] + r[1][0][x] + r[1][2][x] + r[0][1][x] + r[2][1][x];
+            const double edges = r[1][0][x - 1] + r[1][0][x + 1] + r[1][2][x - 1] + r[1][2][x + 1] +
+                                 r[0][1][x - 1] + r[0][1][x + 1] + r[2][1][x - 1] + r[2][1][x + 1] +
+                                 r[0][0][x] + r[0][2][x] + r[2][0][x] + r[2][2][x];
+            const double corners = r[0][0][x - 1] + r[0][0][x + 1] + r[0][2][x - 1] + r[0][2][x + 1] +
+                                   r[2][0][x - 1] + r[2][0][x + 1] + r[2][2][x - 1] + r[2][2][x + 1];
+            out[base + x] = 0.2 * r[1][1][x] + 0.05 * faces + 0.025 * (edges + corners);
+        }
+    }
+};
+
+/// Interior z range: [1, nz-1) in 3D, the single layer z = 0 in 2D.
+template <class S>
+std::pair<std::size_t, std::size_t> z_range(const Grid& g) {
+    return (S::dims == 3) ? std::make_pair<std::size_t, std::size_t>(1, g.nz - 1)
+                          : std::make_pair<std::size_t, std::size_t>(0, 1);
+}
+
+// ---------- Variants ----------
+
+/**
+ * @brief Naive: one full sweep per time step, rows split across threads.
+ *
+ * Each point's neighbours are re-read from wherever they are: three (2D) or
+ * 3 / 9 (3D) input rows stay in cache only if the planes are small enough.
+ */
+template <class S>
+void sweep_naive(const Grid& g, const double* in, double* out, int threads) {
+    const auto zr = z_range<S>(g);
+    const std::size_t rows_per_z = g.ny - 2;
+    const long long rows = static_cast<long long>((zr.second - zr.first) * rows_per_z);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long r = 0; r < rows; ++r) {
+        const std::size_t z = zr.first + static_cast<std::size_t>(r) / rows_per_z;
+        const std::size_t y = 1 + static_cast<std::size_t>(r) % rows_per_z;
+        S::row(in, out, (z * g.ny + y) * g.nx, 1, g.nx - 1, g);
+    }
+}
+
+/// Spatial tile (interior points): bx along x, by along y (2D: by = rows per thread chunk).
+struct Tile {
+    std::size_t bx = 0, by = 0;
+};
+
+/**
+ * @brief Spatially tiled sweep.
+ *
+ * 2D: x is cut into bx-wide columns so the three input rows of a column
+ * stay in L1 while y advances. 3D: (bx, by) tiles are distributed across
+ * threads and each walks z, so the three input planes of the tile stay in
+ * L2 instead of three full planes.
+ */
+template <class S>
+void sweep_tiled(const Grid& g, const double* in, double* out, const Tile& t, int threads) {
+    const std::size_t xtiles = (g.nx - 2 + t.bx - 1) / t.bx;
+    const std::size_t ytiles = (g.ny - 2 + t.by - 1) / t.by;
+    const auto zr = z_range<S>(g);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long tt = 0; tt < static_cast<long long>(xtiles * ytiles); ++tt) {
+        const std::size_t yt = static_cast<std::size_t>(tt) / xtiles;
+        const std::size_t xt = static_cast<std::size_t>(tt) % xtiles;
+        const std::size_t x0 = 1 + xt * t.bx, x1 = std::min(g.nx - 1, x0 + t.bx);
+        const std::size_t y0 = 1 + yt * t.by, y1 = std::min(g.ny - 1, y0 + t.by);
+        for (std::size_t z = zr.first; z < zr.second; ++z) {
+            for (std::size_t y = y0; y < y1; ++y) S::row(in, out, (z * g.ny + y) * g.nx, x0, x1, g);
+        }
+    }
+}
+
+/**
+ * @brief Temporally blocked sweep: `steps` Jacobi steps as one wavefront.
+ *
+ * The outer dimension (z planes in 3D, slabs of `slab` rows in 2D) is
+ * walked once; at wavefront position w, time level t updates plane w - t
+ * (t = 0 first). Level t + 1 of plane j therefore runs after level t of
+ * planes j - 1..j + 1, and overwrites level t - 1 of plane j only after its
+ * last reader (level t of plane j + 1) - so two buffers suffice and the
+ * result is bitwise identical to `steps` naive sweeps. The live window is
+ * about steps + 2 planes per buffer, which is what must fit in cache.
+ * Rows of each plane are split across threads (one barrier per plane-step).
+ *
+ * @return Index (0 or 1) of the buffer holding the final time level.
+ */
+template <class S>
+int sweep_wavefront(const Grid& g, double* buf0, double* buf1, int steps, std::size_t slab, int threads) {
+    double* const bufs[2] = {buf0, buf1};
+    const bool three_d = S::dims == 3;
+    // Planes: 3D z in [1, nz-1); 2D slabs of interior rows [1, ny-1).
+    const std::size_t units = three_d ? g.nz - 2 : g.ny - 2;
+    const std::size_t per_plane = three_d ? 1 : slab;
+    const std::size_t planes = (units + per_plane - 1) / per_plane;
+    const std::size_t rows_in_plane = three_d ? g.ny - 2 : slab;
+
+    #pragma omp parallel num_threads(threads)
+    for (std::size_t w = 0; w < planes + static_cast<std::size_t>(steps) - 1; ++w) {
+        for (int t = 0; t < steps; ++t) {
+            if (w < static_cast<std::size_t>(t) || w - static_cast<std::size_t>(t) >= planes) continue;
+            const std::size_t j = w - static_cast<std::size_t>(t);
+            const double* const in = bufs[t & 1];
+            double* const out = bufs[(t + 1) & 1];
+
+            #pragma omp for schedule(static)
+            for (long long r = 0; r < static_cast<long long>(rows_in_plane); ++r) {
+                std::size_t z, y;
+                if (three_d) {
+                    z = 1 + j;
+                    y = 1 + static_cast<std::size_t>(r);
+                } else {
+                    z = 0;
+                    y = 1 + j * slab + static_cast<std::size_t>(r);
+                    if (y >= g.ny - 1) continue;
+                }
+                S::row(in, out, (z * g.ny + y) * g.nx, 1, g.nx - 1, g);
+            }
+        }
+    }
+    return steps & 1;
+}
+
+/// Deterministic start: boundary = 1, interior uniform [0, 1) from --seed.
+void init_grid(const Grid& g, double* a, double* b, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    const bool three_d = g.nz > 1;
+    for (std::size_t z = 0; z < g.nz; ++z) {
+        for (std::size_t y = 0; y < g.ny; ++y) {
+            for (std::size_t x = 0; x < g.nx; ++x) {
+                const bool edge = x == 0 || x == g.nx - 1 || y == 0 || y == g.ny - 1 ||
+                                  (three_d && (z == 0 || z == g.nz - 1));
+                const std::size_t i = (z * g.ny + y) * g.nx + x;
+                a[i] = b[i] = edge ? 1.0 : dist(rng);
+            }
+        }
+    }
+}
+
+/// Cache sizes used for tiling (fallbacks when SystemInfo cannot tell).
+struct CacheSizes {
+    std::size_t l1 = 0, l2 = 0, llc = 0;
+};
+
+/**
+ * @brief Runs naive / tiled / wavefront for one stencil and working set.
+ *
+ * Tile sizes (also reported as guidance):
+ * - 2D tiled : bx so that 3 input rows + 1 output row of bx points fill half
+ *              of L1; by = rows per thread.
+ * - 3D tiled : bx = min(nx - 2, 256), by so that 3 input planes + 1 output
+ *              plane of the bx x by tile fill half of L2.
+ * - wavefront: depth (time steps per pass) in [2, 8] so that 2 buffers of
+ *              depth + 2 planes fit half of L2 per thread (3D falls back to
+ *              half of the LLC); 2D planes are slabs of rows sized the same way.
+ *
+ * All three variants run the same number of time steps per timed
+ * iteration (a multiple of the wavefront depth, >= 16M updates) and are
+ * checked once for bitwise agreement.
+ */
+template <class S>
+void run_stencil_case(const Config& conf, BenchmarkResult& res, const CacheSizes& cs, const char* level,
+                      std::size_t working_set, json& table) {
+    // Two buffers of edge^dims doubles.
+    const double cells = static_cast<double>(working_set) / (2.0 * sizeof(double));
+    Grid g;
+    if (S::dims == 2) {
+        g.nx = g.ny = std::max<std::size_t>(16, static_cast<std::size_t>(std::sqrt(cells)));
+    } else {
+        g.nx = g.ny = g.nz = std::max<std::size_t>(8, static_cast<std::size_t>(std::cbrt(cells)));
+    }
+    const std::size_t points = g.points();
+    const std::size_t interior = (g.nx - 2) * (g.ny - 2) * (S::dims == 3 ? g.nz - 2 : 1);
+    const int threads = conf.threads;
+    const std::size_t d = sizeof(double);
+
+    Tile tile;
+    if (S::dims == 2) {
+        tile.bx = std::max<std::size_t>(64, cs.l1 / 2 / (4 * d));
+        tile.by = std::max<std::size_t>(1, (g.ny - 2 + threads - 1) / threads);
+    } else {
+        tile.bx = std::min<std::size_t>(g.nx - 2, 256);
+        tile.by = std::max<std::size_t>(4, cs.l2 / 2 / (4 * tile.bx * d));
+    }
+    tile.bx = std::min(tile.bx, g.nx - 2);
+    tile.by = std::min(tile.by, g.ny - 2);
+
+    // Wavefront window: (depth + 2) planes x 2 buffers of each thread's rows.
+    // 2D: depth 8, slab rows sized so the window fits half of L2 per thread.
+    // 3D: depth from the L2 budget of a thread's share of a plane, or from
+    // half of the (shared) LLC when not even depth 2 fits in L2.
+    constexpr std::size_t kMaxDepth = 8;
+    const std::size_t team = static_cast<std::size_t>(threads);
+    auto fit_depth = [&](std::size_t budget, std::size_t plane_bytes) -> std::size_t {
+        const std::size_t planes = budget / (2 * plane_bytes);
+        return planes > 2 ? std::min(kMaxDepth, planes - 2) : 0;
+    };
+    std::size_t slab = 1;
+    std::size_t depth_sz = kMaxDepth;
+    if (S::dims == 2) {
+        const std::size_t rows_per_thread =
+            std::max<std::size_t>(1, cs.l2 / 2 / (2 * (kMaxDepth + 2) * g.nx * d));
+        slab = std::min(g.ny - 2, rows_per_thread * team);
+    } else {
+        const std::size_t share = (g.ny - 2 + team - 1) / team * g.nx * d;
+        depth_sz = fit_depth(cs.l2 / 2, share);
+        if (depth_sz < 2) depth_sz = fit_depth(cs.llc / 2, g.nx * g.ny * d);
+    }
+    const int depth = static_cast<int>(std::max<std::size_t>(2, depth_sz));
+
+    constexpr std::size_t kMinUpdates = std::size_t(1) << 24;
+    const std::size_t passes = std::max<std::size_t>(1, kMinUpdates / (interior * static_cast<std::size_t>(depth)));
+    const int steps = depth * static_cast<int>(passes);
+
+    benchmark::AlignedBuffer<double> a(points, 64), b(points, 64);
+
+    // ---- Bitwise cross-check: one wavefront pass vs `depth` naive / tiled sweeps ----
+    {
+        benchmark::AlignedBuffer<double> ref_a(points, 64), ref_b(points, 64);
+        init_grid(g, ref_a.data(), ref_b.data(), conf.seed);
+        double* in = ref_a.data();
+        double* out = ref_b.data();
+        for (int s = 0; s < depth; ++s) {
+            sweep_naive<S>(g, in, out, threads);
+            std::swap(in, out);
+        }
+        const double* const ref = in;
+
+        init_grid(g, a.data(), b.data(), conf.seed);
+        in = a.data();
+        out = b.data();
+        for (int s = 0; s < depth; ++s) {
+            sweep_tiled<S>(g, in, out, tile, threads);
+            std::swap(in, out);
+        }
+        bool ok = std::equal(ref, ref + points, in);
+
+        init_grid(g, a.data(), b.data(), conf.seed);
+        const int final_buf = sweep_wavefront<S>(g, a.data(), b.data(), depth, slab, threads);
+        const double* const wf = final_buf ? b.data() : a.data();
+        ok = ok && std::equal(ref, ref + points, wf);
+        if (!ok) {
+            std::cerr << "CRITICAL: stencil " << S::name << " " << level << " variants disagree with naive\n";
+        }
+    }
+
+    json& row = table[S::name][level];
+    row["nx"] = g.nx;
+    row["ny"] = g.ny;
+    row["nz"] = g.nz;
+    row["tile_bx"] = tile.bx;
+    row["tile_by"] = tile.by;
+    row["wavefront_depth"] = depth;
+    if (S::dims == 2) row["wavefront_slab_rows"] = slab;
+
+    const char* variants[] = {"naive", "tiled", "wavefront"};
+    double best = 0.0;
+    std::string best_variant;
+    for (const char* v : variants) {
+        init_grid(g, a.data(), b.data(), conf.seed);
+        const std::string variant = v;
+        auto one_iter = [&]() -> double {
+            double* in = a.data();
+            double* out = b.data();
+            if (variant == "wavefront") {
+                for (std::size_t p = 0; p < passes; ++p) {
+                    // Each pass continues from the newest buffer.
+                    if (sweep_wavefront<S>(g, in, out, depth, slab, threads)) std::swap(in, out);
+                }
+                return in[points / 2];
+            }
+            for (int s = 0; s < steps; ++s) {
+                if (variant == "naive") {
+                    sweep_naive<S>(g, in, out, threads);
+                } else {
+                    sweep_tiled<S>(g, in, out, tile, threads);
+                }
+                std::swap(in, out);
+            }
+            return in[points / 2];
+        };
+
+        for (int w = 0; w < conf.warmup; ++w) {
+            const double chk = one_iter();
+            do_not_optimize_away(chk);
+        }
+
+        std::vector<long long> samples;
+        samples.reserve(conf.iters);
+        double checksum = 0.0;
+        for (int it = 0; it < conf.iters; ++it) {
+            Timer t;
+            clobber_memory();
+            t.start();
+
+            checksum = one_iter();
+
+            clobber_memory();
+            samples.push_back(t.elapsed_ns());
+            do_not_optimize_away(checksum);
+        }
+
+        BenchmarkResult::Point pt;
+        pt.kernel = std::string("stencil_") + S::name + "_" + v;
+        pt.bytes = points * d;
+        BenchmarkResult::fill_timing(pt, samples);
+        pt.checksum = checksum;
+
+        const double updates = static_cast<double>(interior) * steps;
+        const double glups = (pt.median_ns > 0.0) ? updates / pt.median_ns : 0.0;
+        // Effective bandwidth: 16 B per update (one read + one write), the
+        // traffic a perfect-reuse single sweep would need.
+        pt.bandwidth_gb_s = 16.0 * glups;
+        pt.extra["glups"] = glups;
+        pt.extra["nx"] = static_cast<double>(g.nx);
+        pt.extra["ny"] = static_cast<double>(g.ny);
+        pt.extra["nz"] = static_cast<double>(g.nz);
+        pt.extra["steps"] = steps;
+        pt.extra["threads"] = threads;
+        if (variant == "tiled") {
+            pt.extra["tile_bx"] = static_cast<double>(tile.bx);
+            pt.extra["tile_by"] = static_cast<double>(tile.by);
+        } else if (variant == "wavefront") {
+            pt.extra["wavefront_depth"] = depth;
+        }
+
+        row[v]["glups"] = glups;
+        row[v]["effective_gb_s"] = pt.bandwidth_gb_s;
+        if (glups > best) {
+            best = glups;
+            best_variant = v;
+        }
+
+        std::cout << "[Stencil] " << S::name << " " << level << " " << v << " n=" << g.nx
+                  << " glups=" << glups << " eff_GB/s=" << pt.bandwidth_gb_s << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    }
+    row["best"] = best_variant;
+}
+
+} // namespace
+
+/**
+ * @brief Jacobi stencil runner for --kernel stencil.
+ *
+ * 2D 5-point, 3D 7-point and 3D 27-point Jacobi, each as naive sweeps,
+ * spatially tiled sweeps and a temporally blocked wavefront. Grids are sized
+ * so the two buffers fill half of L1, half of L2, half of the LLC and
+ * --size (levels larger than --size are skipped), to show where blocking
+ * pays off. Reports GLUP/s and effective bandwidth (16 B / update) per
+ * point, and the tile sizes / best variant per level in stats.stencil.
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_stencil_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    CacheSizes cs;
+    cs.l1 = sys.cache_l1_bytes ? static_cast<std::size_t>(sys.cache_l1_bytes) : 32 * 1024;
+    cs.l2 = sys.cache_l2_bytes ? static_cast<std::size_t>(sys.cache_l2_bytes) : 1024 * 1024;
+    cs.llc = sys.cache_llc_bytes ? static_cast<std::size_t>(sys.cache_llc_bytes) : 8 * 1024 * 1024;
+
+    struct Level {
+        const char* name;
+        std::uint64_t working_set;
+    };
+    std::vector<Level> levels;
+    for (const Level& lv : {Level{"l1", cs.l1 / 2}, Level{"l2", cs.l2 / 2}, Level{"llc", cs.llc / 2},
+                            Level{"dram", size_bytes}}) {
+        if (lv.working_set > size_bytes) continue;
+        if (!levels.empty() && lv.working_set <= levels.back().working_set) continue;
+        levels.push_back(lv);
+    }
+
+    json& table = res.extra_stats["stencil"];
+    table["threads"] = conf.threads;
+    for (const auto& lv : levels) {
+        run_stencil_case<Jacobi2D5>(conf, res, cs, lv.name, lv.working_set, table);
+        run_stencil_case<Jacobi3D7>(conf, res, cs, lv.name, lv.working_set, table);
+        run_stencil_case<Jacobi3D27>(conf, res, cs, lv.name, lv.working_set, table);
+    }
+}
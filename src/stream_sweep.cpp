@@ -9,6 +9,8 @@
 #include <cstddef>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <functional>
 
 /**
  * @brief Convert bytes to number of double elements.
@@ -197,3 +199,42 @@ void run_stream_sweep(const Config& conf, BenchmarkResult& res, StreamOp op) {
         res.sweep_points.push_back(pt);
     }
 }
+
+/**
+ * @brief STREAM Copy sweep used as the bandwidth reference of another runner.
+ *
+ * Runs the Copy sweep on --threads threads (at most 10 iterations / 2
+ * warmups: calibration, not the measurement) and returns a lookup from a
+ * footprint in bytes (source + destination) to the Copy GB/s measured at the
+ * sweep footprint closest on a log scale.
+ *
+ * @param conf The parsed configuration of the calling runner.
+ * @return Footprint (bytes) -> Copy GB/s.
+ */
+std::function<double(double)> stream_copy_reference(const Config& conf) {
+    Config calib = conf;
+    calib.iters = std::min(conf.iters, 10);
+    calib.warmup = std::min(conf.warmup, 2);
+    BenchmarkResult copy_res;
+    {
+        const ScopedOmpThreads team(conf.threads); // stream kernels use the default team size
+        run_stream_sweep(calib, copy_res, StreamOp::Copy);
+    }
+
+    std::vector<std::pair<double, double>> points; // (footprint bytes, GB/s)
+    for (const auto& pt : copy_res.sweep_points) points.emplace_back(2.0 * static_cast<double>(pt.bytes), pt.bandwidth_gb_s);
+
+    return [points](double bytes) {
+        double best_gb_s = 0.0, best_dist = 0.0;
+        bool found = false;
+        for (const auto& p : points) {
+            const double dist = std::fabs(std::log(p.first / bytes));
+            if (!found || dist < best_dist) {
+                best_gb_s = p.second;
+                best_dist = dist;
+                found = true;
+            }
+        }
+        return best_gb_s;
+    };
+}
@@ -2,9 +2,14 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <set>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #if defined(__linux__) || defined(__APPLE__)
@@ -17,6 +22,15 @@
 #include <winreg.h>
 #endif
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SYSINFO_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 // ---------- Helpers ----------
 static std::string trim(std::string s) {
     auto not_space = [](unsigned char ch) { return !std::isspace(ch); };
@@ -175,46 +189,242 @@ static void collect_cache_sizes(benchmark::SystemInfo& info) {
         }
     }
 #elif defined(__linux__)
-    auto read_sysfs_int = [](const std::string& path) -> uint64_t {
+    // sysfs reports sizes with a unit suffix ("48K", "2048K"); a plain
+    // integer read would stop at the suffix and return kilobytes as bytes.
+    auto read_sysfs_size = [](const std::string& path) -> uint64_t {
         std::ifstream f(path);
         uint64_t val = 0;
-        if (f >> val) return val;
-        return 0;
+        if (!(f >> val)) return 0;
+        char unit = 0;
+        if (f >> unit) {
+            if (unit == 'K') val *= 1024ULL;
+            else if (unit == 'M') val *= 1024ULL * 1024ULL;
+            else if (unit == 'G') val *= 1024ULL * 1024ULL * 1024ULL;
+        }
+        return val;
     };
-    
+
     // L1 Data
-    info.cache_l1_bytes = read_sysfs_int("/sys/devices/system/cpu/cpu0/cache/index0/size");
-    if (info.cache_l1_bytes == 0) {
-        // Sometimes size has 'K' suffix
-        std::ifstream f("/sys/devices/system/cpu/cpu0/cache/index0/size");
-        std::string s;
-        if (f >> s && !s.empty()) {
-            if (s.back() == 'K') info.cache_l1_bytes = std::stoull(s.substr(0, s.size()-1)) * 1024;
+    info.cache_l1_bytes = read_sysfs_size("/sys/devices/system/cpu/cpu0/cache/index0/size");
+
+    // L2
+    info.cache_l2_bytes = read_sysfs_size("/sys/devices/system/cpu/cpu0/cache/index2/size");
+
+    // L3 (LLC)
+    info.cache_llc_bytes = read_sysfs_size("/sys/devices/system/cpu/cpu0/cache/index3/size");
+#endif
+}
+
+// ---------- CPU vulnerability / mitigation status ----------
+static void collect_cpu_vulnerabilities(benchmark::SystemInfo& info) {
+#if defined(__linux__)
+    std::error_code ec;
+    const std::filesystem::path dir("/sys/devices/system/cpu/vulnerabilities");
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        std::ifstream f(entry.path());
+        std::string line;
+        if (std::getline(f, line)) {
+            info.cpu_vulnerabilities.emplace_back(entry.path().filename().string(), trim(line));
         }
     }
+    std::sort(info.cpu_vulnerabilities.begin(), info.cpu_vulnerabilities.end());
+#else
+    (void)info;
+#endif
+}
 
-    // L2
-    info.cache_l2_bytes = read_sysfs_int("/sys/devices/system/cpu/cpu0/cache/index2/size");
-    if (info.cache_l2_bytes == 0) {
-        std::ifstream f("/sys/devices/system/cpu/cpu0/cache/index2/size");
-        std::string s;
-        if (f >> s && !s.empty()) {
-            if (s.back() == 'K') info.cache_l2_bytes = std::stoull(s.substr(0, s.size()-1)) * 1024;
+// ---------- SIMD / FMA capabilities ----------
+#if defined(SYSINFO_X86)
+static void cpuid(uint32_t leaf, uint32_t sub, uint32_t r[4]) {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(sub));
+    for (int i = 0; i < 4; ++i) r[i] = static_cast<uint32_t>(regs[i]);
+#else
+    __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+static uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t lo = 0, hi = 0;
+    asm volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+static void collect_simd_caps(benchmark::SystemInfo& info) {
+#if defined(SYSINFO_X86)
+    uint32_t r[4] = {0, 0, 0, 0};
+    cpuid(0, 0, r);
+    const uint32_t max_leaf = r[0];
+    char vendor[13];
+    std::memcpy(vendor + 0, &r[1], 4); // EBX
+    std::memcpy(vendor + 4, &r[3], 4); // EDX
+    std::memcpy(vendor + 8, &r[2], 4); // ECX
+    vendor[12] = '\0';
+    info.cpu_vendor = vendor;
+    if (max_leaf < 1) {
+        info.simd_isa = "scalar";
+        info.simd_width_bits = 64;
+        return;
+    }
+
+    cpuid(1, 0, r);
+    const uint32_t base_family = (r[0] >> 8) & 0xF;
+    info.cpu_family = base_family == 0xF ? base_family + ((r[0] >> 20) & 0xFF) : base_family;
+    info.cpu_model_id = (r[0] >> 4) & 0xF;
+    if (base_family == 0x6 || base_family == 0xF) info.cpu_model_id += ((r[0] >> 16) & 0xF) << 4;
+
+    const bool sse2 = (r[3] >> 26) & 1;
+    const bool fma = (r[2] >> 12) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx_cpu = (r[2] >> 28) & 1;
+
+    // The OS must save the wider register state (XCR0) for the ISA to be usable.
+    const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+    const bool avx_os = (xcr0 & 0x6) == 0x6;
+    const bool avx512_os = (xcr0 & 0xE6) == 0xE6;
+
+    bool avx2 = false, avx512f = false;
+    if (max_leaf >= 7) {
+        cpuid(7, 0, r);
+        avx2 = (r[1] >> 5) & 1;
+        avx512f = (r[1] >> 16) & 1;
+    }
+
+    info.has_fma = fma && avx_os;
+    if (avx512f && avx512_os) {
+        info.simd_isa = "avx512";
+        info.simd_width_bits = 512;
+    } else if (avx2 && avx_os) {
+        info.simd_isa = "avx2";
+        info.simd_width_bits = 256;
+    } else if (avx_cpu && avx_os) {
+        info.simd_isa = "avx";
+        info.simd_width_bits = 256;
+    } else if (sse2) {
+        info.simd_isa = "sse2";
+        info.simd_width_bits = 128;
+    } else {
+        info.simd_isa = "scalar";
+        info.simd_width_bits = 64;
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    info.simd_isa = "neon";
+    info.simd_width_bits = 128;
+    info.has_fma = true;
+#else
+    info.simd_isa = "scalar";
+    info.simd_width_bits = 64;
+#endif
+}
+
+/**
+ * FMA issue ports per core at simd_width_bits, by microarchitecture family.
+ * A heuristic: CPUID does not expose pipe counts. Without FMA, one "unit"
+ * is a separate mul + add per cycle, which is the same 2 flops per lane.
+ */
+static uint32_t estimate_fma_units(const benchmark::SystemInfo& info) {
+    if (info.cpu_vendor == "AuthenticAMD") {
+        if (info.cpu_family >= 0x1A) return 2;                   // Zen 5: 2 x 512-bit
+        if (info.cpu_family == 0x19) {
+            return info.simd_isa == "avx512" ? 1 : 2;            // Zen 4: 512-bit ops double-pumped; Zen 3: 2 x 256
+        }
+        if (info.cpu_family == 0x17) {
+            return info.cpu_model_id >= 0x30 ? 2 : 1;            // Zen 2: 2 x 256; Zen 1: 2 x 128
+        }
+        return 1;                                                // Bulldozer family and older
+    }
+    if (info.cpu_vendor == "GenuineIntel") {
+        if (info.simd_isa == "avx512") {
+            // Server parts (Gold/Platinum/Xeon W) carry the second 512-bit FMA;
+            // client parts and Bronze/Silver Xeons have one.
+            const bool xeon = info.cpu_model.find("Xeon") != std::string::npos;
+            const bool low_bin = info.cpu_model.find("Silver") != std::string::npos ||
+                                 info.cpu_model.find("Bronze") != std::string::npos;
+            return (xeon && !low_bin) ? 2 : 1;
         }
+        if (info.has_fma) return 2;                              // Haswell .. Alder Lake: 2 x 256
+        return 1;                                                // Sandy/Ivy Bridge: 1 mul + 1 add
     }
+    if (info.simd_isa == "neon") return 2;                       // conservative: Neoverse V1/V2 and Apple cores have 4
+    return 1;
+}
 
-    // L3 (LLC)
-    info.cache_llc_bytes = read_sysfs_int("/sys/devices/system/cpu/cpu0/cache/index3/size");
-    if (info.cache_llc_bytes == 0) {
-        std::ifstream f("/sys/devices/system/cpu/cpu0/cache/index3/size");
-        std::string s;
-        if (f >> s && !s.empty()) {
-            if (s.back() == 'K') info.cache_llc_bytes = std::stoull(s.substr(0, s.size()-1)) * 1024;
+static void count_physical_cores(benchmark::SystemInfo& info) {
+    info.physical_cores = info.logical_cores;
+    info.sockets = 1;
+#if defined(__linux__)
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    std::set<std::pair<int, int>> cores;
+    std::set<int> packages;
+    int package = -1;
+    while (std::getline(cpuinfo, line)) {
+        const auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        const std::string key = trim(line.substr(0, colon));
+        const std::string val = trim(line.substr(colon + 1));
+        try {
+            if (key == "physical id") {
+                package = std::stoi(val);
+                packages.insert(package);
+            } else if (key == "core id") {
+                cores.emplace(package, std::stoi(val));
+            }
+        } catch (const std::exception&) {
+            // malformed line: keep the fallback counts
         }
     }
+    if (!cores.empty()) info.physical_cores = static_cast<uint32_t>(cores.size());
+    if (!packages.empty()) info.sockets = static_cast<uint32_t>(packages.size());
 #endif
 }
 
+double benchmark::measure_core_ghz() {
+#if defined(__GNUC__) || defined(__clang__)
+    // Timed once per process: later calls (result saving, cache-size lookups
+    // in runners) must neither add a timing loop mid-run nor change the value.
+    static const double ghz = [] {
+        const uint64_t steps = 1u << 24;
+        double best = 0.0;
+        for (int rep = 0; rep < 5; ++rep) {
+            uint64_t x = 0;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < steps; ++i) {
+                x += 1;
+                asm volatile("" : "+r"(x));
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            asm volatile("" : : "r"(x));
+            const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            if (ns > 0.0) best = std::max(best, static_cast<double>(steps) / ns);
+        }
+        return best;
+    }();
+    return ghz;
+#else
+    return 0.0;
+#endif
+}
+
+static void estimate_compute_peak(benchmark::SystemInfo& info) {
+    collect_simd_caps(info);
+    count_physical_cores(info);
+    info.fma_units_per_core = estimate_fma_units(info);
+    info.measured_core_ghz = benchmark::measure_core_ghz();
+
+    // 2 flops (mul + add) per fp64 lane per unit per cycle.
+    const double flops_per_cycle = 2.0 * info.fma_units_per_core * (info.simd_width_bits / 64.0);
+    info.peak_gflops_fp64_per_core = info.measured_core_ghz * flops_per_cycle;
+    const uint32_t cores_per_socket = std::max<uint32_t>(1, info.physical_cores / std::max<uint32_t>(1, info.sockets));
+    info.peak_gflops_fp64_per_socket = info.peak_gflops_fp64_per_core * cores_per_socket;
+}
+
 // ---------- Public API ----------
 benchmark::SystemInfo benchmark::collect_system_info() {
     benchmark::SystemInfo info;
@@ -229,6 +439,9 @@ benchmark::SystemInfo benchmark::collect_system_info() {
     const unsigned int cores = std::thread::hardware_concurrency();
     info.logical_cores = (cores > 0) ? cores : 1;
 
+    // ---------- Compute peak (runtime, ~50 ms) ----------
+    estimate_compute_peak(info);
+
     // ---------- RAM (runtime) ----------
     info.ram_total_gib = get_ram_total_gib_rounded();
     info.ram_total_pretty = format_gib_pretty(info.ram_total_gib);
@@ -240,5 +453,8 @@ benchmark::SystemInfo benchmark::collect_system_info() {
     // ---------- Caches (runtime) ----------
     collect_cache_sizes(info);
 
+    // ---------- Mitigations (runtime) ----------
+    collect_cpu_vulnerabilities(info);
+
     return info;
 }
\ No newline at end of file
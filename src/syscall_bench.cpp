@@ -0,0 +1,239 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * @brief Run `body(ops)` for warmup + timed iterations and build a Point.
+ *
+ * `body` performs `ops` operations; ns/op is the median iteration time
+ * divided by `ops` (the per-iteration loop overhead is included and is
+ * negligible next to even the cheapest vDSO call).
+ */
+BenchmarkResult::Point time_ops(const Config& conf, const std::string& kernel, std::size_t ops,
+                                const std::function<std::uint64_t(std::size_t)>& body) {
+    std::uint64_t sink = 0;
+    for (int w = 0; w < conf.warmup; ++w) {
+        sink += body(ops);
+        do_not_optimize_away(sink);
+    }
+
+    std::vector<long long> samples;
+    samples.reserve(conf.iters);
+    for (int it = 0; it < conf.iters; ++it) {
+        Timer t;
+        clobber_memory();
+        t.start();
+
+        sink += body(ops);
+
+        clobber_memory();
+        samples.push_back(t.elapsed_ns());
+        do_not_optimize_away(sink);
+    }
+
+    BenchmarkResult::Point pt;
+    pt.kernel = kernel;
+    pt.bytes = 0;
+    BenchmarkResult::fill_timing(pt, samples);
+    pt.checksum = static_cast<double>(sink & 0xffffffffu);
+
+    const double ns_per_op = pt.median_ns / static_cast<double>(ops);
+    pt.ops_per_sec = (ns_per_op > 0.0) ? 1e9 / ns_per_op : 0.0;
+    pt.extra["ns_per_op"] = ns_per_op;
+    pt.extra["ops_per_iter"] = static_cast<double>(ops);
+    return pt;
+}
+
+long futex_private(std::atomic<std::uint32_t>* word, int op, std::uint32_t val) {
+    return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), op | FUTEX_PRIVATE_FLAG, val,
+                     nullptr, nullptr, 0);
+}
+
+void pin_current_thread(int cpu) {
+    if (cpu < 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    ::sched_setaffinity(0, sizeof(set), &set); // pid 0 = calling thread on Linux
+}
+
+/**
+ * @brief Futex ping-pong between two threads; one "op" is one hop (A->B or B->A).
+ *
+ * The waiter always sleeps in FUTEX_WAIT (no spinning), so when both threads
+ * share a CPU every hop is a full thread-to-thread context switch: wake,
+ * schedule, return to user space.
+ *
+ * Shutdown goes through the futex word itself (kStop): FUTEX_WAIT(word, 0)
+ * returns immediately once the word has changed, so the stop cannot be lost
+ * between the peer's check and its wait, as a separate flag could.
+ */
+BenchmarkResult::Point futex_pingpong(const Config& conf, const std::string& kernel, int cpu_a, int cpu_b,
+                                      std::size_t rounds) {
+    constexpr std::uint32_t kStop = 2; // word values: 0 = peer's turn done, 1 = ping, 2 = stop
+    std::atomic<std::uint32_t> word{0};
+
+    std::thread peer([&]() {
+        pin_current_thread(cpu_b);
+        for (;;) {
+            std::uint32_t w;
+            while ((w = word.load(std::memory_order_acquire)) == 0) futex_private(&word, FUTEX_WAIT, 0);
+            if (w == kStop) return;
+            word.store(0, std::memory_order_release);
+            futex_private(&word, FUTEX_WAKE, 1);
+        }
+    });
+
+    cpu_set_t orig;
+    CPU_ZERO(&orig);
+    ::sched_getaffinity(0, sizeof(orig), &orig);
+    pin_current_thread(cpu_a);
+
+    auto body = [&](std::size_t n) -> std::uint64_t {
+        for (std::size_t r = 0; r < n; ++r) {
+            word.store(1, std::memory_order_release);
+            futex_private(&word, FUTEX_WAKE, 1);
+            while (word.load(std::memory_order_acquire) == 1) {
+                futex_private(&word, FUTEX_WAIT, 1);
+            }
+        }
+        return n;
+    };
+
+    BenchmarkResult::Point pt = time_ops(conf, kernel, rounds, body);
+
+    // The last pong has set word back to 0, so the peer is in (or heading into) FUTEX_WAIT(word, 0).
+    word.store(kStop, std::memory_order_release);
+    futex_private(&word, FUTEX_WAKE, 1);
+    peer.join();
+    ::sched_setaffinity(0, sizeof(orig), &orig);
+
+    // One round trip = two hops (two context switches on a shared CPU).
+    const double ns_per_hop = pt.median_ns / static_cast<double>(rounds) / 2.0;
+    pt.extra["ns_per_op"] = ns_per_hop;
+    pt.extra["ns_per_round_trip"] = ns_per_hop * 2.0;
+    pt.ops_per_sec = (ns_per_hop > 0.0) ? 1e9 / ns_per_hop : 0.0;
+    pt.extra["cpu_a"] = cpu_a;
+    pt.extra["cpu_b"] = cpu_b;
+    return pt;
+}
+
+} // namespace
+
+#endif // __linux__
+
+/**
+ * @brief OS-overhead microbenchmarks for --kernel syscall.
+ *
+ * Reports ns/op for:
+ * - syscall_getpid       : raw SYS_getpid, the cheapest real kernel entry/exit
+ * - clock_gettime_vdso   : clock_gettime(CLOCK_MONOTONIC) through the vDSO
+ * - clock_gettime_syscall: the same clock forced through SYS_clock_gettime
+ * - steady_clock_now     : std::chrono::steady_clock::now(), i.e. the cost of
+ *                          each Timer start()/elapsed_ns() call in this suite
+ * - sched_yield          : yield with no other runnable thread
+ * - futex_pingpong_*     : thread-to-thread wakeups, same CPU (context switch)
+ *                          and across CPUs when the affinity mask allows
+ *
+ * These costs move with kernel mitigations (KPTI, retpoline, IBRS), which is
+ * why the platform metadata records /sys/devices/system/cpu/vulnerabilities.
+ *
+ * @param conf The parsed configuration (warmup, iters).
+ * @param res The result object to populate (one point per primitive).
+ */
+void run_syscall_bench(const Config& conf, BenchmarkResult& res) {
+#if !defined(__linux__)
+    (void)res;
+    std::cerr << "Error: --kernel " << conf.kernel << " requires Linux (raw syscalls/futex).\n";
+#else
+    const std::size_t cheap_ops = 100'000;
+    const std::size_t syscall_ops = 20'000;
+    const std::size_t switch_rounds = 5'000;
+
+    std::vector<BenchmarkResult::Point> pts;
+
+    pts.push_back(time_ops(conf, "syscall_getpid", syscall_ops, [](std::size_t n) {
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < n; ++i) acc += static_cast<std::uint64_t>(::syscall(SYS_getpid));
+        return acc;
+    }));
+
+    pts.push_back(time_ops(conf, "clock_gettime_vdso", cheap_ops, [](std::size_t n) {
+        std::uint64_t acc = 0;
+        timespec ts {};
+        for (std::size_t i = 0; i < n; ++i) {
+            ::clock_gettime(CLOCK_MONOTONIC, &ts);
+            acc += static_cast<std::uint64_t>(ts.tv_nsec);
+        }
+        return acc;
+    }));
+
+    pts.push_back(time_ops(conf, "clock_gettime_syscall", syscall_ops, [](std::size_t n) {
+        std::uint64_t acc = 0;
+        timespec ts {};
+        for (std::size_t i = 0; i < n; ++i) {
+            ::syscall(SYS_clock_gettime, CLOCK_MONOTONIC, &ts);
+            acc += static_cast<std::uint64_t>(ts.tv_nsec);
+        }
+        return acc;
+    }));
+
+    pts.push_back(time_ops(conf, "steady_clock_now", cheap_ops, [](std::size_t n) {
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            acc += static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+        return acc;
+    }));
+
+    pts.push_back(time_ops(conf, "sched_yield", syscall_ops, [](std::size_t n) {
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < n; ++i) acc += static_cast<std::uint64_t>(::sched_yield() == 0);
+        return acc;
+    }));
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    ::sched_getaffinity(0, sizeof(allowed), &allowed);
+    std::vector<int> cpus;
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+    }
+
+    if (!cpus.empty()) {
+        pts.push_back(futex_pingpong(conf, "futex_pingpong_same_cpu", cpus.front(), cpus.front(), switch_rounds));
+    }
+    if (cpus.size() >= 2) {
+        pts.push_back(futex_pingpong(conf, "futex_pingpong_cross_cpu", cpus.front(), cpus.back(), switch_rounds));
+    }
+
+    for (auto& pt : pts) {
+        std::cout << "[Syscall] " << pt.kernel << " ns_per_op=" << pt.extra["ns_per_op"] << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    }
+#endif
+}
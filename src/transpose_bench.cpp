@@ -0,0 +1,507 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+std::function<double(double)> stream_copy_reference(const Config& conf);
+
+namespace {
+
+constexpr std::size_t kLeaf = 16;            // cache-oblivious recursion stops at 16 x 16
+constexpr std::size_t kTaskArea = 128 * 128; // smaller blocks recurse without spawning tasks
+
+// ---------- Out-of-place: out (n x n) = in^T, both row-major ----------
+
+template <class T>
+void oop_naive(const T* in, T* out, std::size_t n, int threads) {
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        for (std::size_t j = 0; j < n; ++j) out[j * n + static_cast<std::size_t>(i)] = in[static_cast<std::size_t>(i) * n + j];
+    }
+}
+
+template <class T>
+void oop_blocked(const T* in, T* out, std::size_t n, std::size_t tile, int threads) {
+    const long long tiles = static_cast<long long>((n + tile - 1) / tile);
+    #pragma omp parallel for collapse(2) num_threads(threads) schedule(static)
+    for (long long ti = 0; ti < tiles; ++ti) {
+        for (long long tj = 0; tj < tiles; ++tj) {
+            const std::size_t i0 = static_cast<std::size_t>(ti) * tile, i1 = std::min(n, i0 + tile);
+            const std::size_t j0 = static_cast<std::size_t>(tj) * tile, j1 = std::min(n, j0 + tile);
+            // Destination rows innermost: strided loads are far cheaper than strided stores.
+            for (std::size_t j = j0; j < j1; ++j) {
+                for (std::size_t i = i0; i < i1; ++i) out[j * n + i] = in[i * n + j];
+            }
+        }
+    }
+}
+
+/// Recursive halving of the longer side down to kLeaf; large halves become OpenMP tasks.
+template <class T>
+void oop_recursive(const T* in, T* out, std::size_t n, std::size_t r0, std::size_t r1, std::size_t c0,
+                   std::size_t c1) {
+    const std::size_t dr = r1 - r0, dc = c1 - c0;
+    if (dr <= kLeaf && dc <= kLeaf) {
+        for (std::size_t j = c0; j < c1; ++j) {
+            for (std::size_t i = r0; i < r1; ++i) out[j * n + i] = in[i * n + j];
+        }
+        return;
+    }
+    const bool split_rows = dr >= dc;
+    const std::size_t mid = split_rows ? r0 + dr / 2 : c0 + dc / 2;
+    if (dr * dc >= kTaskArea) {
+        #pragma omp task
+        {
+            if (split_rows) oop_recursive(in, out, n, r0, mid, c0, c1);
+            else oop_recursive(in, out, n, r0, r1, c0, mid);
+        }
+        if (split_rows) oop_recursive(in, out, n, mid, r1, c0, c1);
+        else oop_recursive(in, out, n, r0, r1, mid, c1);
+        #pragma omp taskwait
+    } else if (split_rows) {
+        oop_recursive(in, out, n, r0, mid, c0, c1);
+        oop_recursive(in, out, n, mid, r1, c0, c1);
+    } else {
+        oop_recursive(in, out, n, r0, r1, c0, mid);
+        oop_recursive(in, out, n, r0, r1, mid, c1);
+    }
+}
+
+template <class T>
+void oop_cache_oblivious(const T* in, T* out, std::size_t n, int threads) {
+    #pragma omp parallel num_threads(threads)
+    #pragma omp single
+    oop_recursive(in, out, n, 0, n, 0, n);
+}
+
+// ---------- In-place (square): a = a^T ----------
+
+template <class T>
+void ip_naive(T* a, std::size_t n, int threads) {
+    #pragma omp parallel for num_threads(threads) schedule(dynamic, 16)
+    for (long long i = 0; i < static_cast<long long>(n); ++i) {
+        const std::size_t r = static_cast<std::size_t>(i);
+        for (std::size_t j = r + 1; j < n; ++j) std::swap(a[r * n + j], a[j * n + r]);
+    }
+}
+
+/// Swap a[i][j] with a[j][i] for i in [r0, r1), j in [c0, c1); the block must not meet the diagonal.
+template <class T>
+void ip_swap_block(T* a, std::size_t n, std::size_t r0, std::size_t r1, std::size_t c0, std::size_t c1) {
+    for (std::size_t i = r0; i < r1; ++i) {
+        for (std::size_t j = c0; j < c1; ++j) std::swap(a[i * n + j], a[j * n + i]);
+    }
+}
+
+template <class T>
+void ip_blocked(T* a, std::size_t n, std::size_t tile, int threads) {
+    const long long tiles = static_cast<long long>((n + tile - 1) / tile);
+    #pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+    for (long long ti = 0; ti < tiles; ++ti) {
+        const std::size_t i0 = static_cast<std::size_t>(ti) * tile, i1 = std::min(n, i0 + tile);
+        for (std::size_t i = i0; i < i1; ++i) {
+            for (std::size_t j = i + 1; j < i1; ++j) std::swap(a[i * n + j], a[j * n + i]);
+        }
+        for (long long tj = ti + 1; tj < tiles; ++tj) {
+            const std::size_t j0 = static_cast<std::size_t>(tj) * tile, j1 = std::min(n, j0 + tile);
+            ip_swap_block(a, n, i0, i1, j0, j1);
+        }
+    }
+}
+
+template <class T>
+void ip_recursive_swap(T* a, std::size_t n, std::size_t r0, std::size_t r1, std::size_t c0, std::size_t c1) {
+    const std::size_t dr = r1 - r0, dc = c1 - c0;
+    if (dr <= kLeaf && dc <= kLeaf) {
+        ip_swap_block(a, n, r0, r1, c0, c1);
+        return;
+    }
+    const bool split_rows = dr >= dc;
+    const std::size_t mid = split_rows ? r0 + dr / 2 : c0 + dc / 2;
+    if (dr * dc >= kTaskArea) {
+        #pragma omp task
+        {
+            if (split_rows) ip_recursive_swap(a, n, r0, mid, c0, c1);
+            else ip_recursive_swap(a, n, r0, r1, c0, mid);
+        }
+        if (split_rows) ip_recursive_swap(a, n, mid, r1, c0, c1);
+        else ip_recursive_swap(a, n, r0, r1, mid, c1);
+        #pragma omp taskwait
+    } else if (split_rows) {
+        ip_recursive_swap(a, n, r0, mid, c0, c1);
+        ip_recursive_swap(a, n, mid, r1, c0, c1);
+    } else {
+        ip_recursive_swap(a, n, r0, r1, c0, mid);
+        ip_recursive_swap(a, n, r0, r1, mid, c1);
+    }
+}
+
+/// Transpose the diagonal block [lo, hi)^2: two diagonal halves plus one off-diagonal swap.
+template <class T>
+void ip_recursive_diag(T* a, std::size_t n, std::size_t lo, std::size_t hi) {
+    if (hi - lo <= kLeaf) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            for (std::size_t j = i + 1; j < hi; ++j) std::swap(a[i * n + j], a[j * n + i]);
+        }
+        return;
+    }
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if ((hi - lo) * (hi - lo) >= kTaskArea) {
+        #pragma omp task
+        ip_recursive_diag(a, n, lo, mid);
+        #pragma omp task
+        ip_recursive_diag(a, n, mid, hi);
+        ip_recursive_swap(a, n, lo, mid, mid, hi);
+        #pragma omp taskwait
+    } else {
+        ip_recursive_diag(a, n, lo, mid);
+        ip_recursive_diag(a, n, mid, hi);
+        ip_recursive_swap(a, n, lo, mid, mid, hi);
+    }
+}
+
+template <class T>
+void ip_cache_oblivious(T* a, std::size_t n, int threads) {
+    #pragma omp parallel num_threads(threads)
+    #pragma omp single
+    ip_recursive_diag(a, n, 0, n);
+}
+
+// ---------- SIMD in-register B x B transposes (AVX: 4 x 4 fp64, 8 x 8 fp32) ----------
+
+#if defined(__AVX__)
+struct SimdF64 {
+    using T = double;
+    using V = __m256d;
+    static constexpr std::size_t B = 4;
+    static V load(const T* p) { return _mm256_loadu_pd(p); }
+    static void store(T* p, V v) { _mm256_storeu_pd(p, v); }
+    static void stream(T* p, V v) { _mm256_stream_pd(p, v); }
+    static void transpose(V* r) {
+        const V t0 = _mm256_unpacklo_pd(r[0], r[1]);
+        const V t1 = _mm256_unpackhi_pd(r[0], r[1]);
+        const V t2 = _mm256_unpacklo_pd(r[2], r[3]);
+        const V t3 = _mm256_unpackhi_pd(r[2], r[3]);
+        r[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+        r[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+        r[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+        r[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+    }
+};
+
+struct SimdF32 {
+    using T = float;
+    using V = __m256;
+    static constexpr std::size_t B = 8;
+    static V load(const T* p) { return _mm256_loadu_ps(p); }
+    static void store(T* p, V v) { _mm256_storeu_ps(p, v); }
+    static void stream(T* p, V v) { _mm256_stream_ps(p, v); }
+    static void transpose(V* r) {
+        const V t0 = _mm256_unpacklo_ps(r[0], r[1]);
+        const V t1 = _mm256_unpackhi_ps(r[0], r[1]);
+        const V t2 = _mm256_unpacklo_ps(r[2], r[3]);
+        const V t3 = _mm256_unpackhi_ps(r[2], r[3]);
+        const V t4 = _mm256_unpacklo_ps(r[4], r[5]);
+        const V t5 = _mm256_unpackhi_ps(r[4], r[5]);
+        const V t6 = _mm256_unpacklo_ps(r[6], r[7]);
+        const V t7 = _mm256_unpackhi_ps(r[6], r[7]);
+        const V s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        const V s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        const V s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        const V s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        const V s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+        const V s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        const V s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+        const V s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+        r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+        r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+        r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+        r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+        r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+        r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+        r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+    }
+};
+
+template <class T> struct SimdFor;
+template <> struct SimdFor<double> { using type = SimdF64; };
+template <> struct SimdFor<float> { using type = SimdF32; };
+
+/**
+ * @brief Tiled out-of-place transpose from 2B x B in-register blocks.
+ *
+ * Two B x B blocks stacked vertically fill one 64-byte line of each output
+ * row, so with `nt` every streaming store pair writes whole lines (no
+ * read-for-ownership, no partial write-combining flushes). Requires n to be
+ * a multiple of 2B and a 64-byte aligned `out`.
+ */
+template <class S>
+void oop_simd(const typename S::T* in, typename S::T* out, std::size_t n, std::size_t tile, bool nt, int threads) {
+    using V = typename S::V;
+    constexpr std::size_t B = S::B;
+    const long long tiles = static_cast<long long>((n + tile - 1) / tile);
+    #pragma omp parallel num_threads(threads)
+    {
+        #pragma omp for collapse(2) schedule(static)
+        for (long long ti = 0; ti < tiles; ++ti) {
+            for (long long tj = 0; tj < tiles; ++tj) {
+                const std::size_t i0 = static_cast<std::size_t>(ti) * tile, i1 = std::min(n, i0 + tile);
+                const std::size_t j0 = static_cast<std::size_t>(tj) * tile, j1 = std::min(n, j0 + tile);
+                for (std::size_t i = i0; i < i1; i += 2 * B) {
+                    for (std::size_t j = j0; j < j1; j += B) {
+                        V lo[B], hi[B];
+                        for (std::size_t k = 0; k < B; ++k) {
+                            lo[k] = S::load(in + (i + k) * n + j);
+                            hi[k] = S::load(in + (i + B + k) * n + j);
+                        }
+                        S::transpose(lo);
+                        S::transpose(hi);
+                        for (std::size_t k = 0; k < B; ++k) {
+                            typename S::T* o = out + (j + k) * n + i;
+                            if (nt) {
+                                S::stream(o, lo[k]);
+                                S::stream(o + B, hi[k]);
+                            } else {
+                                S::store(o, lo[k]);
+                                S::store(o + B, hi[k]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if (nt) _mm_sfence();
+    }
+}
+
+/// In-place tiled transpose: mirrored B x B blocks are loaded, transposed and stored swapped.
+template <class S>
+void ip_simd(typename S::T* a, std::size_t n, std::size_t tile, int threads) {
+    using V = typename S::V;
+    constexpr std::size_t B = S::B;
+    const long long tiles = static_cast<long long>((n + tile - 1) / tile);
+    #pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+    for (long long ti = 0; ti < tiles; ++ti) {
+        const std::size_t i0 = static_cast<std::size_t>(ti) * tile, i1 = std::min(n, i0 + tile);
+        for (long long tj = ti; tj < tiles; ++tj) {
+            const std::size_t j0 = static_cast<std::size_t>(tj) * tile, j1 = std::min(n, j0 + tile);
+            for (std::size_t i = i0; i < i1; i += B) {
+                for (std::size_t j = (tj == ti ? i : j0); j < j1; j += B) {
+                    V x[B], y[B];
+                    for (std::size_t k = 0; k < B; ++k) x[k] = S::load(a + (i + k) * n + j);
+                    S::transpose(x);
+                    if (i == j) {
+                        for (std::size_t k = 0; k < B; ++k) S::store(a + (i + k) * n + j, x[k]);
+                        continue;
+                    }
+                    for (std::size_t k = 0; k < B; ++k) y[k] = S::load(a + (j + k) * n + i);
+                    S::transpose(y);
+                    for (std::size_t k = 0; k < B; ++k) {
+                        S::store(a + (j + k) * n + i, x[k]);
+                        S::store(a + (i + k) * n + j, y[k]);
+                    }
+                }
+            }
+        }
+    }
+}
+#endif // __AVX__
+
+template <class T> struct TypeName;
+template <> struct TypeName<double> { static constexpr const char* value = "f64"; };
+template <> struct TypeName<float> { static constexpr const char* value = "f32"; };
+
+/// Largest power-of-two tile whose source and destination tiles fit half of L1.
+std::size_t tile_for_l1(std::size_t l1_bytes, std::size_t elem) {
+    std::size_t tile = 16;
+    while (2 * (2 * tile) * (2 * tile) * elem <= l1_bytes / 2) tile *= 2;
+    return tile;
+}
+
+/**
+ * @brief Time every out-of-place and in-place variant for one n x n matrix of T.
+ *
+ * `copy_at` maps a footprint in bytes to the STREAM Copy GB/s of the same
+ * run. Each variant is validated against the exact transpose once before
+ * timing.
+ */
+template <class T>
+void run_transpose_case(const Config& conf, BenchmarkResult& res, std::size_t n, std::size_t l1_bytes,
+                        const std::function<double(double)>& copy_at, json& table) {
+    const int threads = conf.threads;
+    const std::size_t elems = n * n;
+    const std::size_t tile = tile_for_l1(l1_bytes, sizeof(T));
+    benchmark::AlignedBuffer<T> in(elems, 64), out(elems, 64), ref(elems, 64);
+
+    std::mt19937_64 rng(conf.seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (std::size_t i = 0; i < elems; ++i) ref[i] = static_cast<T>(dist(rng));
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(elems); ++i) {
+        in[static_cast<std::size_t>(i)] = ref[static_cast<std::size_t>(i)];
+        out[static_cast<std::size_t>(i)] = T(0);
+    }
+
+    const std::string type = TypeName<T>::value;
+    const double bytes = 2.0 * static_cast<double>(elems * sizeof(T)); // each element read once, written once
+    const double copy = copy_at(bytes);
+    json& row = table[type][std::to_string(n)];
+    row["tile"] = tile;
+    row["copy_gb_s"] = copy;
+
+    struct Variant {
+        const char* mode; // "oop" or "ip"
+        const char* name;
+        std::function<void()> body;
+    };
+    std::vector<Variant> variants = {
+        {"oop", "naive", [&] { oop_naive(in.data(), out.data(), n, threads); }},
+        {"oop", "blocked", [&] { oop_blocked(in.data(), out.data(), n, tile, threads); }},
+        {"oop", "recursive", [&] { oop_cache_oblivious(in.data(), out.data(), n, threads); }},
+    };
+#if defined(__AVX__)
+    using S = typename SimdFor<T>::type;
+    const bool simd_ok = n % (2 * S::B) == 0 && tile % (2 * S::B) == 0;
+    if (simd_ok) {
+        variants.push_back({"oop", "simd", [&] { oop_simd<S>(in.data(), out.data(), n, tile, false, threads); }});
+        variants.push_back({"oop", "simd_nt", [&] { oop_simd<S>(in.data(), out.data(), n, tile, true, threads); }});
+    }
+#endif
+    variants.push_back({"ip", "naive", [&] { ip_naive(in.data(), n, threads); }});
+    variants.push_back({"ip", "blocked", [&] { ip_blocked(in.data(), n, tile, threads); }});
+    variants.push_back({"ip", "recursive", [&] { ip_cache_oblivious(in.data(), n, threads); }});
+#if defined(__AVX__)
+    if (simd_ok) variants.push_back({"ip", "simd", [&] { ip_simd<S>(in.data(), n, tile, threads); }});
+#endif
+
+    for (const Variant& v : variants) {
+        const bool in_place = std::string(v.mode) == "ip";
+        const std::string name = std::string("transpose_") + v.mode + "_" + type + "_" + v.name;
+
+        // Validate one call from the pristine input.
+        std::copy(ref.data(), ref.data() + elems, in.data());
+        v.body();
+        const T* result = in_place ? in.data() : out.data();
+        bool ok = true;
+        for (std::size_t i = 0; i < n && ok; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                if (result[j * n + i] != ref[i * n + j]) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+        if (!ok) std::cerr << "CRITICAL: Validation failed for " << name << " at n=" << n << "\n";
+
+        for (int w = 0; w < conf.warmup; ++w) v.body();
+
+        std::vector<long long> samples;
+        samples.reserve(conf.iters);
+        for (int it = 0; it < conf.iters; ++it) {
+            Timer t;
+            clobber_memory();
+            t.start();
+
+            v.body();
+
+            clobber_memory();
+            samples.push_back(t.elapsed_ns());
+        }
+
+        BenchmarkResult::Point pt;
+        pt.kernel = name;
+        pt.bytes = elems * sizeof(T); // one matrix
+        BenchmarkResult::fill_timing(pt, samples);
+        const std::size_t stride = std::max<std::size_t>(1, elems / 1024);
+        for (std::size_t i = 0; i < elems; i += stride) pt.checksum += static_cast<double>(result[i]);
+
+        pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? bytes / pt.median_ns : 0.0;
+        pt.extra["n"] = static_cast<double>(n);
+        pt.extra["threads"] = threads;
+        pt.extra["copy_gb_s"] = copy;
+        if (copy > 0.0) pt.extra["pct_of_copy"] = 100.0 * pt.bandwidth_gb_s / copy;
+        if (std::string(v.name) != "naive" && std::string(v.name) != "recursive") {
+            pt.extra["tile"] = static_cast<double>(tile);
+        }
+
+        json& cell = row[v.mode][v.name];
+        cell["gb_s"] = pt.bandwidth_gb_s;
+        if (copy > 0.0) cell["pct_of_copy"] = 100.0 * pt.bandwidth_gb_s / copy;
+        cell["valid"] = ok;
+
+        std::cout << "[Transpose] " << v.mode << " " << type << " " << v.name << " n=" << n
+                  << " GB/s=" << pt.bandwidth_gb_s;
+        if (copy > 0.0) std::cout << " pct_of_copy=" << 100.0 * pt.bandwidth_gb_s / copy;
+        std::cout << "\n";
+        res.sweep_points.push_back(std::move(pt));
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Matrix transpose runner for --kernel transpose.
+ *
+ * Square row-major fp64 and fp32 matrices, n = 64, 96, 128, 192, .. while
+ * source and destination fit --size. Out-of-place: naive, tiled (power-of-two tiles
+ * sized from the detected L1), recursive cache-oblivious (OpenMP tasks)
+ * and, with AVX, in-register 4 x 4 (fp64) / 8 x 8 (fp32) block transposes
+ * with regular or non-temporal stores. In-place: naive, tiled, recursive
+ * and SIMD block swap.
+ *
+ * Effective bandwidth counts each element read once and written once
+ * (2 x matrix bytes), and is reported as a percentage of STREAM Copy
+ * measured in the same run at the closest footprint. Streaming stores
+ * skip the read-for-ownership that Copy pays, so simd_nt can exceed 100%.
+ *
+ * @param conf The parsed configuration (size, threads, seed, warmup, iters).
+ * @param res The result object to populate.
+ */
+void run_transpose_bench(const Config& conf, BenchmarkResult& res) {
+    std::uint64_t size_bytes = 0;
+    try {
+        size_bytes = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        return;
+    }
+
+    // ---- STREAM Copy reference, same process ----
+    const std::function<double(double)> copy_at = stream_copy_reference(conf);
+
+    const benchmark::SystemInfo sys = benchmark::collect_system_info();
+    const std::size_t l1 = sys.cache_l1_bytes ? static_cast<std::size_t>(sys.cache_l1_bytes) : 32 * 1024;
+
+    json& table = res.extra_stats["transpose"];
+    table["threads"] = conf.threads;
+    table["l1_bytes"] = l1;
+    // Powers of two (row strides that alias in set-associative caches) and
+    // 1.5x steps between them; all are multiples of the 16-element SIMD block.
+    auto sizes = [&](std::size_t elem) {
+        std::vector<std::size_t> ns;
+        for (std::size_t n = 64; 2 * n * n * elem <= size_bytes; n *= 2) {
+            ns.push_back(n);
+            if (2 * (n + n / 2) * (n + n / 2) * elem <= size_bytes) ns.push_back(n + n / 2);
+        }
+        return ns;
+    };
+    for (const std::size_t n : sizes(sizeof(double))) run_transpose_case<double>(conf, res, n, l1, copy_at, table);
+    for (const std::size_t n : sizes(sizeof(float))) run_transpose_case<float>(conf, res, n, l1, copy_at, table);
+}
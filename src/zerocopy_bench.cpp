@@ -0,0 +1,419 @@
+#include "config.hpp"
+#include "results.hpp"
+#include "size_parse.hpp"
+#include "timer.hpp"
+#include "utils.hpp"
+#include "aligned_buffer.hpp"
+#include "scratch_file.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * @brief Data-movement paths compared by the zerocopy runner.
+ *
+ * - ReadWrite    : file -> user buffer -> file (two copies through userspace)
+ * - Write        : user memory -> file (one copy, baseline for Vmsplice)
+ * - Splice       : file -> pipe -> file (page references, no userspace copy)
+ * - Vmsplice     : user memory -> pipe -> file (maps user pages into the pipe)
+ * - Sendfile     : file -> file in one syscall
+ * - CopyFileRange: file -> file, may be offloaded/reflinked by the filesystem
+ */
+enum class MovePath { ReadWrite, Write, Splice, Vmsplice, Sendfile, CopyFileRange };
+
+const char* move_path_name(MovePath p) {
+    switch (p) {
+        case MovePath::ReadWrite:     return "zerocopy_read_write";
+        case MovePath::Write:         return "zerocopy_write";
+        case MovePath::Splice:        return "zerocopy_splice";
+        case MovePath::Vmsplice:      return "zerocopy_vmsplice";
+        case MovePath::Sendfile:      return "zerocopy_sendfile";
+        case MovePath::CopyFileRange: return "zerocopy_copy_file_range";
+    }
+    return "unknown";
+}
+
+bool uses_pipe(MovePath p) {
+    return p == MovePath::Splice || p == MovePath::Vmsplice;
+}
+
+/**
+ * @brief Chunk sizes swept per path (4 KiB to 4 MiB).
+ */
+std::vector<std::size_t> build_chunk_sweep() {
+    std::vector<std::size_t> sizes;
+    for (std::size_t kb = 4; kb <= 4096; kb *= 4) sizes.push_back(kb * 1024);
+    return sizes;
+}
+
+/**
+ * @brief Everything one transfer needs: endpoints, staging buffers, geometry.
+ */
+struct MoveCtx {
+    int src_fd = -1;
+    int dst_fd = -1;
+    int pipe_r = -1;
+    int pipe_w = -1;
+    std::size_t pipe_cap = 0;
+    const unsigned char* mem = nullptr;  // source memory for Write/Vmsplice (chunk bytes)
+    unsigned char* bounce = nullptr;     // userspace staging buffer for ReadWrite (chunk bytes)
+    std::uint64_t total = 0;             // bytes moved per iteration
+    std::size_t chunk = 0;               // bytes requested per syscall
+};
+
+std::string errno_msg(const char* what) {
+    return std::string(what) + ": " + std::strerror(errno);
+}
+
+/**
+ * @brief Drain exactly `n` bytes from the pipe into dst at `out_off`.
+ */
+bool drain_pipe(MoveCtx& c, std::size_t n, loff_t& out_off, std::string& err) {
+    while (n > 0) {
+        const ssize_t m = ::splice(c.pipe_r, nullptr, c.dst_fd, &out_off, n, SPLICE_F_MOVE);
+        if (m < 0 && errno == EINTR) continue;
+        if (m <= 0) {
+            err = errno_msg("splice(pipe->file)");
+            return false;
+        }
+        n -= static_cast<std::size_t>(m);
+    }
+    return true;
+}
+
+/**
+ * @brief Move `c.total` bytes from the source to dst using path `p`.
+ *
+ * Every path writes dst[0, total) so the destination ends up byte-identical
+ * to the source file regardless of the path (memory sources replicate the
+ * scratch-file pattern).
+ */
+bool move_once(MovePath p, MoveCtx& c, std::string& err) {
+    if (p == MovePath::Sendfile && ::lseek(c.dst_fd, 0, SEEK_SET) < 0) {
+        err = errno_msg("lseek");
+        return false;
+    }
+
+    std::uint64_t off = 0;
+    while (off < c.total) {
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(c.chunk, c.total - off));
+        std::size_t moved = 0;
+
+        switch (p) {
+            case MovePath::ReadWrite: {
+                const ssize_t r = ::pread(c.src_fd, c.bounce, len, static_cast<off_t>(off));
+                if (r <= 0) {
+                    if (r < 0 && errno == EINTR) continue;
+                    err = errno_msg("pread");
+                    return false;
+                }
+                std::size_t w_done = 0;
+                while (w_done < static_cast<std::size_t>(r)) {
+                    const ssize_t w = ::pwrite(c.dst_fd, c.bounce + w_done, static_cast<std::size_t>(r) - w_done,
+                                               static_cast<off_t>(off + w_done));
+                    if (w < 0 && errno == EINTR) continue;
+                    if (w <= 0) {
+                        err = errno_msg("pwrite");
+                        return false;
+                    }
+                    w_done += static_cast<std::size_t>(w);
+                }
+                moved = static_cast<std::size_t>(r);
+                break;
+            }
+            case MovePath::Write: {
+                const ssize_t w = ::pwrite(c.dst_fd, c.mem, len, static_cast<off_t>(off));
+                if (w < 0 && errno == EINTR) continue;
+                if (w <= 0) {
+                    err = errno_msg("pwrite");
+                    return false;
+                }
+                moved = static_cast<std::size_t>(w);
+                break;
+            }
+            case MovePath::Splice: {
+                // A pipe holds at most pipe_cap bytes, so large chunks take several fills.
+                loff_t in_off = static_cast<loff_t>(off);
+                loff_t out_off = static_cast<loff_t>(off);
+                while (moved < len) {
+                    const std::size_t want = std::min(len - moved, c.pipe_cap);
+                    const ssize_t r = ::splice(c.src_fd, &in_off, c.pipe_w, nullptr, want, SPLICE_F_MOVE);
+                    if (r < 0 && errno == EINTR) continue;
+                    if (r <= 0) {
+                        err = errno_msg("splice(file->pipe)");
+                        return false;
+                    }
+                    if (!drain_pipe(c, static_cast<std::size_t>(r), out_off, err)) return false;
+                    moved += static_cast<std::size_t>(r);
+                }
+                break;
+            }
+            case MovePath::Vmsplice: {
+                loff_t out_off = static_cast<loff_t>(off);
+                while (moved < len) {
+                    iovec iov {};
+                    iov.iov_base = const_cast<unsigned char*>(c.mem + moved);
+                    iov.iov_len = std::min(len - moved, c.pipe_cap);
+                    const ssize_t r = ::vmsplice(c.pipe_w, &iov, 1, 0);
+                    if (r < 0 && errno == EINTR) continue;
+                    if (r <= 0) {
+                        err = errno_msg("vmsplice");
+                        return false;
+                    }
+                    if (!drain_pipe(c, static_cast<std::size_t>(r), out_off, err)) return false;
+                    moved += static_cast<std::size_t>(r);
+                }
+                break;
+            }
+            case MovePath::Sendfile: {
+                off_t in_off = static_cast<off_t>(off);
+                const ssize_t r = ::sendfile(c.dst_fd, c.src_fd, &in_off, len);
+                if (r < 0 && errno == EINTR) continue;
+                if (r <= 0) {
+                    err = errno_msg("sendfile");
+                    return false;
+                }
+                moved = static_cast<std::size_t>(r);
+                break;
+            }
+            case MovePath::CopyFileRange: {
+                loff_t in_off = static_cast<loff_t>(off);
+                loff_t out_off = static_cast<loff_t>(off);
+                const ssize_t r = ::copy_file_range(c.src_fd, &in_off, c.dst_fd, &out_off, len, 0);
+                if (r < 0 && errno == EINTR) continue;
+                if (r <= 0) {
+                    err = errno_msg("copy_file_range");
+                    return false;
+                }
+                moved = static_cast<std::size_t>(r);
+                break;
+            }
+        }
+        off += moved;
+    }
+    return true;
+}
+
+/**
+ * @brief Compare a few pages of dst against src (outside the timed region).
+ * @return Sum of the sampled destination bytes (checksum), or -1 on mismatch.
+ */
+double verify_sampled(int src_fd, int dst_fd, std::uint64_t total) {
+    const std::size_t page = 4096;
+    std::vector<unsigned char> a(page), b(page);
+    double sum = 0.0;
+    const std::uint64_t step = std::max<std::uint64_t>(page, (total / 16) / page * page);
+    for (std::uint64_t off = 0; off < total; off += step) {
+        const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(page, total - off));
+        if (::pread(src_fd, a.data(), len, static_cast<off_t>(off)) != static_cast<ssize_t>(len)) return -1.0;
+        if (::pread(dst_fd, b.data(), len, static_cast<off_t>(off)) != static_cast<ssize_t>(len)) return -1.0;
+        if (std::memcmp(a.data(), b.data(), len) != 0) return -1.0;
+        for (std::size_t i = 0; i < len; ++i) sum += b[i];
+    }
+    return sum;
+}
+
+double rusage_user_s(const rusage& r) {
+    return static_cast<double>(r.ru_utime.tv_sec) + static_cast<double>(r.ru_utime.tv_usec) * 1e-6;
+}
+
+double rusage_sys_s(const rusage& r) {
+    return static_cast<double>(r.ru_stime.tv_sec) + static_cast<double>(r.ru_stime.tv_usec) * 1e-6;
+}
+
+} // namespace
+
+#endif // __linux__
+
+/**
+ * @brief Kernel data-movement runner for --kernel zerocopy.
+ *
+ * Moves `--size` bytes per iteration from a scratch source (`--file`, or a
+ * memory buffer for the write/vmsplice paths) into `<file>.dst`, using
+ * read/write, write, splice, vmsplice, sendfile and copy_file_range, and
+ * sweeps the per-syscall chunk size from 4 KiB to 4 MiB.
+ *
+ * Besides wall-clock GB/s each point carries the process CPU time spent per
+ * GB moved (user and system, from getrusage), which is where avoiding the
+ * userspace copy shows up even when the page cache makes wall time similar.
+ *
+ * @param conf The parsed configuration (size, file, warmup, iters, ...).
+ * @param res The result object to populate with one point per (path, chunk).
+ */
+void run_zerocopy_bench(const Config& conf, BenchmarkResult& res) {
+#if !defined(__linux__)
+    (void)res;
+    std::cerr << "Error: --kernel " << conf.kernel << " requires Linux (splice/sendfile/copy_file_range).\n";
+#else
+    std::uint64_t total = 0;
+    try {
+        total = parse_size_bytes(conf.size);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: failed to parse --size '" << conf.size << "': " << e.what() << "\n";
+        std::cerr << "Examples: 64MB, 512KiB, 1GiB\n";
+        return;
+    }
+    if (total < 4096) {
+        std::cerr << "Error: --size too small for zerocopy (" << total << " bytes, need >= 4KiB)\n";
+        return;
+    }
+
+    const std::string dst_path = conf.file + ".dst";
+    bool src_created = false;
+    bool dst_created = false;
+    const int src_fd = prepare_scratch_file(conf.file, total, src_created);
+    if (src_fd < 0) {
+        std::cerr << "Error: cannot prepare --file '" << conf.file << "': " << std::strerror(errno) << "\n";
+        if (src_created) ::unlink(conf.file.c_str());
+        return;
+    }
+    // dst is emptied before every (path, chunk) run below, so there is nothing to prefill.
+    // Its contents are ours whether or not it existed, so it is always removed at the end.
+    const int dst_fd = prepare_scratch_file(dst_path, 0, dst_created);
+    if (dst_fd < 0) {
+        std::cerr << "Error: cannot prepare '" << dst_path << "': " << std::strerror(errno) << "\n";
+        ::close(src_fd);
+        if (src_created) ::unlink(conf.file.c_str());
+        return;
+    }
+
+    int pipe_fds[2] = {-1, -1};
+    if (::pipe(pipe_fds) != 0) {
+        std::cerr << "Error: pipe: " << std::strerror(errno) << "\n";
+        pipe_fds[0] = pipe_fds[1] = -1;
+    } else {
+        // Grow the pipe so one fill can carry a whole chunk (capped by fs.pipe-max-size).
+        ::fcntl(pipe_fds[1], F_SETPIPE_SZ, 1024 * 1024);
+    }
+    const int pipe_sz = (pipe_fds[1] >= 0) ? ::fcntl(pipe_fds[1], F_GETPIPE_SZ) : -1;
+
+    const std::size_t max_chunk = build_chunk_sweep().back();
+    benchmark::AlignedBuffer<unsigned char> mem(max_chunk, 4096);
+    benchmark::AlignedBuffer<unsigned char> bounce(max_chunk, 4096);
+    // Same byte pattern as the scratch file (period 1 MiB), so every path yields dst == src.
+    for (std::size_t i = 0; i < max_chunk; ++i) {
+        mem[i] = static_cast<unsigned char>((i % (1024 * 1024)) * 131u + 7u);
+    }
+    std::memset(bounce.data(), 0, bounce.size());
+
+    const MovePath paths[] = {MovePath::ReadWrite, MovePath::Write, MovePath::Splice,
+                              MovePath::Vmsplice, MovePath::Sendfile, MovePath::CopyFileRange};
+
+    for (MovePath path : paths) {
+        if (uses_pipe(path) && pipe_sz <= 0) {
+            std::cerr << "[ZeroCopy] " << move_path_name(path) << " skipped: no pipe\n";
+            continue;
+        }
+
+        for (std::size_t chunk : build_chunk_sweep()) {
+            if (chunk > total) continue;
+
+            MoveCtx ctx;
+            ctx.src_fd = src_fd;
+            ctx.dst_fd = dst_fd;
+            ctx.pipe_r = pipe_fds[0];
+            ctx.pipe_w = pipe_fds[1];
+            ctx.pipe_cap = static_cast<std::size_t>(std::max(pipe_sz, 4096));
+            ctx.mem = mem.data();
+            ctx.bounce = bounce.data();
+            ctx.total = total;
+            ctx.chunk = chunk;
+
+            std::string err;
+            bool failed = false;
+            // Empty dst so verify_sampled() only passes if this path really wrote it.
+            if (::ftruncate(dst_fd, 0) != 0) {
+                err = errno_msg("ftruncate");
+                failed = true;
+            }
+            for (int w = 0; w < conf.warmup && !failed; ++w) {
+                failed = !move_once(path, ctx, err);
+            }
+
+            std::vector<long long> samples;
+            samples.reserve(conf.iters);
+            double user_s = 0.0;
+            double sys_s = 0.0;
+
+            for (int it = 0; it < conf.iters && !failed; ++it) {
+                rusage ru0 {};
+                rusage ru1 {};
+                ::getrusage(RUSAGE_SELF, &ru0);
+
+                Timer t;
+                clobber_memory();
+                t.start();
+
+                failed = !move_once(path, ctx, err);
+
+                clobber_memory();
+                samples.push_back(t.elapsed_ns());
+
+                ::getrusage(RUSAGE_SELF, &ru1);
+                user_s += rusage_user_s(ru1) - rusage_user_s(ru0);
+                sys_s += rusage_sys_s(ru1) - rusage_sys_s(ru0);
+            }
+
+            if (failed) {
+                // e.g. copy_file_range across filesystems on old kernels, vmsplice under seccomp.
+                std::cerr << "[ZeroCopy] " << move_path_name(path) << " chunk=" << chunk
+                          << " skipped: " << err << "\n";
+                break;
+            }
+            if (samples.empty()) continue;
+
+            const double checksum = verify_sampled(src_fd, dst_fd, total);
+            if (checksum < 0.0) {
+                std::cerr << "CRITICAL: zerocopy validation failed for " << move_path_name(path)
+                          << " at chunk=" << chunk << "\n";
+            }
+
+            BenchmarkResult::Point pt;
+            pt.kernel = move_path_name(path);
+            pt.bytes = chunk;
+            BenchmarkResult::fill_timing(pt, samples);
+            pt.bandwidth_gb_s = (pt.median_ns > 0.0) ? static_cast<double>(total) / pt.median_ns : 0.0;
+            pt.checksum = checksum;
+
+            const double gb_moved = static_cast<double>(total) * static_cast<double>(samples.size()) / 1e9;
+            pt.extra["bytes_per_iter"] = static_cast<double>(total);
+            pt.extra["user_s_per_gb"] = user_s / gb_moved;
+            pt.extra["sys_s_per_gb"] = sys_s / gb_moved;
+            pt.extra["cpu_s_per_gb"] = (user_s + sys_s) / gb_moved;
+            if (uses_pipe(path)) pt.extra["pipe_bytes"] = static_cast<double>(ctx.pipe_cap);
+
+            res.sweep_points.push_back(pt);
+
+            std::cout << "[ZeroCopy] path=" << pt.kernel << " chunk=" << chunk
+                      << " bw_gb_s=" << pt.bandwidth_gb_s
+                      << " cpu_s_per_gb=" << pt.extra["cpu_s_per_gb"] << "\n";
+        }
+    }
+
+    if (pipe_fds[0] >= 0) ::close(pipe_fds[0]);
+    if (pipe_fds[1] >= 0) ::close(pipe_fds[1]);
+    ::close(dst_fd);
+    ::close(src_fd);
+    ::unlink(dst_path.c_str());
+    if (src_created) ::unlink(conf.file.c_str());
+#endif
+}